@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "cobs.hpp"
+#include "crc.hpp"
+#include "packet_framer.hpp"
+#include "recorded_frames.hpp"
+
+// How many times the recorded stream is repeated per iteration
+constexpr size_t STREAM_REPEATS = 64;
+
+// Splits an encoded stream back into its encoded frames, without the delimiters
+static std::vector<std::vector<uint8_t>> SplitEncodedFrames(const std::vector<uint8_t>& wire) {
+	std::vector<std::vector<uint8_t>> frames;
+	std::vector<uint8_t> current;
+
+	for (const uint8_t byte : wire) {
+		if (byte == 0) {
+			if (!current.empty()) {
+				frames.push_back(current);
+				current.clear();
+			}
+		} else {
+			current.push_back(byte);
+		}
+	}
+
+	return frames;
+}
+
+// The original path: decode the frame in place, then walk it again to verify the CRC
+static void BM_TwoPassDecodeThenCrc(benchmark::State& state) {
+	const std::vector<std::vector<uint8_t>> frames = SplitEncodedFrames(recorded_frames::EncodeStream(STREAM_REPEATS));
+	uint8_t scratch[cobs::MAX_DECODED_SIZE + 1] = {};
+	size_t bytes = 0;
+
+	for (auto _ : state) {
+		for (const std::vector<uint8_t>& frame : frames) {
+			memcpy(scratch, frame.data(), frame.size());
+			const size_t length = cobs::decode(scratch, frame.size());
+			const crc checksum = F_CRC_CalculateCheckSum(scratch, length);
+			benchmark::DoNotOptimize(checksum);
+			bytes += frame.size();
+		}
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * frames.size()));
+}
+BENCHMARK(BM_TwoPassDecodeThenCrc);
+
+// Fused kernel: the CRC is updated while the frame is un-stuffed
+static void BM_FusedDecodeCrc(benchmark::State& state) {
+	const std::vector<std::vector<uint8_t>> frames = SplitEncodedFrames(recorded_frames::EncodeStream(STREAM_REPEATS));
+	uint8_t scratch[cobs::MAX_DECODED_SIZE + 1] = {};
+	size_t bytes = 0;
+
+	for (auto _ : state) {
+		for (const std::vector<uint8_t>& frame : frames) {
+			memcpy(scratch, frame.data(), frame.size());
+			crc checksum = 0;
+			const size_t length = cobs::decode_crc(scratch, frame.size(), checksum);
+			benchmark::DoNotOptimize(length);
+			benchmark::DoNotOptimize(checksum);
+			bytes += frame.size();
+		}
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * frames.size()));
+}
+BENCHMARK(BM_FusedDecodeCrc);
+
+// The path the overlay uses: raw bytes go through the ring buffer, and are decoded and checksummed byte by byte
+static void BM_FramerStreamingDecodeCrc(benchmark::State& state) {
+	const std::vector<uint8_t> wire = recorded_frames::EncodeStream(STREAM_REPEATS);
+	PacketFramer framer;
+	size_t frameCount = 0;
+
+	for (auto _ : state) {
+		size_t offset = 0;
+		while (offset < wire.size()) {
+			size_t writable = 0;
+			uint8_t* region = framer.WriteRegion(writable);
+			const size_t count = std::min(writable, wire.size() - offset);
+			memcpy(region, wire.data() + offset, count);
+			framer.CommitWrite(count);
+			offset += count;
+
+			std::span<const uint8_t> frame;
+			crc checksum = 0;
+			while (framer.NextFrame(frame, checksum)) {
+				benchmark::DoNotOptimize(frame.data());
+				benchmark::DoNotOptimize(checksum);
+				frameCount++;
+			}
+		}
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wire.size()));
+	state.SetItemsProcessed(static_cast<int64_t>(frameCount));
+}
+BENCHMARK(BM_FramerStreamingDecodeCrc);
+
+// Frame of the given length with no zero bytes, the worst case for decoding as every byte is copied
+static std::vector<uint8_t> MakeFrame(const size_t length) {
+	std::vector<uint8_t> frame(length);
+	for (size_t i = 0; i < length; i++) {
+		frame[i] = static_cast<uint8_t>(1 + i % 255);
+	}
+	return frame;
+}
+
+// The argument is the decoded frame length: the shortest packet, the finger packets, and the longest COBS frame
+static void BM_CobsEncode(benchmark::State& state) {
+	const std::vector<uint8_t> frame = MakeFrame(static_cast<size_t>(state.range(0)));
+	uint8_t encoded[cobs::MAX_DECODED_SIZE + 2] = {};
+
+	for (auto _ : state) {
+		cobs::encode(frame.data(), static_cast<uint32_t>(frame.size()), encoded);
+		benchmark::DoNotOptimize(encoded);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+}
+BENCHMARK(BM_CobsEncode)->Arg(6)->Arg(22)->Arg(cobs::MAX_DECODED_SIZE);
+
+static void BM_CobsDecode(benchmark::State& state) {
+	const std::vector<uint8_t> frame = MakeFrame(static_cast<size_t>(state.range(0)));
+	uint8_t encoded[cobs::MAX_DECODED_SIZE + 2] = {};
+	uint8_t scratch[cobs::MAX_DECODED_SIZE + 2] = {};
+	cobs::encode(frame.data(), static_cast<uint32_t>(frame.size()), encoded);
+	const size_t encodedLength = frame.size() + 1;
+
+	for (auto _ : state) {
+		memcpy(scratch, encoded, encodedLength);
+		const size_t length = cobs::decode(scratch, encodedLength);
+		benchmark::DoNotOptimize(length);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encodedLength));
+}
+BENCHMARK(BM_CobsDecode)->Arg(6)->Arg(22)->Arg(cobs::MAX_DECODED_SIZE);
+
+static void BM_CrcCalculateCheckSum(benchmark::State& state) {
+	const std::vector<uint8_t> frame = MakeFrame(static_cast<size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		const crc checksum = F_CRC_CalculateCheckSum(frame.data(), frame.size());
+		benchmark::DoNotOptimize(checksum);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+}
+BENCHMARK(BM_CrcCalculateCheckSum)->Arg(6)->Arg(22)->Arg(cobs::MAX_DECODED_SIZE);
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+/// <summary>
+/// A pseudo-terminal standing in for the dongle. Bytes written to the master side arrive on the slave side,
+/// which the serial manager opens like any other serial port.
+/// </summary>
+class FakeDongle {
+public:
+	FakeDongle() : m_master(-1) {
+		m_master = posix_openpt(O_RDWR | O_NOCTTY);
+		if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0) {
+			return;
+		}
+
+		termios tty = {};
+		tcgetattr(m_master, &tty);
+		cfmakeraw(&tty);
+		tcsetattr(m_master, TCSANOW, &tty);
+
+		m_slavePath = ptsname(m_master);
+	}
+
+	~FakeDongle() {
+		if (m_master >= 0) {
+			close(m_master);
+		}
+	}
+
+	bool IsValid() const { return !m_slavePath.empty(); }
+	const std::string& SlavePath() const { return m_slavePath; }
+
+	bool Send(const std::vector<uint8_t>& data) const {
+		size_t written = 0;
+		while (written < data.size()) {
+			const ssize_t result = write(m_master, data.data() + written, data.size() - written);
+			if (result < 0) {
+				return false;
+			}
+			written += static_cast<size_t>(result);
+		}
+		return true;
+	}
+
+	// Writes as much of data as the pseudo-terminal takes without blocking, returning how many bytes were written. Like a
+	// real UART, whatever the reader hasn't made room for is lost
+	size_t SendAvailable(const uint8_t* data, const size_t size) const {
+		const int flags = fcntl(m_master, F_GETFL);
+		fcntl(m_master, F_SETFL, flags | O_NONBLOCK);
+
+		size_t written = 0;
+		while (written < size) {
+			const ssize_t result = write(m_master, data + written, size - written);
+			if (result <= 0) {
+				break;
+			}
+			written += static_cast<size_t>(result);
+		}
+
+		fcntl(m_master, F_SETFL, flags);
+		return written;
+	}
+
+	// Throws away any commands written to the dongle, so they never fill the pseudo-terminal
+	void DiscardInput() const {
+		tcflush(m_master, TCIFLUSH);
+	}
+
+private:
+	int m_master;
+	std::string m_slavePath;
+};
+
+#endif // __linux__
@@ -0,0 +1,139 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "fake_dongle.hpp"
+#include "simulated_dongle.hpp"
+
+// How often the simulator wakes to send whatever is due
+constexpr auto SIMULATOR_TICK = std::chrono::milliseconds(1);
+
+static void PrintUsage(const char* program) {
+	printf("Usage: %s [options]\n", program);
+	printf("Opens a pseudo-terminal and sends it the traffic of a dongle with gloves paired.\n\n");
+	printf("  --gloves <0-2>        Paired gloves (default 2)\n");
+	printf("  --fingers-hz <rate>   Finger packets per second per glove (default 120)\n");
+	printf("  --data-hz <rate>      Button and joystick packets per second per glove (default 120)\n");
+	printf("  --imu-hz <rate>       IMU packets per second per glove (default 120)\n");
+	printf("  --status-hz <rate>    Battery status packets per second (default 1)\n");
+	printf("  --versions-hz <rate>  Firmware version packets per second (default 1)\n");
+	printf("  --multiplier <x>      Multiplies every rate, e.g. 10 for ten times the real load (default 1)\n");
+	printf("  --noise <units>       Peak to peak noise on sensor readings (default 8)\n");
+	printf("  --dropout <p>         Probability a packet is never sent (default 0)\n");
+	printf("  --corrupt <p>         Probability a packet has a byte flipped (default 0)\n");
+	printf("  --seed <n>            Random seed (default 1)\n");
+	printf("  --seconds <n>         Stop after this long, 0 runs until killed (default 0)\n");
+	printf("  --link <path>         Also make the pseudo-terminal available at this path\n");
+}
+
+int main(int argc, char** argv) {
+	SimulatedDongleConfig_t config = {};
+	double seconds = 0.0;
+	std::string linkPath;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string option = argv[i];
+		if (option == "--help" || option == "-h") {
+			PrintUsage(argv[0]);
+			return 0;
+		}
+		if (i + 1 >= argc) {
+			printf("Missing value for %s\n", option.c_str());
+			PrintUsage(argv[0]);
+			return 1;
+		}
+
+		const char* value = argv[++i];
+		if (option == "--gloves") {
+			config.gloveCount = static_cast<uint32_t>(atoi(value));
+		} else if (option == "--fingers-hz") {
+			config.fingersRate = atof(value);
+		} else if (option == "--data-hz") {
+			config.dataRate = atof(value);
+		} else if (option == "--imu-hz") {
+			config.imuRate = atof(value);
+		} else if (option == "--status-hz") {
+			config.statusRate = atof(value);
+		} else if (option == "--versions-hz") {
+			config.versionsRate = atof(value);
+		} else if (option == "--multiplier") {
+			config.rateMultiplier = atof(value);
+		} else if (option == "--noise") {
+			config.noise = static_cast<uint16_t>(atoi(value));
+		} else if (option == "--dropout") {
+			config.dropoutProbability = atof(value);
+		} else if (option == "--corrupt") {
+			config.corruptProbability = atof(value);
+		} else if (option == "--seed") {
+			config.seed = static_cast<uint32_t>(atoi(value));
+		} else if (option == "--seconds") {
+			seconds = atof(value);
+		} else if (option == "--link") {
+			linkPath = value;
+		} else {
+			printf("Unknown option %s\n", option.c_str());
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	FakeDongle dongle;
+	if (!dongle.IsValid()) {
+		printf("Failed to open a pseudo-terminal\n");
+		return 1;
+	}
+
+	if (!linkPath.empty()) {
+		unlink(linkPath.c_str());
+		if (symlink(dongle.SlavePath().c_str(), linkPath.c_str()) != 0) {
+			printf("Failed to link %s to %s - Error: %s\n", linkPath.c_str(), dongle.SlavePath().c_str(), strerror(errno));
+			return 1;
+		}
+	}
+
+	printf("Simulating a dongle with %u glove(s) at %.1fx the configured rates on %s\n",
+		config.gloveCount, config.rateMultiplier, linkPath.empty() ? dongle.SlavePath().c_str() : linkPath.c_str());
+
+	SimulatedDongle simulated(config);
+	std::vector<uint8_t> wire;
+
+	const auto start = std::chrono::steady_clock::now();
+	auto nextReport = start + std::chrono::seconds(1);
+	uint64_t bytesSent = 0;
+	uint64_t bytesLost = 0;
+	uint64_t lastFrames = 0;
+
+	while (seconds <= 0.0 || std::chrono::steady_clock::now() - start < std::chrono::duration<double>(seconds)) {
+		const auto now = std::chrono::steady_clock::now();
+		const uint64_t elapsedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+
+		wire.clear();
+		simulated.Generate(elapsedNs, wire);
+		const size_t written = dongle.SendAvailable(wire.data(), wire.size());
+		bytesSent += written;
+		bytesLost += wire.size() - written;
+		dongle.DiscardInput();
+
+		if (now >= nextReport) {
+			printf("%llu frames/s, %llu bytes sent, %llu bytes lost to a full pseudo-terminal, %llu dropped and %llu corrupted on purpose\n",
+				(unsigned long long)(simulated.FramesSent() - lastFrames), (unsigned long long)bytesSent, (unsigned long long)bytesLost,
+				(unsigned long long)simulated.FramesDropped(), (unsigned long long)simulated.FramesCorrupted());
+			lastFrames = simulated.FramesSent();
+			nextReport += std::chrono::seconds(1);
+		}
+
+		std::this_thread::sleep_for(SIMULATOR_TICK);
+	}
+
+	if (!linkPath.empty()) {
+		unlink(linkPath.c_str());
+	}
+	return 0;
+}
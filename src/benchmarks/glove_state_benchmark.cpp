@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "glove_state_block.hpp"
+#include "glove_state_delta.hpp"
+#include "pose_stream_block.hpp"
+#include "shared_memory.hpp"
+
+// One overlay frame's worth of glove state handed to the driver: both gloves published to the shared block, then polled
+// the way DeviceProvider::PollGloveState does. This replaces two pipe round trips per frame
+static void BM_GloveStateHandover(benchmark::State& state) {
+	SharedMemoryRegion driverRegion;
+	SharedMemoryRegion overlayRegion;
+	const std::string name = std::string(FREESCUBA_GLOVE_STATE_NAME) + "Bench";
+	if (!driverRegion.Create(name, sizeof(GloveStateBlock_t)) || !overlayRegion.Open(name, sizeof(GloveStateBlock_t))) {
+		state.SkipWithError("Failed to map the glove state block");
+		return;
+	}
+
+	GloveStateBlock_t* driverBlock = new (driverRegion.Data()) GloveStateBlock_t();
+	driverBlock->version = protocol::Version;
+	// A separate mapping of the same memory, as the overlay has
+	GloveStateBlock_t* overlayBlock = static_cast<GloveStateBlock_t*>(overlayRegion.Data());
+
+	protocol::ContactGloveState_t glove = {};
+	glove.isConnected = true;
+	uint32_t lastSequence[2] = {};
+	uint64_t updates = 0;
+
+	for (auto _ : state) {
+		glove.sample.timestamp++;
+		overlayBlock->gloves[0][protocol::LeftGlove].Store(glove);
+		overlayBlock->gloves[0][protocol::RightGlove].Store(glove);
+
+		for (int i = protocol::LeftGlove; i <= protocol::RightGlove; i++) {
+			const uint32_t sequence = driverBlock->gloves[0][i].Sequence();
+			protocol::ContactGloveState_t received;
+			if (sequence != lastSequence[i] && driverBlock->gloves[0][i].TryLoad(received)) {
+				lastSequence[i] = sequence;
+				benchmark::DoNotOptimize(received);
+				updates++;
+			}
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(updates));
+	state.counters["bytes_per_glove"] = static_cast<double>(sizeof(protocol::ContactGloveState_t));
+}
+BENCHMARK(BM_GloveStateHandover);
+
+// One glove update through the pipe fallback: encoding the delta against the last update sent, as IPCClient does, and
+// applying it to the driver's copy. Fingers, the IMU and the timestamps move every update, the rest mostly doesn't
+static void BM_GloveStateDelta(benchmark::State& state) {
+	protocol::ContactGloveState_t glove = {};
+	glove.isConnected = true;
+	glove.trackerIndex = 3;
+
+	protocol::ContactGloveState_t sent = {};
+	protocol::ContactGloveState_t received = {};
+	protocol::Request_t request(protocol::RequestUpdateGloveLeftState);
+	uint32_t updatesSinceKeyframe = GLOVE_STATE_KEYFRAME_INTERVAL;
+	uint64_t wireBytes = 0;
+	bool inSync = true;
+
+	for (auto _ : state) {
+		const uint64_t frame = state.iterations();
+		glove.sample.timestamp += 11;
+		glove.imuTimestamp += 11000;
+		glove.sample.joints[protocol::GloveJointIndexRoot] = static_cast<int16_t>(2000 + (frame * 7) % 300);
+		glove.sample.joints[protocol::GloveJointIndexTip] = static_cast<int16_t>(1800 + (frame * 5) % 300);
+		glove.sample.joints[protocol::GloveJointMiddleRoot] = static_cast<int16_t>(2100 + (frame * 3) % 300);
+		glove.imuRotation.w = 1.0 - static_cast<double>(frame % 100) * 1e-4;
+		glove.imuRotation.y = static_cast<double>(frame % 100) * 1e-3;
+		// The thumb rests on the joystick, which only sometimes moves
+		if (frame % 8 == 0) {
+			glove.sample.joystick[0] = static_cast<int16_t>(frame);
+		}
+
+		const bool keyframe = updatesSinceKeyframe >= GLOVE_STATE_KEYFRAME_INTERVAL;
+		updatesSinceKeyframe = keyframe ? 1 : updatesSinceKeyframe + 1;
+		EncodeGloveStateDelta(sent, glove, keyframe, request.gloveDelta);
+		sent = glove;
+		wireBytes += request.WireSize();
+
+		inSync &= ApplyGloveStateDelta(request.gloveDelta, received);
+		benchmark::DoNotOptimize(received);
+	}
+
+	inSync &= memcmp(&received, &glove, sizeof(glove)) == 0;
+	if (!inSync) {
+		state.SkipWithError("The driver's glove state diverged from the overlay's");
+		return;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["bytes_per_update"] = static_cast<double>(wireBytes) / static_cast<double>(state.iterations());
+	state.counters["full_update_bytes"] = static_cast<double>(sizeof(protocol::Request_t));
+}
+BENCHMARK(BM_GloveStateDelta);
+
+// A subscribed tracker's pose during pose offset calibration: pushed by the driver as the tracker updates, and read by
+// the overlay's UI thread, which used to make a blocking pipe round trip for it every frame
+static void BM_PoseStreamRead(benchmark::State& state) {
+	SharedMemoryRegion driverRegion;
+	SharedMemoryRegion overlayRegion;
+	const std::string name = std::string(FREESCUBA_POSE_STREAM_NAME) + "Bench";
+	if (!driverRegion.Create(name, sizeof(PoseStreamBlock_t)) || !overlayRegion.Open(name, sizeof(PoseStreamBlock_t))) {
+		state.SkipWithError("Failed to map the pose stream block");
+		return;
+	}
+
+	PoseStreamBlock_t* driverBlock = new (driverRegion.Data()) PoseStreamBlock_t();
+	driverBlock->version = protocol::Version;
+	const PoseStreamBlock_t* overlayBlock = static_cast<const PoseStreamBlock_t*>(overlayRegion.Data());
+
+	StreamedPose_t pushed = {};
+	pushed.deviceIndex = 3;
+	pushed.pose.qRotation.w = 1.0;
+	uint64_t reads = 0;
+
+	for (auto _ : state) {
+		pushed.timestamp++;
+		pushed.pose.vecPosition[1] = static_cast<double>(pushed.timestamp) * 1e-6;
+		driverBlock->poses[pushed.deviceIndex].Store(pushed);
+
+		StreamedPose_t received;
+		if (overlayBlock->poses[pushed.deviceIndex].TryLoad(received) && received.deviceIndex == pushed.deviceIndex) {
+			benchmark::DoNotOptimize(received);
+			reads++;
+		}
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(reads));
+	state.counters["bytes_per_pose"] = static_cast<double>(sizeof(StreamedPose_t));
+}
+BENCHMARK(BM_PoseStreamRead);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include "hand_simulation.hpp"
+
+// Half curled hand with a little splay, so every joint is rotated
+static GloveFingerCurls MakeCurls() {
+	GloveFingerCurls curls = {};
+	curls.thumb		= { 0.4f, 0.5f };
+	curls.index		= { 0.5f, 0.6f };
+	curls.middle	= { 0.5f, 0.6f };
+	curls.ring		= { 0.6f, 0.7f };
+	curls.pinky		= { 0.6f, 0.7f };
+	return curls;
+}
+
+static GloveFingerSplays MakeSplays() {
+	return { 0.1f, 0.05f, 0.0f, -0.05f, -0.1f };
+}
+
+// Whole skeleton from curls and splays, run by the driver for every glove update
+static void BM_ComputeSkeletonTransforms(benchmark::State& state) {
+	GloveHandSimulation simulation;
+	const GloveFingerCurls curls = MakeCurls();
+	const GloveFingerSplays splays = MakeSplays();
+	vr::VRBoneTransform_t transforms[kHandSkeletonBone_Count] = {};
+
+	for (auto _ : state) {
+		simulation.ComputeSkeletonTransforms(vr::TrackedControllerRole_LeftHand, curls, splays, transforms);
+		benchmark::DoNotOptimize(transforms);
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ComputeSkeletonTransforms);
+
+// Curl of all five fingers from a skeleton, as the driver does when curl is derived from the pose
+static void BM_ApproximateSingleFingerCurl(benchmark::State& state) {
+	GloveHandSimulation simulation;
+	vr::VRBoneTransform_t transforms[kHandSkeletonBone_Count] = {};
+	simulation.ComputeSkeletonTransforms(vr::TrackedControllerRole_LeftHand, MakeCurls(), MakeSplays(), transforms);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(transforms);
+		benchmark::DoNotOptimize(ApproximateSingleFingerCurl(transforms, kHandSkeletonBone_Thumb0,			kHandSkeletonBone_Thumb3));
+		benchmark::DoNotOptimize(ApproximateSingleFingerCurl(transforms, kHandSkeletonBone_IndexFinger1,	kHandSkeletonBone_IndexFinger4));
+		benchmark::DoNotOptimize(ApproximateSingleFingerCurl(transforms, kHandSkeletonBone_MiddleFinger1,	kHandSkeletonBone_MiddleFinger4));
+		benchmark::DoNotOptimize(ApproximateSingleFingerCurl(transforms, kHandSkeletonBone_RingFinger1,		kHandSkeletonBone_RingFinger4));
+		benchmark::DoNotOptimize(ApproximateSingleFingerCurl(transforms, kHandSkeletonBone_PinkyFinger1,	kHandSkeletonBone_PinkyFinger4));
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 5));
+}
+BENCHMARK(BM_ApproximateSingleFingerCurl);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+#include "imu_prediction.hpp"
+#include "maths.hpp"
+
+// IMU samples arrive at about the rate the dongle forwards them
+constexpr uint64_t IMU_SAMPLE_INTERVAL_NS = 10000000;
+
+static vr::HmdQuaternion_t RotationVector(const vr::HmdVector3d_t& v, const double dt) {
+	const double speed = std::sqrt(v.v[0] * v.v[0] + v.v[1] * v.v[1] + v.v[2] * v.v[2]);
+	if (speed <= 0.0) {
+		return HmdQuaternion_Identity;
+	}
+	const double s = std::sin(speed * dt * 0.5) / speed;
+	return { std::cos(speed * dt * 0.5), v.v[0] * s, v.v[1] * s, v.v[2] * s };
+}
+
+// Hand waving about an axis which keeps moving, so every axis of the mounting gets observed
+static vr::HmdVector3d_t PoseAngularVelocity(const double t) {
+	return { 4.0 * std::cos(t), 4.0 * std::sin(t), 2.0 * std::sin(2.0 * t) };
+}
+
+// One IMU sample, one alignment step and one prediction, as the driver does per glove update. The IMU is mounted at an
+// arbitrary rotation to the pose, which the predictor has to learn before it predicts anything
+static void BM_ImuPredictorUpdate(benchmark::State& state) {
+	ImuOrientationPredictor predictor;
+	const vr::HmdQuaternion_t mounting = EulerToQuaternion(0.7, -0.4, 1.9);
+
+	vr::HmdQuaternion_t imuOrientation = HmdQuaternion_Identity;
+	uint64_t timestamp = IMU_SAMPLE_INTERVAL_NS;
+	double t = 0.0;
+	double errorSum = 0.0;
+	uint64_t predictions = 0;
+
+	for (auto _ : state) {
+		const double dt = IMU_SAMPLE_INTERVAL_NS * 1e-9;
+		const vr::HmdVector3d_t poseVelocity = PoseAngularVelocity(t);
+		// The same rotation, seen from the IMU's frame
+		const vr::HmdVector3d_t imuVelocity = poseVelocity * -mounting;
+
+		imuOrientation = imuOrientation * RotationVector(imuVelocity, dt);
+		predictor.AddSample(imuOrientation, timestamp);
+		predictor.Align(poseVelocity);
+		const vr::HmdQuaternion_t predicted = predictor.Predict(timestamp, IMU_PREDICTION_HORIZON_SECONDS);
+		benchmark::DoNotOptimize(predicted);
+
+		if (predictor.IsAligned()) {
+			// Angle between the prediction and the rotation the pose actually makes over the horizon
+			const vr::HmdQuaternion_t error = -predicted * RotationVector(poseVelocity, IMU_PREDICTION_HORIZON_SECONDS);
+			errorSum += 2.0 * std::acos(std::min(std::fabs(error.w), 1.0));
+			predictions++;
+		}
+
+		timestamp += IMU_SAMPLE_INTERVAL_NS;
+		t += dt;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["aligned"] = predictor.IsAligned() ? 1.0 : 0.0;
+	state.counters["mean_error_deg"] = predictions == 0 ? 0.0 : RadToDeg(errorSum / static_cast<double>(predictions));
+}
+BENCHMARK(BM_ImuPredictorUpdate);
@@ -0,0 +1,132 @@
+// Checks that framing and decoding a captured stream never touches the heap. Global operator new and delete are replaced
+// with counting versions for this executable, and the test fails if anything allocates once the input is prepared
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <vector>
+
+#include "cobs.hpp"
+#include "packet_framer.hpp"
+#include "recorded_frames.hpp"
+
+static std::atomic<size_t> s_allocations = 0;
+
+void* operator new(const size_t size) {
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* block = std::malloc(size == 0 ? 1 : size)) {
+		return block;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size) {
+	return operator new(size);
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept {
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete(void* block) noexcept {
+	std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+	std::free(block);
+}
+
+void operator delete(void* block, size_t) noexcept {
+	std::free(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+	std::free(block);
+}
+
+// How many times the recorded stream is repeated, enough to wrap the framer's ring buffer many times over
+static constexpr size_t STREAM_REPEATS = 1000;
+// Size of each simulated bulk read. Not a multiple of any frame's length, so frames are split across reads
+static constexpr size_t READ_SIZE = 61;
+
+static constexpr size_t EXPECTED_FRAMES = STREAM_REPEATS * std::size(recorded_frames::STREAM);
+
+// Feeds the wire through a PacketFramer in bulk reads, as SerialCommunicationManager does. Returns the number of valid frames
+static size_t FrameStream(PacketFramer& framer, const std::vector<uint8_t>& wire) {
+	size_t validFrames = 0;
+	size_t offset = 0;
+
+	while (offset < wire.size()) {
+		size_t writable = 0;
+		uint8_t* region = framer.WriteRegion(writable);
+		const size_t count = std::min({ writable, READ_SIZE, wire.size() - offset });
+		memcpy(region, wire.data() + offset, count);
+		framer.CommitWrite(count);
+		offset += count;
+
+		std::span<const uint8_t> frame;
+		crc checksum;
+		while (framer.NextFrame(frame, checksum)) {
+			if (!frame.empty() && checksum == CRC_RESULT_OK) {
+				validFrames++;
+			}
+		}
+	}
+
+	return validFrames;
+}
+
+// Feeds the wire through a StreamDecoder a byte at a time. Returns the number of valid frames
+static size_t DecodeStream(cobs::StreamDecoder& decoder, const std::vector<uint8_t>& wire) {
+	size_t validFrames = 0;
+
+	for (const uint8_t byte : wire) {
+		if (decoder.Push(byte) == cobs::StreamDecoder::Result_t::FrameComplete && !decoder.Frame().empty() && decoder.Checksum() == CRC_RESULT_OK) {
+			validFrames++;
+		}
+	}
+
+	return validFrames;
+}
+
+int main() {
+	// Everything which may allocate happens before counting starts
+	const std::vector<uint8_t> wire = recorded_frames::EncodeStream(STREAM_REPEATS);
+	PacketFramer* framer = new PacketFramer();
+	cobs::StreamDecoder* decoder = new cobs::StreamDecoder();
+
+	const size_t allocationsBefore = s_allocations.load();
+	const size_t framedFrames = FrameStream(*framer, wire);
+	const size_t decodedFrames = DecodeStream(*decoder, wire);
+	const size_t allocations = s_allocations.load() - allocationsBefore;
+
+	delete decoder;
+	delete framer;
+
+	bool passed = true;
+	if (framedFrames != EXPECTED_FRAMES) {
+		printf("PacketFramer returned %zu valid frames, expected %zu\n", framedFrames, EXPECTED_FRAMES);
+		passed = false;
+	}
+	if (decodedFrames != EXPECTED_FRAMES) {
+		printf("StreamDecoder returned %zu valid frames, expected %zu\n", decodedFrames, EXPECTED_FRAMES);
+		passed = false;
+	}
+	if (allocations != 0) {
+		printf("Framing and decoding made %zu heap allocations, expected none\n", allocations);
+		passed = false;
+	}
+
+	if (passed) {
+		printf("Framed and decoded %zu frames without allocating\n", EXPECTED_FRAMES);
+	}
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,128 @@
+#ifdef __linux__
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "contact_glove/serial_communication.hpp"
+#include "contact_glove/serial_transport_posix.hpp"
+#include "fake_dongle.hpp"
+#include "recorded_frames.hpp"
+
+// How many times the recorded stream is repeated per iteration
+constexpr size_t INGEST_REPEATS = 256;
+
+// Whole ingest pipeline: pty read, ring buffer, COBS, CRC, decode, and the callbacks the overlay registers. With an
+// argument of 1 the raw link is also captured to a file, which should cost the serial thread next to nothing
+static void BM_IngestFromPseudoTerminal(benchmark::State& state) {
+	const bool capture = state.range(0) != 0;
+	FakeDongle dongle;
+	if (!dongle.IsValid()) {
+		state.SkipWithError("Failed to open a pseudo-terminal");
+		return;
+	}
+
+	std::atomic<uint64_t> callbacks = 0;
+	SerialCommunicationManager manager(std::make_unique<PosixSerialTransport>(dongle.SlavePath()));
+	manager.BeginListener(
+		[&](const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) { callbacks++; },
+		[&](const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) { callbacks++; },
+		[](const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) {},
+		[&](const DevicesStatus_t&, const uint64_t) { callbacks++; },
+		[&](const DevicesFirmware_t&, const uint64_t) {});
+
+	while (!manager.IsConnected()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	const std::filesystem::path capturePath = std::filesystem::temp_directory_path() / "freescuba_bench_capture.fscap";
+	if (capture && !manager.StartCapture(capturePath.string())) {
+		state.SkipWithError("Failed to create the capture file");
+		manager.Disconnect();
+		return;
+	}
+
+	const std::vector<uint8_t> wire = recorded_frames::EncodeStream(INGEST_REPEATS);
+	const uint64_t expectedPerIteration = INGEST_REPEATS * recorded_frames::CALLBACK_FRAMES_PER_REPEAT;
+	uint64_t expected = 0;
+
+	for (auto _ : state) {
+		expected += expectedPerIteration;
+		if (!dongle.Send(wire)) {
+			state.SkipWithError("Failed to write to the pseudo-terminal");
+			break;
+		}
+		// Packets dropped by a full dispatch queue never reach a callback
+		while (callbacks.load(std::memory_order_relaxed) + manager.GetDroppedPackets() < expected) {
+			std::this_thread::yield();
+		}
+	}
+
+	manager.Disconnect();
+	if (capture) {
+		manager.StopCapture();
+		std::filesystem::remove(capturePath);
+	}
+
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * wire.size()));
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * expectedPerIteration));
+	state.counters["frames_per_read"] = manager.GetFramesPerRead();
+	state.counters["dropped_packets"] = static_cast<double>(manager.GetDroppedPackets());
+
+	// The recorded stream is clean, anything here means the pipeline mangled it
+	LinkStatistics_t link = {};
+	manager.GetLinkStatistics(link);
+	state.counters["link_errors"] = static_cast<double>(link.crcFailures + link.cobsErrors + link.overflows + link.unknownIds + link.rejectedLengths);
+}
+BENCHMARK(BM_IngestFromPseudoTerminal)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Time from a single frame being written by an otherwise idle dongle to its callback running. The serial thread must be
+// asleep in Read between frames, so this is the wake-up latency of the transport plus dispatch
+static void BM_IngestWakeLatency(benchmark::State& state) {
+	FakeDongle dongle;
+	if (!dongle.IsValid()) {
+		state.SkipWithError("Failed to open a pseudo-terminal");
+		return;
+	}
+
+	std::atomic<uint64_t> callbacks = 0;
+	SerialCommunicationManager manager(std::make_unique<PosixSerialTransport>(dongle.SlavePath()));
+	manager.BeginListener(
+		[](const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) {},
+		[](const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) {},
+		[](const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) {},
+		[&](const DevicesStatus_t&, const uint64_t) { callbacks.fetch_add(1, std::memory_order_release); },
+		[](const DevicesFirmware_t&, const uint64_t) {});
+
+	while (!manager.IsConnected()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	std::vector<uint8_t> wire = { 0x00 };
+	recorded_frames::EncodeFrame(recorded_frames::DEVICES_STATUS, wire);
+	uint64_t expected = 0;
+
+	for (auto _ : state) {
+		// Give the serial thread time to go back to sleep
+		state.PauseTiming();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		state.ResumeTiming();
+
+		expected++;
+		if (!dongle.Send(wire)) {
+			state.SkipWithError("Failed to write to the pseudo-terminal");
+			break;
+		}
+		while (callbacks.load(std::memory_order_acquire) < expected) {
+			std::this_thread::yield();
+		}
+	}
+
+	manager.Disconnect();
+}
+BENCHMARK(BM_IngestWakeLatency)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+#endif // __linux__
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "contact_glove/serial_communication.hpp"
+#include "contact_glove/serial_transport_posix.hpp"
+
+static void PrintUsage(const char* program) {
+	printf("Usage: %s <device> [seconds]\n", program);
+	printf("Reads a dongle (or freescuba_fake_dongle) through the overlay's ingest pipeline, printing what arrives every\n");
+	printf("second. Runs until killed unless a duration is given.\n");
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2 || std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") {
+		PrintUsage(argv[0]);
+		return argc < 2 ? 1 : 0;
+	}
+
+	const std::string device	= argv[1];
+	const int seconds			= argc > 2 ? atoi(argv[2]) : 0;
+
+	std::atomic<uint64_t> inputPackets		= 0;
+	std::atomic<uint64_t> fingersPackets	= 0;
+	std::atomic<uint64_t> imuPackets		= 0;
+	std::atomic<uint64_t> statusPackets		= 0;
+	std::atomic<uint64_t> firmwarePackets	= 0;
+
+	SerialCommunicationManager manager(std::make_unique<PosixSerialTransport>(device));
+	manager.BeginListener(
+		[&](const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) { inputPackets.fetch_add(1, std::memory_order_relaxed); },
+		[&](const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) { fingersPackets.fetch_add(1, std::memory_order_relaxed); },
+		[&](const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) { imuPackets.fetch_add(1, std::memory_order_relaxed); },
+		[&](const DevicesStatus_t&, const uint64_t) { statusPackets.fetch_add(1, std::memory_order_relaxed); },
+		[&](const DevicesFirmware_t&, const uint64_t) { firmwarePackets.fetch_add(1, std::memory_order_relaxed); });
+
+	LinkStatistics_t previous = {};
+	manager.GetLinkStatistics(previous);
+
+	for (int elapsed = 0; seconds <= 0 || elapsed < seconds; elapsed++) {
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+
+		LinkStatistics_t current = {};
+		manager.GetLinkStatistics(current);
+
+		// Anything which isn't zero past the frame rate means ingest is falling over, or the link is noisy
+		printf("%s: %.0f frames/s | callbacks: %llu input, %llu fingers, %llu imu, %llu status, %llu firmware | %.2f frames/read, %zu queued, %llu dropped | "
+			"%llu CRC failures, %llu COBS errors, %llu overflows, %llu unknown, %llu rejected\n",
+			manager.IsConnected() ? "connected" : "disconnected",
+			LinkFramesPerSecond(previous, current),
+			(unsigned long long)inputPackets.load(), (unsigned long long)fingersPackets.load(), (unsigned long long)imuPackets.load(),
+			(unsigned long long)statusPackets.load(), (unsigned long long)firmwarePackets.load(),
+			manager.GetFramesPerRead(), manager.GetPacketQueueDepth(), (unsigned long long)manager.GetDroppedPackets(),
+			(unsigned long long)current.crcFailures, (unsigned long long)current.cobsErrors, (unsigned long long)current.overflows,
+			(unsigned long long)current.unknownIds, (unsigned long long)current.rejectedLengths);
+		fflush(stdout);
+
+		previous = current;
+	}
+
+	manager.Disconnect();
+	return 0;
+}
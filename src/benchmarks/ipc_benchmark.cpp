@@ -0,0 +1,209 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glove_state_delta.hpp"
+#include "ipc_client.hpp"
+#include "ipc_request_dispatch.hpp"
+#include "ipc_transport.hpp"
+
+static const std::string IPC_BENCH_NAME = std::string(FREESCUBA_IPC_NAME) + "Bench";
+
+// Stands in for the driver's DeviceProvider, applying glove updates the way it does
+class BenchDriver : public IIPCDriver {
+public:
+	vr::DriverPose_t GetCachedPose(uint32_t) override { return m_pose; }
+	bool SubscribePoses(const protocol::PoseSubscription_t&) override { return true; }
+
+	void HandleGloveUpdate(const protocol::GloveStateDelta_t& delta, uint32_t glovePair, bool isLeft) override {
+		if (!ApplyGloveStateDelta(delta, m_gloves[glovePair][isLeft ? protocol::LeftGlove : protocol::RightGlove])) {
+			malformed.fetch_add(1, std::memory_order_relaxed);
+		}
+		gloveUpdates.fetch_add(1, std::memory_order_relaxed);
+	}
+	void HandleGloveCalibration(const protocol::GloveCalibration_t&, uint32_t, bool) override {}
+
+	std::atomic<uint64_t> gloveUpdates = 0;
+	std::atomic<uint64_t> malformed = 0;
+
+private:
+	vr::DriverPose_t m_pose = {};
+	protocol::ContactGloveState_t m_gloves[protocol::MAX_GLOVE_PAIRS][2] = {};
+};
+
+// Answers requests through the same DispatchIPCRequest as the driver's IPCServer
+class BenchRequestHandler : public IIPCRequestHandler {
+public:
+	void OnConnected(IPCConnection_t&) override {}
+	void OnDisconnected(IPCConnection_t&) override {}
+
+	void HandleRequest(IPCConnection_t& connection) override {
+		requests.fetch_add(1, std::memory_order_relaxed);
+
+		const uint32_t lostBefore = connection.updatesLost;
+		if (DispatchIPCRequest(driver, connection) != IPCRequestStatus::Handled) {
+			driver.malformed.fetch_add(1, std::memory_order_relaxed);
+		}
+		updatesLost.fetch_add(connection.updatesLost - lostBefore, std::memory_order_relaxed);
+	}
+
+	BenchDriver driver;
+	std::atomic<uint64_t> requests = 0;
+	// Glove updates the clients skipped, going by the gaps in their sequence numbers
+	std::atomic<uint64_t> updatesLost = 0;
+};
+
+// The server transport running on a thread of its own, as in the driver
+class BenchServer {
+public:
+	bool Start() {
+		m_transport = CreateIPCServerTransport();
+		if (!m_transport->Listen(IPC_BENCH_NAME)) {
+			return false;
+		}
+		m_thread = std::thread([this]() { m_transport->Run(handler); });
+		return true;
+	}
+
+	~BenchServer() {
+		if (m_thread.joinable()) {
+			m_transport->Interrupt();
+			m_thread.join();
+		}
+	}
+
+	BenchRequestHandler handler;
+
+private:
+	std::unique_ptr<IIPCServerTransport> m_transport;
+	std::thread m_thread;
+};
+
+// Clients hammering the server from their own threads until stopped, each calling send in a loop
+template <typename SendFn>
+class BackgroundClients {
+public:
+	BackgroundClients(const size_t count, SendFn send) : m_stop(false), m_connected(0) {
+		for (size_t i = 0; i < count; i++) {
+			m_threads.emplace_back([this, send]() mutable {
+				try {
+					IPCClient client;
+					client.Connect(IPC_BENCH_NAME);
+					m_connected++;
+					while (!m_stop.load(std::memory_order_relaxed)) {
+						send(client);
+					}
+				} catch (const std::exception&) {
+					m_connected++;
+				}
+			});
+		}
+		while (m_connected.load() < count) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	~BackgroundClients() {
+		m_stop = true;
+		for (std::thread& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+private:
+	std::atomic<bool> m_stop;
+	std::atomic<size_t> m_connected;
+	std::vector<std::thread> m_threads;
+};
+
+static protocol::ContactGloveState_t MovingGlove(const uint64_t frame) {
+	protocol::ContactGloveState_t glove = {};
+	glove.isConnected = true;
+	glove.trackerIndex = 3;
+	glove.sample.timestamp = static_cast<uint32_t>(frame * 11);
+	glove.sample.joints[protocol::GloveJointIndexRoot] = static_cast<int16_t>(2000 + (frame * 7) % 300);
+	glove.sample.joints[protocol::GloveJointMiddleRoot] = static_cast<int16_t>(2100 + (frame * 3) % 300);
+	return glove;
+}
+
+// Latency of one client's blocking request (a device pose, as calibration used to ask for every frame) while the given
+// number of other clients make the same request as fast as they can
+static void BM_IPCRoundTrip(benchmark::State& state) {
+	BenchServer server;
+	if (!server.Start()) {
+		state.SkipWithError("Failed to listen for IPC clients");
+		return;
+	}
+
+	IPCClient client;
+	try {
+		client.Connect(IPC_BENCH_NAME);
+	} catch (const std::exception& e) {
+		state.SkipWithError(e.what());
+		return;
+	}
+
+	const auto requestPose = [](IPCClient& background) { background.SendBlocking(protocol::Request_t(3u)); };
+	BackgroundClients<decltype(requestPose)> background(static_cast<size_t>(state.range(0)), requestPose);
+
+	const uint64_t requestsStart = server.handler.requests.load();
+	for (auto _ : state) {
+		const protocol::Response_t response = client.SendBlocking(protocol::Request_t(3u));
+		if (response.type != protocol::ResponseDevicePose) {
+			state.SkipWithError("Unexpected response");
+			break;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["server_requests"] = benchmark::Counter(static_cast<double>(server.handler.requests.load() - requestsStart), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_IPCRoundTrip)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// One way glove updates, as the overlay sends when the glove state block is unavailable, from the given number of clients
+// streaming at once. Each client is acked every GLOVE_UPDATE_ACK_INTERVAL updates
+static void BM_IPCGloveUpdates(benchmark::State& state) {
+	BenchServer server;
+	if (!server.Start()) {
+		state.SkipWithError("Failed to listen for IPC clients");
+		return;
+	}
+
+	IPCClient client;
+	try {
+		client.Connect(IPC_BENCH_NAME);
+	} catch (const std::exception& e) {
+		state.SkipWithError(e.what());
+		return;
+	}
+
+	auto streamGlove = [frame = uint64_t(0)](IPCClient& background) mutable {
+		background.SendGloveUpdate(MovingGlove(frame++), 0, true);
+	};
+	BackgroundClients<decltype(streamGlove)> background(static_cast<size_t>(state.range(0)) - 1, streamGlove);
+
+	const uint64_t updatesStart = server.handler.driver.gloveUpdates.load();
+	const uint64_t lostStart = server.handler.updatesLost.load();
+	uint64_t frame = 0;
+	for (auto _ : state) {
+		client.SendGloveUpdate(MovingGlove(frame++), 0, true);
+	}
+	// Waits until the server has caught up with this client
+	client.SendBlocking(protocol::Request_t(protocol::RequestHandshake));
+
+	if (server.handler.driver.malformed.load() != 0) {
+		state.SkipWithError("The server received malformed glove updates");
+		return;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["server_updates"] = benchmark::Counter(static_cast<double>(server.handler.driver.gloveUpdates.load() - updatesStart), benchmark::Counter::kIsRate);
+	state.counters["server_updates_lost"] = static_cast<double>(server.handler.updatesLost.load() - lostStart);
+}
+BENCHMARK(BM_IPCGloveUpdates)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include "maths.hpp"
+
+// Built into both freescuba_bench and freescuba_driver_bench, each linking its own maths.cpp (the overlay's and the
+// driver's). They define the same symbols, so they can't share an executable
+
+static const vr::HmdQuaternion_t MATHS_ROTATION_A	= { 0.9238795, 0.3826834, 0.0, 0.0 };
+static const vr::HmdQuaternion_t MATHS_ROTATION_B	= { 0.7071068, 0.0, 0.7071068, 0.0 };
+
+static void BM_QuaternionMultiply(benchmark::State& state) {
+	vr::HmdQuaternion_t q = MATHS_ROTATION_A;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(q);
+		const vr::HmdQuaternion_t result = q * MATHS_ROTATION_B;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_QuaternionMultiply);
+
+static void BM_QuaternionMultiplyFloat(benchmark::State& state) {
+	vr::HmdQuaternionf_t q = { 0.9238795f, 0.3826834f, 0.0f, 0.0f };
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(q);
+		const vr::HmdQuaternionf_t result = q * MATHS_ROTATION_B;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_QuaternionMultiplyFloat);
+
+static void BM_QuaternionConjugate(benchmark::State& state) {
+	vr::HmdQuaternion_t q = MATHS_ROTATION_A;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(q);
+		const vr::HmdQuaternion_t result = -q;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_QuaternionConjugate);
+
+// Rotating a vector is two quaternion products, as done for every pose offset
+static void BM_QuaternionRotateVector3d(benchmark::State& state) {
+	vr::HmdVector3d_t vec = { 0.1, 0.2, 0.3 };
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(vec);
+		const vr::HmdVector3d_t result = vec * MATHS_ROTATION_A;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_QuaternionRotateVector3d);
+
+static void BM_QuaternionRotateVector3(benchmark::State& state) {
+	vr::HmdVector3_t vec = { 0.1f, 0.2f, 0.3f };
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(vec);
+		const vr::HmdVector3_t result = vec * MATHS_ROTATION_A;
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_QuaternionRotateVector3);
+
+static void BM_EulerToQuaternion(benchmark::State& state) {
+	double yaw = 0.3;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(yaw);
+		const vr::HmdQuaternion_t result = EulerToQuaternion(yaw, 0.2, 0.1);
+		benchmark::DoNotOptimize(result);
+	}
+}
+BENCHMARK(BM_EulerToQuaternion);
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <span>
+
+#include "packet_descriptors.hpp"
+#include "recorded_frames.hpp"
+
+struct RecordedPacket_t {
+	const char* name;
+	std::span<const uint8_t> frame;
+};
+
+static const RecordedPacket_t RECORDED_PACKETS[] = {
+	{ "devices_versions",		recorded_frames::DEVICES_VERSIONS },
+	{ "devices_status",			recorded_frames::DEVICES_STATUS },
+	{ "power_on",				recorded_frames::POWER_ON },
+	{ "glove_left_data",		recorded_frames::GLOVE_LEFT_DATA },
+	{ "glove_left_fingers",		recorded_frames::GLOVE_LEFT_FINGERS },
+	{ "glove_left_imu",			recorded_frames::GLOVE_LEFT_IMU },
+	{ "glove_right_data",		recorded_frames::GLOVE_RIGHT_DATA },
+	{ "glove_right_fingers",	recorded_frames::GLOVE_RIGHT_FINGERS },
+	{ "glove_right_imu",		recorded_frames::GLOVE_RIGHT_IMU },
+};
+constexpr int64_t RECORDED_PACKET_COUNT = sizeof(RECORDED_PACKETS) / sizeof(RECORDED_PACKETS[0]);
+
+// Descriptor lookup, length check and payload extraction for a single decoded frame of each packet type
+static void BM_DecodePacket(benchmark::State& state) {
+	const RecordedPacket_t& recorded = RECORDED_PACKETS[state.range(0)];
+	ContactGlovePacket_t packet = {};
+
+	for (auto _ : state) {
+		const PacketDecodeResult_t result = DecodePacketFrame(recorded.frame, &packet);
+		benchmark::DoNotOptimize(result);
+		benchmark::DoNotOptimize(packet);
+	}
+
+	state.SetLabel(recorded.name);
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_DecodePacket)->DenseRange(0, RECORDED_PACKET_COUNT - 1);
@@ -0,0 +1,115 @@
+// Pushes poses for several devices from their own threads while another thread keeps switching which devices are
+// subscribed to, and fails if the overlay ever reads a torn pose, another device's pose, or a pose older than one it read
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "pose_stream_writer.hpp"
+
+// More devices than a subscription can hold, so every switch moves devices in and out of the stream
+static constexpr uint32_t DEVICE_COUNT = protocol::POSE_SUBSCRIPTION_MAX_DEVICES * 2;
+static constexpr std::chrono::milliseconds STRESS_DURATION = std::chrono::milliseconds(500);
+
+struct ReaderResult_t {
+	uint64_t reads;
+	uint64_t tornReads;
+	uint64_t misplacedReads;
+	uint64_t backwardReads;
+};
+
+// Every field of the pose holds the push's count, so a torn read is easy to spot
+static vr::DriverPose_t MakePose(const uint32_t deviceIndex, const double count) {
+	vr::DriverPose_t pose = {};
+	pose.vecPosition[0] = pose.vecPosition[1] = pose.vecPosition[2] = count;
+	pose.vecVelocity[0] = pose.vecVelocity[1] = pose.vecVelocity[2] = count;
+	pose.qRotation = { count, count, count, count };
+	pose.vecAngularVelocity[0] = static_cast<double>(deviceIndex);
+	return pose;
+}
+
+static bool IsTorn(const vr::DriverPose_t& pose) {
+	const double count = pose.vecPosition[0];
+	return pose.vecPosition[1] != count || pose.vecPosition[2] != count
+		|| pose.vecVelocity[0] != count || pose.vecVelocity[1] != count || pose.vecVelocity[2] != count
+		|| pose.qRotation.w != count || pose.qRotation.x != count || pose.qRotation.y != count || pose.qRotation.z != count;
+}
+
+int main() {
+	PoseStreamBlock_t* block = new PoseStreamBlock_t();
+	block->version = protocol::Version;
+
+	PoseStreamWriter writer;
+	writer.SetBlock(block);
+	std::atomic<bool> running = true;
+
+	// Each device's poses come from its own thread, as SteamVR's do
+	std::vector<std::thread> devices;
+	for (uint32_t deviceIndex = 0; deviceIndex < DEVICE_COUNT; deviceIndex++) {
+		devices.emplace_back([&, deviceIndex]() {
+			double count = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				writer.Push(deviceIndex, MakePose(deviceIndex, ++count));
+			}
+		});
+	}
+
+	// Slides the subscription along the devices, as the overlay does when calibration moves between trackers
+	uint64_t subscriptions = 0;
+	std::thread subscriber([&]() {
+		while (running.load(std::memory_order_relaxed)) {
+			protocol::PoseSubscription_t subscription = {};
+			subscription.deviceCount = protocol::POSE_SUBSCRIPTION_MAX_DEVICES;
+			for (uint32_t i = 0; i < subscription.deviceCount; i++) {
+				subscription.deviceIndices[i] = static_cast<uint32_t>((subscriptions + i) % DEVICE_COUNT);
+			}
+			if (!writer.Subscribe(subscription)) {
+				break;
+			}
+			subscriptions++;
+		}
+	});
+
+	ReaderResult_t result = {};
+	double lastCount[DEVICE_COUNT] = {};
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + STRESS_DURATION;
+	while (std::chrono::steady_clock::now() < end) {
+		for (uint32_t deviceIndex = 0; deviceIndex < DEVICE_COUNT; deviceIndex++) {
+			StreamedPose_t streamed;
+			if (!block->poses[deviceIndex].TryLoad(streamed) || streamed.timestamp == 0) {
+				continue;
+			}
+
+			result.reads++;
+			if (IsTorn(streamed.pose)) {
+				result.tornReads++;
+			} else if (streamed.deviceIndex != deviceIndex || streamed.pose.vecAngularVelocity[0] != static_cast<double>(deviceIndex)) {
+				result.misplacedReads++;
+			} else if (streamed.pose.vecPosition[0] < lastCount[deviceIndex]) {
+				result.backwardReads++;
+			} else {
+				lastCount[deviceIndex] = streamed.pose.vecPosition[0];
+			}
+		}
+	}
+
+	running = false;
+	subscriber.join();
+	for (std::thread& device : devices) {
+		device.join();
+	}
+	writer.SetBlock(nullptr);
+	delete block;
+
+	printf("%llu subscriptions, %llu reads, %llu torn, %llu from another device, %llu backwards\n",
+		static_cast<unsigned long long>(subscriptions), static_cast<unsigned long long>(result.reads), static_cast<unsigned long long>(result.tornReads),
+		static_cast<unsigned long long>(result.misplacedReads), static_cast<unsigned long long>(result.backwardReads));
+
+	const bool passed = subscriptions > 0 && result.reads > 0 && result.tornReads == 0 && result.misplacedReads == 0 && result.backwardReads == 0;
+	if (!passed) {
+		printf("The pose stream returned a torn, misplaced or out of order pose\n");
+	}
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "glove_processing.hpp"
+#include "contact_glove/contact_glove_structs.hpp"
+
+// Same window as the overlay uses for the battery filter, see app_state.hpp
+constexpr uint32_t PROCESSING_BATTERY_WINDOW = 128;
+
+static GloveState_t MakeCalibratedGlove() {
+	GloveState_t glove = {};
+
+	glove.hasMagnetra		= true;
+	glove.joystickXRaw		= 150;
+	glove.joystickYRaw		= 130;
+	glove.gloveBatteryRaw	= 98;
+
+	glove.calibration.joystick.threshold	= 0.05f;
+	glove.calibration.joystick.XMin			= 20;
+	glove.calibration.joystick.XMax			= 260;
+	glove.calibration.joystick.YMin			= 20;
+	glove.calibration.joystick.YMax			= 260;
+	glove.calibration.joystick.forwardAngle	= 0.3f;
+
+	protocol::ContactGloveState_t::FingerCalibrationData_t* fingers[] = {
+		&glove.calibration.fingers.thumb, &glove.calibration.fingers.index, &glove.calibration.fingers.middle,
+		&glove.calibration.fingers.ring, &glove.calibration.fingers.pinky,
+	};
+	for (protocol::ContactGloveState_t::FingerCalibrationData_t* finger : fingers) {
+		finger->proximal	= { 1500, 1300, 1900 };
+		finger->distal		= { 1500, 1300, 1900 };
+	}
+
+	uint16_t* raw[] = {
+		&glove.thumbRootRaw, &glove.thumbTipRaw, &glove.indexRootRaw, &glove.indexTipRaw, &glove.middleRootRaw,
+		&glove.middleTipRaw, &glove.ringRootRaw, &glove.ringTipRaw, &glove.pinkyRootRaw, &glove.pinkyTipRaw,
+	};
+	for (size_t i = 0; i < sizeof(raw) / sizeof(raw[0]); i++) {
+		*raw[i] = static_cast<uint16_t>(1550 + i * 30);
+	}
+
+	return glove;
+}
+
+// Calibration, joystick deadzone and battery filtering for a connected glove, as run by the overlay every frame
+static void BM_ProcessGlove(benchmark::State& state) {
+	GloveState_t glove = MakeCalibratedGlove();
+	MostCommonElementRingBuffer batteryBuffer;
+	batteryBuffer.Init(PROCESSING_BATTERY_WINDOW);
+
+	for (auto _ : state) {
+		ProcessGlove(glove, batteryBuffer, std::chrono::steady_clock::now());
+		benchmark::DoNotOptimize(glove);
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ProcessGlove);
+
+// Quantising a processed glove into the state sent to the driver, then the driver unpacking its joints again
+static void BM_GloveSampleRoundTrip(benchmark::State& state) {
+	GloveState_t glove = MakeCalibratedGlove();
+	MostCommonElementRingBuffer batteryBuffer;
+	batteryBuffer.Init(PROCESSING_BATTERY_WINDOW);
+	glove.isConnected = true;
+	ProcessGlove(glove, batteryBuffer, std::chrono::steady_clock::now());
+
+	protocol::ContactGloveState_t packed = {};
+	float joints[protocol::GloveJoint_Count];
+
+	for (auto _ : state) {
+		PackGloveState(glove, packed);
+		protocol::UnpackGloveJoints(packed.sample.joints, joints);
+		benchmark::DoNotOptimize(joints);
+	}
+
+	// Largest difference between a joint and its round trip, which should be within the Q15 step
+	float maxError = std::fabs(joints[protocol::GloveJointThumbRoot] - glove.thumbRoot);
+	maxError = std::max(maxError, std::fabs(joints[protocol::GloveJointIndexTip] - glove.indexTip));
+	maxError = std::max(maxError, std::fabs(joints[protocol::GloveJointPinkyTip] - glove.pinkyTip));
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+	state.counters["bytes_per_glove"] = static_cast<double>(sizeof(protocol::GloveSample_t));
+	state.counters["max_error"] = maxError;
+}
+BENCHMARK(BM_GloveSampleRoundTrip);
@@ -0,0 +1,172 @@
+#ifdef __linux__
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "contact_glove/serial_communication.hpp"
+#include "contact_glove/serial_reactor.hpp"
+#include "contact_glove/serial_transport_posix.hpp"
+#include "fake_dongle.hpp"
+#include "recorded_frames.hpp"
+
+// How many times the recorded stream is repeated per dongle per iteration, about one millisecond of both gloves streaming
+constexpr size_t REACTOR_REPEATS = 4;
+
+// CPU time used by every thread in the process, as the serial and dispatch threads are where the cost is
+static double ProcessCpuSeconds() {
+	rusage usage = {};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+		+ static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// Sends a burst to every dongle, then waits until every packet has reached a callback or been dropped
+template <typename DroppedFn>
+static bool SendToAll(const std::vector<std::unique_ptr<FakeDongle>>& dongles, const std::vector<uint8_t>& wire,
+	const std::atomic<uint64_t>& callbacks, const uint64_t expected, DroppedFn dropped) {
+	for (const std::unique_ptr<FakeDongle>& dongle : dongles) {
+		if (!dongle->Send(wire)) {
+			return false;
+		}
+	}
+	while (callbacks.load(std::memory_order_relaxed) + dropped() < expected) {
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+static std::vector<std::unique_ptr<FakeDongle>> MakeDongles(const size_t count) {
+	std::vector<std::unique_ptr<FakeDongle>> dongles;
+	for (size_t i = 0; i < count; i++) {
+		dongles.push_back(std::make_unique<FakeDongle>());
+		if (!dongles.back()->IsValid()) {
+			return {};
+		}
+	}
+	return dongles;
+}
+
+// N dongles serviced by a single SerialReactor (one serial thread and one dispatch thread in total)
+static void BM_ReactorIngest(benchmark::State& state) {
+	const size_t dongleCount = static_cast<size_t>(state.range(0));
+	const std::vector<std::unique_ptr<FakeDongle>> dongles = MakeDongles(dongleCount);
+	if (dongles.empty()) {
+		state.SkipWithError("Failed to open a pseudo-terminal");
+		return;
+	}
+
+	std::atomic<uint64_t> callbacks = 0;
+	SerialReactor reactor;
+	for (const std::unique_ptr<FakeDongle>& dongle : dongles) {
+		reactor.AddDongle(std::make_unique<PosixSerialTransport>(dongle->SlavePath()), dongle->SlavePath());
+	}
+	reactor.BeginListener(
+		[&](const size_t, const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) { callbacks++; },
+		[&](const size_t, const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) { callbacks++; },
+		[](const size_t, const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) {},
+		[&](const size_t, const DevicesStatus_t&, const uint64_t) { callbacks++; },
+		[&](const size_t, const DevicesFirmware_t&, const uint64_t) {});
+
+	for (size_t i = 0; i < dongleCount; i++) {
+		while (!reactor.GetDongle(i).IsConnected()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	const auto dropped = [&]() {
+		uint64_t total = 0;
+		for (size_t i = 0; i < dongleCount; i++) {
+			total += reactor.GetDongle(i).GetDroppedPackets();
+		}
+		return total;
+	};
+
+	const std::vector<uint8_t> wire = recorded_frames::EncodeStream(REACTOR_REPEATS);
+	const uint64_t expectedPerIteration = REACTOR_REPEATS * recorded_frames::CALLBACK_FRAMES_PER_REPEAT * dongleCount;
+	uint64_t expected = 0;
+
+	const double cpuStart = ProcessCpuSeconds();
+	for (auto _ : state) {
+		expected += expectedPerIteration;
+		if (!SendToAll(dongles, wire, callbacks, expected, dropped)) {
+			state.SkipWithError("Failed to write to the pseudo-terminal");
+			break;
+		}
+	}
+	const double cpuUsed = ProcessCpuSeconds() - cpuStart;
+
+	reactor.Disconnect();
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * expectedPerIteration));
+	state.counters["process_cpu_us_per_dongle"] = cpuUsed * 1e6 / static_cast<double>(state.iterations() * dongleCount);
+	state.counters["dropped_packets"] = static_cast<double>(dropped());
+}
+BENCHMARK(BM_ReactorIngest)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// The same load with a SerialCommunicationManager per dongle (two threads per dongle), for comparison
+static void BM_ThreadPerDongleIngest(benchmark::State& state) {
+	const size_t dongleCount = static_cast<size_t>(state.range(0));
+	const std::vector<std::unique_ptr<FakeDongle>> dongles = MakeDongles(dongleCount);
+	if (dongles.empty()) {
+		state.SkipWithError("Failed to open a pseudo-terminal");
+		return;
+	}
+
+	std::atomic<uint64_t> callbacks = 0;
+	std::vector<std::unique_ptr<SerialCommunicationManager>> managers;
+	for (const std::unique_ptr<FakeDongle>& dongle : dongles) {
+		managers.push_back(std::make_unique<SerialCommunicationManager>(std::make_unique<PosixSerialTransport>(dongle->SlavePath())));
+		managers.back()->BeginListener(
+			[&](const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) { callbacks++; },
+			[&](const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) { callbacks++; },
+			[](const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) {},
+			[&](const DevicesStatus_t&, const uint64_t) { callbacks++; },
+			[&](const DevicesFirmware_t&, const uint64_t) {});
+	}
+
+	for (const std::unique_ptr<SerialCommunicationManager>& manager : managers) {
+		while (!manager->IsConnected()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	const auto dropped = [&]() {
+		uint64_t total = 0;
+		for (const std::unique_ptr<SerialCommunicationManager>& manager : managers) {
+			total += manager->GetDroppedPackets();
+		}
+		return total;
+	};
+
+	const std::vector<uint8_t> wire = recorded_frames::EncodeStream(REACTOR_REPEATS);
+	const uint64_t expectedPerIteration = REACTOR_REPEATS * recorded_frames::CALLBACK_FRAMES_PER_REPEAT * dongleCount;
+	uint64_t expected = 0;
+
+	const double cpuStart = ProcessCpuSeconds();
+	for (auto _ : state) {
+		expected += expectedPerIteration;
+		if (!SendToAll(dongles, wire, callbacks, expected, dropped)) {
+			state.SkipWithError("Failed to write to the pseudo-terminal");
+			break;
+		}
+	}
+	const double cpuUsed = ProcessCpuSeconds() - cpuStart;
+
+	for (const std::unique_ptr<SerialCommunicationManager>& manager : managers) {
+		manager->Disconnect();
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * expectedPerIteration));
+	state.counters["process_cpu_us_per_dongle"] = cpuUsed * 1e6 / static_cast<double>(state.iterations() * dongleCount);
+	state.counters["dropped_packets"] = static_cast<double>(dropped());
+}
+BENCHMARK(BM_ThreadPerDongleIngest)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+#endif // __linux__
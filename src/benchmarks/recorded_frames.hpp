@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "cobs.hpp"
+#include "contact_glove_structs.hpp"
+
+// Decoded frames (packet id, payload and CRC byte) recorded from a dongle, see contact_glove_structs.hpp
+namespace recorded_frames {
+
+	constexpr uint8_t DEVICES_VERSIONS[]	= { 0x07, 0x01, 0x06, 0x01, 0x06, 0x01, 0x06, 0x1D };
+	constexpr uint8_t GLOVE_LEFT_DATA[]		= { 0x01, 0x3F, 0x00, 0x90, 0x00, 0x84, 0x73 };
+	constexpr uint8_t GLOVE_RIGHT_DATA[]	= { 0x02, 0x3F, 0x00, 0x98, 0x00, 0x89, 0x7A };
+	constexpr uint8_t DEVICES_STATUS[]		= { 0x1E, 0x62, 0x5F, 0x5C, 0x5F, 0x01, 0x77 };
+	constexpr uint8_t GLOVE_RIGHT_FINGERS[]	= { 0x05, 0x35, 0x06, 0xF9, 0x06, 0xA7, 0x06, 0x30, 0x06, 0xE0, 0x06, 0x9C, 0x06, 0x0A, 0x07, 0xB2, 0x06, 0x58, 0x06, 0x1F, 0x06, 0x89 };
+	constexpr uint8_t GLOVE_RIGHT_IMU[]		= { 0x0B, 0xFF, 0x00, 0x60, 0x89, 0x1C, 0x73, 0x21, 0x80, 0x57 };
+	constexpr uint8_t GLOVE_LEFT_FINGERS[]	= { 0x04, 0xD3, 0x06, 0xF0, 0x06, 0xA0, 0x06, 0xD9, 0x06, 0xC5, 0x06, 0xD9, 0x06, 0xBA, 0x06, 0x5B, 0x06, 0x9C, 0x06, 0x94, 0x06, 0x1F };
+	constexpr uint8_t GLOVE_LEFT_IMU[]		= { 0x0A, 0x30, 0x00, 0x58, 0x82, 0x92, 0x86, 0xDC, 0x7F, 0xAE };
+	constexpr uint8_t POWER_ON[]			= { 0x64, 0x01, 0x10, 0x01, 0x00, 0x82 };
+
+	// Roughly the mix the dongle sends while both gloves are streaming
+	inline constexpr std::span<const uint8_t> STREAM[] = {
+		GLOVE_LEFT_DATA, GLOVE_LEFT_FINGERS, GLOVE_LEFT_IMU,
+		GLOVE_RIGHT_DATA, GLOVE_RIGHT_FINGERS, GLOVE_RIGHT_IMU,
+		DEVICES_STATUS,
+	};
+
+	// Frames in STREAM which reach the callbacks the benchmarks count: glove data, fingers and status, but not the IMU
+	constexpr uint64_t CountCallbackFrames() {
+		uint64_t count = 0;
+		for (const std::span<const uint8_t> frame : STREAM) {
+			if (frame[0] != ::GLOVE_LEFT_PACKET_IMU && frame[0] != ::GLOVE_RIGHT_PACKET_IMU) {
+				count++;
+			}
+		}
+		return count;
+	}
+	constexpr uint64_t CALLBACK_FRAMES_PER_REPEAT = CountCallbackFrames();
+
+	// Appends a single frame to wire as it arrives over the wire: COBS encoded and terminated by 0x00
+	inline void EncodeFrame(const std::span<const uint8_t> frame, std::vector<uint8_t>& wire) {
+		uint8_t encoded[cobs::MAX_DECODED_SIZE + 2] = {};
+
+		cobs::encode(frame.data(), static_cast<uint32_t>(frame.size()), encoded);
+		wire.insert(wire.end(), encoded, encoded + frame.size() + 1);
+		wire.push_back(0x00);
+	}
+
+	/// <summary>
+	/// Returns the recorded stream as it arrives over the wire: each frame COBS encoded, prefixed and terminated by 0x00.
+	/// </summary>
+	inline std::vector<uint8_t> EncodeStream(const size_t repeats) {
+		std::vector<uint8_t> wire;
+
+		wire.push_back(0x00);
+		for (size_t i = 0; i < repeats; i++) {
+			for (const std::span<const uint8_t> frame : STREAM) {
+				EncodeFrame(frame, wire);
+			}
+		}
+
+		return wire;
+	}
+}
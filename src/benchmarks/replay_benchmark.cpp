@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <thread>
+
+#include "contact_glove/capture_recorder.hpp"
+#include "contact_glove/serial_communication.hpp"
+#include "contact_glove/serial_transport_replay.hpp"
+#include "recorded_frames.hpp"
+
+// How many times the recorded stream is repeated in the capture
+constexpr size_t REPLAY_REPEATS = 1024;
+// Time between repeats in the capture, about how often both gloves send a full set of packets
+constexpr uint64_t REPLAY_REPEAT_INTERVAL_NS = 1000000;
+
+// Writes the recorded stream to a capture through CaptureRecorder, as the overlay would have recorded it
+static bool WriteCapture(const std::filesystem::path& path) {
+	CaptureRecorder recorder;
+	if (!recorder.Start(path.string())) {
+		return false;
+	}
+
+	std::vector<uint8_t> wire;
+	for (size_t i = 0; i < REPLAY_REPEATS; i++) {
+		for (const std::span<const uint8_t> frame : recorded_frames::STREAM) {
+			// The recorder wants the frame without its delimiter
+			wire.clear();
+			recorded_frames::EncodeFrame(frame, wire);
+
+			RawFrame_t raw = {};
+			raw.first = std::span<const uint8_t>(wire.data(), wire.size() - 1);
+			recorder.Record(i * REPLAY_REPEAT_INTERVAL_NS, raw, FrameStatus_t::Decoded, CRC_RESULT_OK);
+		}
+		recorder.Commit();
+	}
+
+	recorder.Stop();
+	return recorder.DroppedFrames() == 0;
+}
+
+// A whole capture replayed through the ingest pipeline (framing, COBS, CRC, decode, and callbacks) per iteration, with
+// no dongle. The argument is the replay speed in percent of real time, 0 replays as fast as possible
+static void BM_ReplayCapture(benchmark::State& state) {
+	const double speed = static_cast<double>(state.range(0)) / 100.0;
+
+	const std::filesystem::path capturePath = std::filesystem::temp_directory_path() / "freescuba_bench_replay.fscap";
+	if (!WriteCapture(capturePath)) {
+		state.SkipWithError("Failed to write the capture");
+		return;
+	}
+
+	const uint64_t expectedPerIteration = REPLAY_REPEATS * recorded_frames::CALLBACK_FRAMES_PER_REPEAT;
+	uint64_t dropped = 0;
+	uint64_t linkErrors = 0;
+
+	for (auto _ : state) {
+		std::atomic<uint64_t> callbacks = 0;
+		std::unique_ptr<ReplaySerialTransport> transport = std::make_unique<ReplaySerialTransport>(capturePath.string(), speed);
+		ReplaySerialTransport* replay = transport.get();
+		SerialCommunicationManager manager(std::move(transport));
+		// Unthrottled replay waits for the dispatch thread, so every packet reaches a callback and the result is repeatable
+		replay->SetDrainCheck([&manager]() { return manager.GetPacketQueueDepth() == 0; });
+		manager.BeginListener(
+			[&](const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t) { callbacks++; },
+			[&](const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t) { callbacks++; },
+			[](const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t) {},
+			[&](const DevicesStatus_t&, const uint64_t) { callbacks++; },
+			[&](const DevicesFirmware_t&, const uint64_t) {});
+
+		while (callbacks.load(std::memory_order_relaxed) + manager.GetDroppedPackets() < expectedPerIteration) {
+			std::this_thread::yield();
+		}
+
+		manager.Disconnect();
+
+		LinkStatistics_t link = {};
+		manager.GetLinkStatistics(link);
+		dropped += manager.GetDroppedPackets();
+		linkErrors += link.crcFailures + link.cobsErrors + link.overflows + link.unknownIds + link.rejectedLengths;
+	}
+
+	std::filesystem::remove(capturePath);
+
+	if (dropped != 0) {
+		state.SkipWithError("Packets were dropped during replay");
+	}
+
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * expectedPerIteration));
+	state.counters["dropped_packets"] = static_cast<double>(dropped);
+	state.counters["link_errors"] = static_cast<double>(linkErrors);
+}
+BENCHMARK(BM_ReplayCapture)->Arg(0)->Arg(1000)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+
+#include "seqlock.hpp"
+
+// Roughly the size of a glove input snapshot. Every field holds the same value, so a torn read is easy to spot
+struct StressValue_t {
+	uint32_t fields[24];
+};
+
+static StressValue_t MakeStressValue(const uint32_t value) {
+	StressValue_t result;
+	for (uint32_t& field : result.fields) {
+		field = value;
+	}
+	return result;
+}
+
+// Reads snapshots while another thread publishes new ones as fast as it can, failing if any read is torn
+static void BM_SeqLockLoadUnderContention(benchmark::State& state) {
+	SeqLock<StressValue_t> seqLock;
+	std::atomic<bool> running = true;
+
+	std::thread writer([&]() {
+		uint32_t value = 0;
+		while (running.load(std::memory_order_relaxed)) {
+			seqLock.Store(MakeStressValue(++value));
+		}
+	});
+
+	uint64_t tornReads = 0;
+	for (auto _ : state) {
+		const StressValue_t snapshot = seqLock.Load();
+		for (const uint32_t field : snapshot.fields) {
+			if (field != snapshot.fields[0]) {
+				tornReads++;
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(snapshot);
+	}
+
+	running = false;
+	writer.join();
+
+	if (tornReads != 0) {
+		state.SkipWithError("SeqLock returned a torn value");
+	}
+	state.counters["torn_reads"] = static_cast<double>(tornReads);
+}
+BENCHMARK(BM_SeqLockLoadUnderContention);
+
+// Uncontended publish cost, which the serial dispatch thread pays for every packet
+static void BM_SeqLockStore(benchmark::State& state) {
+	SeqLock<StressValue_t> seqLock;
+	uint32_t value = 0;
+
+	for (auto _ : state) {
+		seqLock.Store(MakeStressValue(++value));
+	}
+	benchmark::DoNotOptimize(seqLock.Sequence());
+}
+BENCHMARK(BM_SeqLockStore);
@@ -0,0 +1,97 @@
+// Reads SeqLock snapshots from several threads while another publishes new ones as fast as it can, and fails if any read
+// is torn or goes back in time
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "seqlock.hpp"
+
+// Roughly the size of a glove input snapshot. Every field holds the same value, so a torn read is easy to spot
+struct StressValue_t {
+	uint32_t fields[24];
+};
+
+static constexpr size_t READER_COUNT = 3;
+static constexpr std::chrono::milliseconds STRESS_DURATION = std::chrono::milliseconds(500);
+
+struct ReaderResult_t {
+	uint64_t reads;
+	uint64_t tornReads;
+	uint64_t backwardReads;
+};
+
+static StressValue_t MakeStressValue(const uint32_t value) {
+	StressValue_t result;
+	for (uint32_t& field : result.fields) {
+		field = value;
+	}
+	return result;
+}
+
+// Checks a snapshot, counting it as torn if its fields disagree, or as backwards if it is older than the last one read
+static void CheckSnapshot(const StressValue_t& snapshot, uint32_t& lastValue, ReaderResult_t& result) {
+	result.reads++;
+	for (const uint32_t field : snapshot.fields) {
+		if (field != snapshot.fields[0]) {
+			result.tornReads++;
+			return;
+		}
+	}
+	if (snapshot.fields[0] < lastValue) {
+		result.backwardReads++;
+	}
+	lastValue = snapshot.fields[0];
+}
+
+int main() {
+	SeqLock<StressValue_t> seqLock;
+	std::atomic<bool> running = true;
+
+	std::thread writer([&]() {
+		uint32_t value = 0;
+		while (running.load(std::memory_order_relaxed)) {
+			seqLock.Store(MakeStressValue(++value));
+		}
+	});
+
+	// Readers alternate between Load, which retries until it gets a consistent copy, and TryLoad, which gives up instead
+	std::vector<ReaderResult_t> results(READER_COUNT, ReaderResult_t{});
+	std::vector<std::thread> readers;
+	for (size_t i = 0; i < READER_COUNT; i++) {
+		readers.emplace_back([&, i]() {
+			ReaderResult_t& result = results[i];
+			uint32_t lastValue = 0;
+			StressValue_t snapshot = {};
+			while (running.load(std::memory_order_relaxed)) {
+				if (i % 2 == 0) {
+					CheckSnapshot(seqLock.Load(), lastValue, result);
+				} else if (seqLock.TryLoad(snapshot)) {
+					CheckSnapshot(snapshot, lastValue, result);
+				}
+			}
+		});
+	}
+
+	std::this_thread::sleep_for(STRESS_DURATION);
+	running = false;
+	writer.join();
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+
+	bool passed = true;
+	for (size_t i = 0; i < READER_COUNT; i++) {
+		const ReaderResult_t& result = results[i];
+		printf("Reader %zu (%s): %llu reads, %llu torn, %llu backwards\n", i, i % 2 == 0 ? "Load" : "TryLoad",
+			static_cast<unsigned long long>(result.reads), static_cast<unsigned long long>(result.tornReads), static_cast<unsigned long long>(result.backwardReads));
+		passed &= result.reads > 0 && result.tornReads == 0 && result.backwardReads == 0;
+	}
+
+	if (!passed) {
+		printf("SeqLock returned a torn or out of order value\n");
+	}
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
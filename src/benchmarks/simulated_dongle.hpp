@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "cobs.hpp"
+#include "contact_glove_structs.hpp"
+#include "crc.hpp"
+
+/// <summary>
+/// What a SimulatedDongle sends. Rates are in packets per second per glove (or per dongle for status and versions), a
+/// rate of 0 disables that packet type.
+/// </summary>
+struct SimulatedDongleConfig_t {
+	// How many gloves are paired: 0 (dongle only), 1 (left only), or 2
+	uint32_t gloveCount			= 2;
+
+	double fingersRate			= 120.0;
+	double dataRate				= 120.0;
+	double imuRate				= 120.0;
+	double statusRate			= 1.0;
+	double versionsRate			= 1.0;
+	// Multiplies every rate above, to load test ingest beyond what a real dongle sends
+	double rateMultiplier		= 1.0;
+
+	// Peak to peak noise added to finger and joystick readings, in raw sensor units
+	uint16_t noise				= 8;
+	// Probability that a packet is never sent, like a glove briefly out of range
+	double dropoutProbability	= 0.0;
+	// Probability that a byte of a packet is flipped on the wire, which the CRC or COBS decoder should catch
+	double corruptProbability	= 0.0;
+
+	uint32_t seed				= 1;
+};
+
+/// <summary>
+/// Generates the byte stream a dongle sends: COBS encoded, CRC terminated frames for each glove's fingers, buttons and
+/// IMU, and the dongle's status and versions, each at its own rate.
+/// </summary>
+class SimulatedDongle {
+public:
+	explicit SimulatedDongle(const SimulatedDongleConfig_t& config)
+		: m_config(config), m_random(config.seed), m_framesSent(0), m_framesDropped(0), m_framesCorrupted(0) {
+		const uint8_t leftIds[]		= { GLOVE_LEFT_PACKET_FINGERS, GLOVE_LEFT_PACKET_DATA, GLOVE_LEFT_PACKET_IMU };
+		const uint8_t rightIds[]	= { GLOVE_RIGHT_PACKET_FINGERS, GLOVE_RIGHT_PACKET_DATA, GLOVE_RIGHT_PACKET_IMU };
+		const double gloveRates[]	= { config.fingersRate, config.dataRate, config.imuRate };
+
+		for (size_t i = 0; i < 3; i++) {
+			if (config.gloveCount >= 1) {
+				AddStream(leftIds[i], gloveRates[i]);
+			}
+			if (config.gloveCount >= 2) {
+				AddStream(rightIds[i], gloveRates[i]);
+			}
+		}
+		AddStream(DEVICES_STATUS, config.statusRate);
+		AddStream(DEVICES_VERSIONS, config.versionsRate);
+	}
+
+	// Appends every frame due up to elapsedNs since the dongle started to wire
+	void Generate(const uint64_t elapsedNs, std::vector<uint8_t>& wire) {
+		for (Stream_t& stream : m_streams) {
+			while (stream.nextDueNs <= elapsedNs) {
+				EmitFrame(stream.id, stream.nextDueNs, wire);
+				stream.nextDueNs += stream.intervalNs;
+			}
+		}
+	}
+
+	inline uint64_t FramesSent() const { return m_framesSent; }
+	inline uint64_t FramesDropped() const { return m_framesDropped; }
+	inline uint64_t FramesCorrupted() const { return m_framesCorrupted; }
+
+private:
+	struct Stream_t {
+		uint8_t id;
+		uint64_t intervalNs;
+		uint64_t nextDueNs;
+	};
+
+	void AddStream(const uint8_t id, const double rate) {
+		const double scaledRate = rate * m_config.rateMultiplier;
+		if (scaledRate <= 0.0) {
+			return;
+		}
+		const uint64_t intervalNs = static_cast<uint64_t>(1e9 / scaledRate);
+		m_streams.push_back({ id, intervalNs > 0 ? intervalNs : 1, 0 });
+	}
+
+	uint16_t Noisy(const double value) {
+		const double noise = m_config.noise == 0 ? 0.0 : std::uniform_real_distribution<double>(-0.5, 0.5)(m_random) * m_config.noise;
+		const double noisy = value + noise;
+		return static_cast<uint16_t>(noisy < 0.0 ? 0.0 : (noisy > 65535.0 ? 65535.0 : noisy));
+	}
+
+	template <typename T>
+	static void WriteUnaligned(uint8_t* pData, const T value) {
+		memcpy(pData, &value, sizeof(T));
+	}
+
+	// Builds the decoded frame (packet id, payload and CRC byte), returning its length
+	size_t BuildFrame(const uint8_t id, const uint64_t timeNs, uint8_t* frame) {
+		const double seconds = static_cast<double>(timeNs) * 1e-9;
+		size_t length = 0;
+
+		frame[0] = id;
+		switch (id) {
+			case GLOVE_LEFT_PACKET_FINGERS:
+			case GLOVE_RIGHT_PACKET_FINGERS: {
+				// Slowly open and close the hand, every joint a little out of phase
+				for (size_t joint = 0; joint < 10; joint++) {
+					const double curl = 0.5 + 0.5 * std::sin(seconds * 2.0 + static_cast<double>(joint) * 0.3);
+					WriteUnaligned<uint16_t>(&frame[1 + joint * sizeof(uint16_t)], Noisy(1500.0 + curl * 400.0));
+				}
+				length = 21;
+				break;
+			}
+			case GLOVE_LEFT_PACKET_DATA:
+			case GLOVE_RIGHT_PACKET_DATA: {
+				// Magnetra present, no buttons held, joystick near its centre
+				frame[1] = 0x3F;
+				WriteUnaligned<uint16_t>(&frame[2], Noisy(144.0));
+				WriteUnaligned<uint16_t>(&frame[4], Noisy(137.0));
+				length = 6;
+				break;
+			}
+			case GLOVE_LEFT_PACKET_IMU:
+			case GLOVE_RIGHT_PACKET_IMU: {
+				for (size_t axis = 0; axis < 4; axis++) {
+					const double rotation = std::sin(seconds * 3.0 + static_cast<double>(axis));
+					WriteUnaligned<uint16_t>(&frame[1 + axis * sizeof(uint16_t)], Noisy(32768.0 + rotation * 16384.0));
+				}
+				length = 9;
+				break;
+			}
+			case DEVICES_STATUS: {
+				frame[1] = m_config.gloveCount >= 1 ? 98 : CONTACT_GLOVE_INVALID_BATTERY;
+				frame[2] = 0x5F;
+				frame[3] = m_config.gloveCount >= 2 ? 92 : CONTACT_GLOVE_INVALID_BATTERY;
+				frame[4] = 0x5F;
+				frame[5] = 0x01;
+				length = 6;
+				break;
+			}
+			case DEVICES_VERSIONS: {
+				const uint8_t versions[] = { 0x01, 0x06, 0x01, 0x06, 0x01, 0x06 };
+				memcpy(&frame[1], versions, sizeof(versions));
+				length = 7;
+				break;
+			}
+			default:
+				length = 1;
+				break;
+		}
+
+		frame[length] = F_CRC_CalculateCheckSum(frame, length);
+		return length + 1;
+	}
+
+	void EmitFrame(const uint8_t id, const uint64_t timeNs, std::vector<uint8_t>& wire) {
+		std::uniform_real_distribution<double> chance(0.0, 1.0);
+
+		if (m_config.dropoutProbability > 0.0 && chance(m_random) < m_config.dropoutProbability) {
+			m_framesDropped++;
+			return;
+		}
+
+		uint8_t frame[cobs::MAX_DECODED_SIZE] = {};
+		uint8_t encoded[cobs::MAX_DECODED_SIZE + 2] = {};
+		const size_t length = BuildFrame(id, timeNs, frame);
+		cobs::encode(frame, static_cast<uint32_t>(length), encoded);
+
+		// Encoding adds a single overhead byte, the delimiter follows
+		const size_t encodedLength = length + 1;
+		if (m_config.corruptProbability > 0.0 && chance(m_random) < m_config.corruptProbability) {
+			const size_t index = std::uniform_int_distribution<size_t>(0, encodedLength - 1)(m_random);
+			encoded[index] ^= static_cast<uint8_t>(1u << std::uniform_int_distribution<uint32_t>(0, 7)(m_random));
+			m_framesCorrupted++;
+		}
+
+		wire.insert(wire.end(), encoded, encoded + encodedLength);
+		wire.push_back(0x00);
+		m_framesSent++;
+	}
+
+private:
+	SimulatedDongleConfig_t m_config;
+	std::vector<Stream_t> m_streams;
+	std::mt19937 m_random;
+
+	uint64_t m_framesSent;
+	uint64_t m_framesDropped;
+	uint64_t m_framesCorrupted;
+};
@@ -0,0 +1,49 @@
+#include "glove_sample.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define GLOVE_SAMPLE_SSE2
+#endif
+
+namespace protocol {
+
+#ifdef GLOVE_SAMPLE_SSE2
+	// The first 8 joints go through SSE2, the last 2 are done like the scalar path
+	constexpr int GLOVE_SAMPLE_SIMD_JOINTS = 8;
+#else
+	constexpr int GLOVE_SAMPLE_SIMD_JOINTS = 0;
+#endif
+
+	void PackGloveJoints(const float (&joints)[GloveJoint_Count], int16_t (&outJoints)[GloveJoint_Count]) {
+#ifdef GLOVE_SAMPLE_SSE2
+		const __m128 scale	= _mm_set1_ps(GLOVE_SAMPLE_Q15_SCALE);
+		const __m128 lower	= _mm_set1_ps(-1.0f);
+		const __m128 upper	= _mm_set1_ps(1.0f);
+
+		const __m128 low	= _mm_min_ps(_mm_max_ps(_mm_loadu_ps(joints), lower), upper);
+		const __m128 high	= _mm_min_ps(_mm_max_ps(_mm_loadu_ps(joints + 4), lower), upper);
+		// Rounds to nearest, and the clamp keeps the pack from saturating
+		const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(low, scale)), _mm_cvtps_epi32(_mm_mul_ps(high, scale)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(outJoints), packed);
+#endif
+		for (int i = GLOVE_SAMPLE_SIMD_JOINTS; i < GloveJoint_Count; i++) {
+			outJoints[i] = QuantiseGloveAxis(joints[i]);
+		}
+	}
+
+	void UnpackGloveJoints(const int16_t (&joints)[GloveJoint_Count], float (&outJoints)[GloveJoint_Count]) {
+#ifdef GLOVE_SAMPLE_SSE2
+		const __m128 scale	= _mm_set1_ps(1.0f / GLOVE_SAMPLE_Q15_SCALE);
+
+		const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(joints));
+		// Sign extend each half to 32 bits, by putting the value in the top half of each lane and shifting it down
+		const __m128i low	= _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+		const __m128i high	= _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+		_mm_storeu_ps(outJoints, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+		_mm_storeu_ps(outJoints + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+#endif
+		for (int i = GLOVE_SAMPLE_SIMD_JOINTS; i < GloveJoint_Count; i++) {
+			outJoints[i] = DequantiseGloveAxis(joints[i]);
+		}
+	}
+}
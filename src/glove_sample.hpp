@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace protocol {
+
+	// Joints in GloveSample_t::joints
+	enum GloveJoint_t {
+		GloveJointThumbRoot,
+		GloveJointThumbTip,
+		GloveJointIndexRoot,
+		GloveJointIndexTip,
+		GloveJointMiddleRoot,
+		GloveJointMiddleTip,
+		GloveJointRingRoot,
+		GloveJointRingTip,
+		GloveJointPinkyRoot,
+		GloveJointPinkyTip,
+		GloveJoint_Count,
+	};
+
+	// Bits of GloveSample_t::buttons
+	enum GloveButton_t : uint16_t {
+		GloveButtonMagnetra			= 1 << 0, // Not a button, set if the Magnetra (and so the buttons and joystick) is present
+		GloveButtonSystemUp			= 1 << 1,
+		GloveButtonSystemDown		= 1 << 2,
+		GloveButtonUp				= 1 << 3,
+		GloveButtonDown				= 1 << 4,
+		GloveButtonJoystickClick	= 1 << 5,
+	};
+
+	/// <summary>
+	/// A glove's processed sensor data, quantised to 32 bytes to keep the state sent to the driver small. Joint curls and
+	/// joystick axes are in [-1, 1], stored as signed Q15 fixed point (see PackGloveJoints and QuantiseGloveAxis).
+	/// </summary>
+	struct GloveSample_t {
+		int16_t joints[GloveJoint_Count];
+		// X then Y, with the deadzone applied
+		int16_t joystick[2];
+		uint16_t buttons;
+		// Percent, or GLOVE_BATTERY_INVALID
+		uint8_t battery;
+		uint8_t reserved;
+		// When the newest data in the sample was received from the dongle, see GloveSampleTimestamp. 0 if never
+		uint32_t timestamp;
+	};
+	static_assert(sizeof(GloveSample_t) == 32, "GloveSample_t is laid out explicitly, without padding");
+
+	constexpr float GLOVE_SAMPLE_Q15_SCALE = 32767.0f;
+
+	// Quantises joint curls to Q15, clamping them to [-1, 1]
+	void PackGloveJoints(const float (&joints)[GloveJoint_Count], int16_t (&outJoints)[GloveJoint_Count]);
+	void UnpackGloveJoints(const int16_t (&joints)[GloveJoint_Count], float (&outJoints)[GloveJoint_Count]);
+
+	inline int16_t QuantiseGloveAxis(const float value) {
+		const float clamped = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+		const float scaled = clamped * GLOVE_SAMPLE_Q15_SCALE;
+		return static_cast<int16_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+	}
+
+	inline float DequantiseGloveAxis(const int16_t value) {
+		return value * (1.0f / GLOVE_SAMPLE_Q15_SCALE);
+	}
+
+	// Sample timestamps are the low 32 bits of MonotonicTimestamp in microseconds, which wrap about every 71 minutes
+	inline uint32_t GloveSampleTimestamp(const uint64_t monotonicTimestamp) {
+		return monotonicTimestamp == 0 ? 0 : static_cast<uint32_t>(monotonicTimestamp / 1000);
+	}
+
+	// Back to a MonotonicTimestamp, for a sample taken less than a wrap before now
+	inline uint64_t ExpandGloveSampleTimestamp(const uint32_t timestamp, const uint64_t now) {
+		if (timestamp == 0) {
+			return 0;
+		}
+		const uint32_t age = static_cast<uint32_t>(now / 1000) - timestamp;
+		const uint64_t ageNs = static_cast<uint64_t>(age) * 1000;
+		return ageNs > now ? 0 : now - ageNs;
+	}
+}
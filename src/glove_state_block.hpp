@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "ipc_protocol.hpp"
+#include "seqlock.hpp"
+
+// Name of the shared memory block glove state is published to, see SharedMemoryRegion
+#define FREESCUBA_GLOVE_STATE_NAME "FreeScubaGloveState"
+
+/// <summary>
+/// Layout of the glove state shared memory block, which carries glove updates from the overlay to the driver instead of
+/// the pipe. The driver creates it, the overlay's UI thread is the only writer, and the driver polls each glove's
+/// SeqLock once per frame, so neither side makes a syscall or waits on the other to hand over a glove's state.
+/// </summary>
+struct GloveStateBlock_t {
+	// Checked by the overlay before publishing, a mismatch means the driver is a different build
+	uint32_t version;
+
+	// Indexed by glove pair, then by protocol::GloveDevice_t. Each glove has a SeqLock of its own, as the overlay stores
+	// each glove's state once it has processed that glove's packets
+	SeqLock<protocol::ContactGloveState_t> gloves[protocol::MAX_GLOVE_PAIRS][2];
+	// Only stored when a glove's calibration changes
+	SeqLock<protocol::GloveCalibration_t> calibrations[protocol::MAX_GLOVE_PAIRS][2];
+};
@@ -0,0 +1,97 @@
+#include "glove_state_delta.hpp"
+
+#include <cstring>
+#include <utility>
+
+struct GloveStateField_t {
+	uint16_t offset;
+	uint16_t size;
+};
+
+#define GLOVE_STATE_FIELD(member) { offsetof(protocol::ContactGloveState_t, member), sizeof(std::declval<protocol::ContactGloveState_t&>().member) }
+
+// Fields are compared and sent whole
+static constexpr GloveStateField_t GLOVE_STATE_FIELDS[] = {
+	GLOVE_STATE_FIELD(isConnected),
+	GLOVE_STATE_FIELD(ignorePose),
+	GLOVE_STATE_FIELD(useCurl),
+	GLOVE_STATE_FIELD(trackerIndex),
+
+	GLOVE_STATE_FIELD(imuTimestamp),
+	GLOVE_STATE_FIELD(imuRotation),
+
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointThumbRoot]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointThumbTip]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointIndexRoot]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointIndexTip]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointMiddleRoot]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointMiddleTip]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointRingRoot]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointRingTip]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointPinkyRoot]),
+	GLOVE_STATE_FIELD(sample.joints[protocol::GloveJointPinkyTip]),
+	GLOVE_STATE_FIELD(sample.joystick),
+	GLOVE_STATE_FIELD(sample.buttons),
+	GLOVE_STATE_FIELD(sample.battery),
+	GLOVE_STATE_FIELD(sample.timestamp),
+};
+
+#undef GLOVE_STATE_FIELD
+
+static constexpr size_t GLOVE_STATE_FIELD_COUNT = sizeof(GLOVE_STATE_FIELDS) / sizeof(GLOVE_STATE_FIELDS[0]);
+static_assert(GLOVE_STATE_FIELD_COUNT <= 64, "Every glove state field needs a bit in GloveStateDelta_t::fieldMask");
+
+static constexpr uint64_t GLOVE_STATE_ALL_FIELDS = GLOVE_STATE_FIELD_COUNT == 64 ? ~0ull : (1ull << GLOVE_STATE_FIELD_COUNT) - 1;
+
+void EncodeGloveStateDelta(
+	const protocol::ContactGloveState_t& previous,
+	const protocol::ContactGloveState_t& current,
+	const bool keyframe,
+	protocol::GloveStateDelta_t& outDelta) {
+
+	const uint8_t* previousBytes = reinterpret_cast<const uint8_t*>(&previous);
+	const uint8_t* currentBytes = reinterpret_cast<const uint8_t*>(&current);
+
+	outDelta.fieldMask = 0;
+	outDelta.keyframe = keyframe;
+	outDelta.size = 0;
+
+	for (size_t i = 0; i < GLOVE_STATE_FIELD_COUNT; i++) {
+		const GloveStateField_t& field = GLOVE_STATE_FIELDS[i];
+		if (!keyframe && memcmp(previousBytes + field.offset, currentBytes + field.offset, field.size) == 0) {
+			continue;
+		}
+
+		memcpy(outDelta.data + outDelta.size, currentBytes + field.offset, field.size);
+		outDelta.size += field.size;
+		outDelta.fieldMask |= 1ull << i;
+	}
+}
+
+bool ApplyGloveStateDelta(const protocol::GloveStateDelta_t& delta, protocol::ContactGloveState_t& state) {
+	if ((delta.fieldMask & ~GLOVE_STATE_ALL_FIELDS) != 0 || (delta.keyframe && delta.fieldMask != GLOVE_STATE_ALL_FIELDS)) {
+		return false;
+	}
+
+	size_t size = 0;
+	for (size_t i = 0; i < GLOVE_STATE_FIELD_COUNT; i++) {
+		if (delta.fieldMask & (1ull << i)) {
+			size += GLOVE_STATE_FIELDS[i].size;
+		}
+	}
+	if (size != delta.size) {
+		return false;
+	}
+
+	uint8_t* stateBytes = reinterpret_cast<uint8_t*>(&state);
+	size_t offset = 0;
+	for (size_t i = 0; i < GLOVE_STATE_FIELD_COUNT; i++) {
+		if (delta.fieldMask & (1ull << i)) {
+			const GloveStateField_t& field = GLOVE_STATE_FIELDS[i];
+			memcpy(stateBytes + field.offset, delta.data + offset, field.size);
+			offset += field.size;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ipc_protocol.hpp"
+
+// Every this many updates of a glove the full state is sent, so the driver resyncs even if it missed a delta
+constexpr uint32_t GLOVE_STATE_KEYFRAME_INTERVAL = 90;
+
+// Writes the fields of current which differ from previous to outDelta, or every field if keyframe is set
+void EncodeGloveStateDelta(
+	const protocol::ContactGloveState_t& previous,
+	const protocol::ContactGloveState_t& current,
+	const bool keyframe,
+	protocol::GloveStateDelta_t& outDelta);
+
+// Overwrites the fields delta carries in state, leaving the rest as they were. Returns false, without touching state, if
+// the delta is malformed
+bool ApplyGloveStateDelta(const protocol::GloveStateDelta_t& delta, protocol::ContactGloveState_t& state);
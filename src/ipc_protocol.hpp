@@ -1,8 +1,12 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
+#include "glove_sample.hpp"
+#include "timestamp.hpp"
 
-#define FREESCUBA_PIPE_NAME "\\\\.\\pipe\\FreeScubaDriver"
+// Name of the driver's IPC endpoint, which each transport maps to a named pipe or socket, see ipc_transport.hpp
+#define FREESCUBA_IPC_NAME "FreeScubaDriver"
 constexpr uint32_t CONTACT_GLOVE_INVALID_DEVICE_ID = 0xFFFFFFFF;
 
 #ifndef _OPENVR_DRIVER_API
@@ -79,7 +83,7 @@ namespace vr {
 #endif
 
 namespace protocol {
-	const uint32_t Version = 1;
+	const uint32_t Version = 10;
 
 	enum RequestType_t
 	{
@@ -87,8 +91,11 @@ namespace protocol {
 		RequestHandshake,
 		RequestUpdateGloveLeftState,
 		RequestUpdateGloveRightState,
+		RequestUpdateGloveLeftCalibration,
+		RequestUpdateGloveRightCalibration,
 		// Haptics?
 		RequestDevicePose,
+		RequestSubscribePoses,
 	};
 
 	enum ResponseType_t
@@ -97,6 +104,7 @@ namespace protocol {
 		ResponseHandshake,
 		ResponseSuccess,
 		ResponseDevicePose,
+		ResponseGloveUpdateAck,
 	};
 
 	enum GloveDevice_t {
@@ -105,13 +113,37 @@ namespace protocol {
 		Dongle,
 	};
 
+	// Most pairs of gloves (one pair per dongle) the driver exposes to SteamVR
+	constexpr uint32_t MAX_GLOVE_PAIRS = 4;
+
 	struct Protocol_t
 	{
 		uint32_t version = Version;
 	};
 
+	// Response to a glove update which asked for one, covering every update received on the connection so far
+	struct GloveUpdateAck_t
+	{
+		uint32_t lastSequence;
+		uint32_t received;
+		uint32_t lost;
+	};
+
+	constexpr uint32_t POSE_SUBSCRIPTION_MAX_DEVICES = 4;
+
+	// Asks the driver to push the poses of these devices to the pose stream block (see pose_stream_block.hpp). Replaces
+	// any previous subscription, a deviceCount of 0 stops the stream
+	struct PoseSubscription_t
+	{
+		uint32_t deviceIndices[POSE_SUBSCRIPTION_MAX_DEVICES];
+		uint32_t deviceCount;
+		// Most poses pushed per second for each device, 0 pushes every pose update
+		uint32_t rateHz;
+	};
+
 	constexpr uint8_t GLOVE_BATTERY_INVALID = 0xFF;
 
+	// A glove's state as the driver sees it, sent every frame. The overlay keeps the raw and unquantised values
 	struct ContactGloveState_t {
 
 		bool isConnected = false;
@@ -119,47 +151,15 @@ namespace protocol {
 		bool useCurl = false;
 		uint32_t trackerIndex = CONTACT_GLOVE_INVALID_DEVICE_ID;
 
-		uint16_t thumbRootRaw;
-		uint16_t thumbTipRaw;
-		uint16_t indexRootRaw;
-		uint16_t indexTipRaw;
-		uint16_t middleRootRaw;
-		uint16_t middleTipRaw;
-		uint16_t ringRootRaw;
-		uint16_t ringTipRaw;
-		uint16_t pinkyRootRaw;
-		uint16_t pinkyTipRaw;
-
-		float thumbRoot;
-		float thumbTip;
-		float indexRoot;
-		float indexTip;
-		float middleRoot;
-		float middleTip;
-		float ringRoot;
-		float ringTip;
-		float pinkyRoot;
-		float pinkyTip;
-
-		bool hasMagnetra;
-		bool systemUp;
-		bool systemDown;
-		bool buttonUp;
-		bool buttonDown;
-		bool joystickClick;
-		uint16_t joystickXRaw;
-		uint16_t joystickYRaw;
-		float joystickX;
-		float joystickY;
-		// No deadzone
-		float joystickXUnfiltered;
-		float joystickYUnfiltered;
-
-		uint8_t gloveBatteryRaw;
-		uint8_t gloveBattery;
-
-		uint8_t firmwareMajor;
-		uint8_t firmwareMinor;
+		// When the latest IMU packet was received from the dongle, see MonotonicTimestamp
+		uint64_t imuTimestamp = 0;
+		// Orientation reported by the glove's IMU, in the IMU's own frame. Only meaningful once imuTimestamp is set
+		vr::HmdQuaternion_t imuRotation;
+
+		// Fingers, buttons, joystick and battery
+		GloveSample_t sample;
+
+		// Calibration isn't part of the per frame state, it is sent separately as a GloveCalibration_t when it changes
 
 		// Calibration for a single joint on the fingers
 		struct FingerJointCalibrationData_t {
@@ -225,22 +225,59 @@ namespace protocol {
 				GestureThreshold_t grip;
 			} gestures;
 			
-		} calibration;
+		};
+	};
+
+	// A glove's calibration. Sent only when it changes, the driver caches it and rebuilds what it derives from it when the
+	// generation changes
+	struct GloveCalibration_t
+	{
+		uint32_t generation;
+		ContactGloveState_t::CalibrationData_t calibration;
+	};
+
+	// A glove update as the fields which changed since the previous update of the same glove, see glove_state_delta.hpp.
+	// Only the first size bytes of data go over the pipe
+	struct GloveStateDelta_t
+	{
+		// Bit i is set if field i of ContactGloveState_t (in declaration order) follows in data
+		uint64_t fieldMask;
+		// Carries every field, so it can be applied without having seen the updates before it
+		bool keyframe;
+		uint16_t size;
+		uint8_t data[sizeof(ContactGloveState_t)];
 	};
 
 	struct Request_t
 	{
 		RequestType_t type;
+		// Glove updates are one way, the driver only responds to them (with ResponseGloveUpdateAck) if ackRequested is
+		// set. They are numbered by the client, so the driver can count any which went missing
+		uint32_t sequence;
+		bool ackRequested;
+		// Which pair of gloves a glove update or calibration is for, below MAX_GLOVE_PAIRS
+		uint8_t glovePair;
 
 		union {
-			ContactGloveState_t gloveData;
+			GloveStateDelta_t gloveDelta;
+			GloveCalibration_t gloveCalibration;
+			PoseSubscription_t poseSubscription;
 			uint32_t driverPoseIndex;
 		};
 
-		Request_t()												: type(RequestType_t::RequestInvalid), gloveData{} { }
-		Request_t(RequestType_t type)							: type(type), gloveData{} { }
-		Request_t(ContactGloveState_t params, bool leftHand)	: type(leftHand ? RequestType_t::RequestUpdateGloveLeftState : RequestType_t::RequestUpdateGloveRightState), gloveData(params) {}
-		Request_t(uint32_t driverPoseIndex)						: type(RequestType_t::RequestDevicePose),	driverPoseIndex(driverPoseIndex) {}
+		Request_t()												: type(RequestType_t::RequestInvalid), sequence(0), ackRequested(false), glovePair(0), gloveDelta{} { }
+		Request_t(RequestType_t type)							: type(type), sequence(0), ackRequested(false), glovePair(0), gloveDelta{} { }
+		Request_t(uint32_t driverPoseIndex)						: type(RequestType_t::RequestDevicePose), sequence(0), ackRequested(false), glovePair(0), driverPoseIndex(driverPoseIndex) {}
+		Request_t(PoseSubscription_t params)					: type(RequestType_t::RequestSubscribePoses), sequence(0), ackRequested(false), glovePair(0), poseSubscription(params) {}
+		Request_t(GloveCalibration_t params, uint8_t glovePair, bool leftHand)	: type(leftHand ? RequestType_t::RequestUpdateGloveLeftCalibration : RequestType_t::RequestUpdateGloveRightCalibration), sequence(0), ackRequested(false), glovePair(glovePair), gloveCalibration(params) {}
+
+		// Bytes of the request which go over the pipe, glove updates stop after the fields their delta carries
+		size_t WireSize() const {
+			if (type == RequestUpdateGloveLeftState || type == RequestUpdateGloveRightState) {
+				return offsetof(Request_t, gloveDelta) + offsetof(GloveStateDelta_t, data) + gloveDelta.size;
+			}
+			return sizeof(Request_t);
+		}
 	};
 
 	struct Response_t
@@ -250,6 +287,7 @@ namespace protocol {
 		union {
 			Protocol_t protocol;
 			vr::DriverPose_t driverPose;
+			GloveUpdateAck_t gloveUpdateAck;
 		};
 
 		Response_t()											: type(ResponseType_t::ResponseInvalid), protocol{} { }
@@ -0,0 +1,64 @@
+#include "ipc_request_dispatch.hpp"
+
+IPCRequestStatus DispatchIPCRequest(IIPCDriver& driver, IPCConnection_t& connection) {
+	switch (connection.request.type) {
+	case protocol::RequestHandshake:
+		connection.response.type = protocol::ResponseHandshake;
+		connection.response.protocol.version = protocol::Version;
+		break;
+	case protocol::RequestDevicePose:
+		connection.response.type = protocol::ResponseDevicePose;
+		connection.response.driverPose = driver.GetCachedPose(connection.request.driverPoseIndex);
+		break;
+	case protocol::RequestSubscribePoses:
+		connection.response.type = driver.SubscribePoses(connection.request.poseSubscription) ? protocol::ResponseSuccess : protocol::ResponseInvalid;
+		break;
+	case protocol::RequestUpdateGloveLeftState:
+	case protocol::RequestUpdateGloveRightState:
+		// Deltas only send the fields which changed, so anything shorter than its header says is malformed
+		if (connection.readBuffer.dataSize < connection.request.WireSize()) {
+			connection.writeBuffer.dataSize = 0;
+			return IPCRequestStatus::Truncated;
+		}
+		if (connection.request.glovePair >= protocol::MAX_GLOVE_PAIRS) {
+			connection.writeBuffer.dataSize = 0;
+			return IPCRequestStatus::UnknownGlovePair;
+		}
+		driver.HandleGloveUpdate(connection.request.gloveDelta, connection.request.glovePair, connection.request.type == protocol::RequestUpdateGloveLeftState);
+
+		// Connections don't drop messages, so a gap means the overlay skipped some
+		if (connection.updatesReceived != 0 && connection.request.sequence > connection.lastUpdateSequence + 1) {
+			connection.updatesLost += connection.request.sequence - connection.lastUpdateSequence - 1;
+		}
+		connection.lastUpdateSequence = connection.request.sequence;
+		connection.updatesReceived++;
+
+		// One way, unless the overlay asked for an ack
+		if (!connection.request.ackRequested) {
+			connection.writeBuffer.dataSize = 0;
+			return IPCRequestStatus::Handled;
+		}
+		connection.response.type = protocol::ResponseGloveUpdateAck;
+		connection.response.gloveUpdateAck.lastSequence	= connection.lastUpdateSequence;
+		connection.response.gloveUpdateAck.received		= connection.updatesReceived;
+		connection.response.gloveUpdateAck.lost			= connection.updatesLost;
+		break;
+
+	case protocol::RequestUpdateGloveLeftCalibration:
+	case protocol::RequestUpdateGloveRightCalibration:
+		// One way
+		connection.writeBuffer.dataSize = 0;
+		if (connection.request.glovePair >= protocol::MAX_GLOVE_PAIRS) {
+			return IPCRequestStatus::UnknownGlovePair;
+		}
+		driver.HandleGloveCalibration(connection.request.gloveCalibration, connection.request.glovePair, connection.request.type == protocol::RequestUpdateGloveLeftCalibration);
+		return IPCRequestStatus::Handled;
+
+	default:
+		connection.response.type = protocol::ResponseInvalid;
+		connection.writeBuffer.dataSize = sizeof(protocol::Response_t);
+		return IPCRequestStatus::UnknownType;
+	}
+	connection.writeBuffer.dataSize = sizeof(protocol::Response_t);
+	return IPCRequestStatus::Handled;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ipc_transport.hpp"
+
+/// <summary>
+/// What answering the overlay's requests needs from the driver. The driver's DeviceProvider implements it, and the IPC
+/// benchmarks stand in for it, so both answer requests through the same DispatchIPCRequest.
+/// </summary>
+class IIPCDriver {
+public:
+	virtual ~IIPCDriver() = default;
+
+	virtual vr::DriverPose_t GetCachedPose(uint32_t trackedDeviceIndex) = 0;
+	// Replaces the previous pose subscription. Returns false if the subscription is invalid
+	virtual bool SubscribePoses(const protocol::PoseSubscription_t& subscription) = 0;
+	// glovePair is always below protocol::MAX_GLOVE_PAIRS
+	virtual void HandleGloveUpdate(const protocol::GloveStateDelta_t& delta, uint32_t glovePair, bool isLeft) = 0;
+	virtual void HandleGloveCalibration(const protocol::GloveCalibration_t& calibration, uint32_t glovePair, bool isLeft) = 0;
+};
+
+// Why a request was turned down, for the caller to log
+enum class IPCRequestStatus {
+	Handled,
+	// A glove update shorter than its header says
+	Truncated,
+	// A glove update or calibration for a glove pair beyond protocol::MAX_GLOVE_PAIRS
+	UnknownGlovePair,
+	// A request type this protocol version doesn't have, answered with protocol::ResponseInvalid
+	UnknownType,
+};
+
+/// <summary>
+/// Answers the request in connection's read buffer, leaving the response in its write buffer, and counts the glove
+/// updates the overlay skipped. Requests which are turned down are answered as the protocol says and never reach driver.
+/// </summary>
+IPCRequestStatus DispatchIPCRequest(IIPCDriver& driver, IPCConnection_t& connection);
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "ipc_protocol.hpp"
+
+// Largest message either side sends, requests and responses both fit
+constexpr size_t IPC_BUFFER_SIZE = 4096;
+static_assert(sizeof(protocol::Request_t) <= IPC_BUFFER_SIZE && sizeof(protocol::Response_t) <= IPC_BUFFER_SIZE, "IPC messages must fit in a buffer");
+
+struct IPCBuffer_t {
+	uint8_t data[IPC_BUFFER_SIZE];
+	uint64_t dataSize;
+};
+
+/// <summary>
+/// A client's connection, as the server sees it. The transport reads each request into readBuffer, the request handler
+/// leaves the response in writeBuffer, and the transport writes it back. A writeBuffer.dataSize of 0 means the request
+/// was one way, and nothing is written.
+/// </summary>
+struct IPCConnection_t {
+	IPCConnection_t() : readBuffer{}, writeBuffer{}, lastUpdateSequence(0), updatesReceived(0), updatesLost(0) {}
+
+	union {
+		IPCBuffer_t readBuffer;
+		protocol::Request_t request;
+	};
+	union {
+		IPCBuffer_t writeBuffer;
+		protocol::Response_t response;
+	};
+
+	// Glove updates received on this connection, to spot gaps in their sequence numbers
+	uint32_t lastUpdateSequence;
+	uint32_t updatesReceived;
+	uint32_t updatesLost;
+};
+
+/// <summary>
+/// Answers requests for a server transport. Every call is made from the thread running IIPCServerTransport::Run, so
+/// requests are handled one at a time, whichever client they came from.
+/// </summary>
+class IIPCRequestHandler {
+public:
+	virtual ~IIPCRequestHandler() = default;
+
+	virtual void OnConnected(IPCConnection_t& connection) = 0;
+	// The connection is freed once this returns
+	virtual void OnDisconnected(IPCConnection_t& connection) = 0;
+	virtual void HandleRequest(IPCConnection_t& connection) = 0;
+};
+
+/// <summary>
+/// Platform specific end of the driver's IPC server, which accepts any number of clients and passes their requests to a
+/// handler. Every message is a whole request or response, so the protocol is the same on every platform.
+/// </summary>
+class IIPCServerTransport {
+public:
+	virtual ~IIPCServerTransport() = default;
+
+	// Starts accepting clients on the named endpoint, e.g. FREESCUBA_IPC_NAME. Returns false on failure
+	virtual bool Listen(const std::string& name) = 0;
+
+	/// <summary>
+	/// Services every client from the calling thread, passing their requests to handler, until Interrupt is called.
+	/// Clients which error are disconnected. Returns false if the transport itself failed.
+	/// </summary>
+	virtual bool Run(IIPCRequestHandler& handler) = 0;
+
+	// Makes Run return, from any thread
+	virtual void Interrupt() = 0;
+
+	// Description of the last OS error, for logging
+	virtual std::string LastError() const = 0;
+};
+
+/// <summary>
+/// Platform specific end of a client's connection to the driver's IPC server. Reads and writes are whole messages, and
+/// block until they complete.
+/// </summary>
+class IIPCClientTransport {
+public:
+	virtual ~IIPCClientTransport() = default;
+
+	// Connects to the server listening on the named endpoint, waiting up to timeoutMs if it is busy. Returns false on failure
+	virtual bool Connect(const std::string& name, const uint32_t timeoutMs) = 0;
+	virtual void Close() = 0;
+
+	virtual bool Write(const void* buffer, const size_t size) = 0;
+	// Waits for the next message. A message larger than size is truncated, outRead is what was read
+	virtual bool Read(void* buffer, const size_t size, size_t& outRead) = 0;
+	// Whether a message has arrived, so Read won't wait
+	virtual bool Available() = 0;
+
+	// Description of the last OS error, for logging
+	virtual std::string LastError() const = 0;
+};
+
+// Creates the transports for the platform we're running on
+std::unique_ptr<IIPCServerTransport> CreateIPCServerTransport();
+std::unique_ptr<IIPCClientTransport> CreateIPCClientTransport();
@@ -0,0 +1,347 @@
+#ifdef __linux__
+
+#include "ipc_transport_posix.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Most events taken from each epoll_wait
+static const int MAX_EVENTS                 = 64;
+// Most requests handled from one client before moving on to the next, so a client streaming glove updates can't starve
+// the rest. epoll is level triggered, so whatever is left is picked up on the next wait
+static const int MAX_REQUESTS_PER_CLIENT    = 16;
+
+std::unique_ptr<IIPCServerTransport> CreateIPCServerTransport() {
+	return std::make_unique<PosixIPCServerTransport>();
+}
+
+std::unique_ptr<IIPCClientTransport> CreateIPCClientTransport() {
+	return std::make_unique<PosixIPCClientTransport>();
+}
+
+// Sockets live in the abstract namespace, so there is no socket file to clean up if the driver dies
+static socklen_t SocketAddress(const std::string& name, sockaddr_un& outAddress) {
+	memset(&outAddress, 0, sizeof(outAddress));
+	outAddress.sun_family = AF_UNIX;
+
+	const size_t length = std::min(name.size(), sizeof(outAddress.sun_path) - 1);
+	memcpy(outAddress.sun_path + 1, name.data(), length);
+	return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + length);
+}
+
+static std::string ErrnoString() {
+	if (errno == 0) {
+		return std::string();
+	}
+	return std::to_string(errno) + ": " + strerror(errno);
+}
+
+PosixIPCServerTransport::PosixIPCServerTransport()
+	: m_listenFd(-1), m_epollFd(-1), m_wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), m_stop(false), m_clients() {}
+
+PosixIPCServerTransport::~PosixIPCServerTransport() {
+	// Only left over if Run never got to close them
+	for (SocketInstance* client : m_clients) {
+		close(client->fd);
+		delete client;
+	}
+
+	if (m_listenFd >= 0) {
+		close(m_listenFd);
+	}
+	if (m_epollFd >= 0) {
+		close(m_epollFd);
+	}
+	if (m_wakeFd >= 0) {
+		close(m_wakeFd);
+	}
+}
+
+bool PosixIPCServerTransport::Listen(const std::string& name) {
+	if (m_wakeFd < 0) {
+		return false;
+	}
+
+	m_listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (m_listenFd < 0) {
+		return false;
+	}
+
+	sockaddr_un address;
+	const socklen_t addressLength = SocketAddress(name, address);
+	if (bind(m_listenFd, reinterpret_cast<const sockaddr*>(&address), addressLength) != 0 || listen(m_listenFd, SOMAXCONN) != 0) {
+		return false;
+	}
+
+	m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (m_epollFd < 0) {
+		return false;
+	}
+
+	// Clients are told apart from these by their data pointer
+	epoll_event listenEvent = {};
+	listenEvent.events = EPOLLIN;
+	listenEvent.data.ptr = &m_listenFd;
+	epoll_event wakeEvent = {};
+	wakeEvent.events = EPOLLIN;
+	wakeEvent.data.ptr = &m_wakeFd;
+
+	return epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &listenEvent) == 0
+		&& epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wakeEvent) == 0;
+}
+
+bool PosixIPCServerTransport::Run(IIPCRequestHandler& handler) {
+	epoll_event events[MAX_EVENTS];
+	bool succeeded = true;
+
+	while (succeeded && !m_stop) {
+		const int count = epoll_wait(m_epollFd, events, MAX_EVENTS, -1);
+		if (count < 0) {
+			succeeded = errno == EINTR;
+			continue;
+		}
+
+		for (int i = 0; i < count && succeeded; i++) {
+			void* source = events[i].data.ptr;
+			if (source == &m_wakeFd) {
+				uint64_t wakes;
+				(void)read(m_wakeFd, &wakes, sizeof(wakes));
+			} else if (source == &m_listenFd) {
+				succeeded = AcceptClients(handler);
+			} else {
+				// A client which hung up is still serviced, so the requests it sent before hanging up are handled
+				SocketInstance* client = static_cast<SocketInstance*>(source);
+				if (!ServiceClient(client, handler)) {
+					CloseClient(client, handler);
+				}
+			}
+		}
+	}
+
+	while (!m_clients.empty()) {
+		CloseClient(*m_clients.begin(), handler);
+	}
+
+	return succeeded;
+}
+
+void PosixIPCServerTransport::Interrupt() {
+	m_stop = true;
+	if (m_wakeFd >= 0) {
+		const uint64_t wake = 1;
+		(void)write(m_wakeFd, &wake, sizeof(wake));
+	}
+}
+
+std::string PosixIPCServerTransport::LastError() const {
+	return ErrnoString();
+}
+
+bool PosixIPCServerTransport::AcceptClients(IIPCRequestHandler& handler) {
+	while (true) {
+		// Clients' sockets never block, so a client which stops reading its responses can't stall the rest, see
+		// SendResponse
+		const int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+
+		SocketInstance* client = new SocketInstance();
+		client->fd = fd;
+		client->responsePending = false;
+
+		epoll_event clientEvent = {};
+		clientEvent.events = EPOLLIN;
+		clientEvent.data.ptr = client;
+		if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &clientEvent) != 0) {
+			close(fd);
+			delete client;
+			return false;
+		}
+
+		m_clients.insert(client);
+		handler.OnConnected(client->connection);
+	}
+}
+
+bool PosixIPCServerTransport::ServiceClient(SocketInstance* client, IIPCRequestHandler& handler) {
+	IPCConnection_t& connection = client->connection;
+
+	// The client's last response is still waiting on room in its socket, so no more requests are read until it is sent
+	if (client->responsePending && !SendResponse(client)) {
+		return false;
+	}
+
+	for (int i = 0; i < MAX_REQUESTS_PER_CLIENT && !client->responsePending; i++) {
+		const ssize_t bytesRead = recv(client->fd, connection.readBuffer.data, IPC_BUFFER_SIZE, MSG_DONTWAIT);
+		if (bytesRead < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+		// The client hung up
+		if (bytesRead == 0) {
+			return false;
+		}
+
+		// Requests vary in size, glove updates only carry the fields which changed
+		connection.readBuffer.dataSize = static_cast<uint64_t>(bytesRead);
+		handler.HandleRequest(connection);
+
+		// One way requests have no response
+		if (connection.writeBuffer.dataSize == 0) {
+			continue;
+		}
+
+		if (!SendResponse(client)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool PosixIPCServerTransport::SendResponse(SocketInstance* client) {
+	const IPCConnection_t& connection = client->connection;
+
+	while (true) {
+		// SOCK_SEQPACKET sends a message whole or not at all
+		const ssize_t bytesWritten = send(client->fd, connection.writeBuffer.data, connection.writeBuffer.dataSize, MSG_NOSIGNAL);
+		if (bytesWritten == static_cast<ssize_t>(connection.writeBuffer.dataSize)) {
+			break;
+		}
+		if (bytesWritten >= 0) {
+			return false;
+		}
+		if (errno == EINTR) {
+			continue;
+		}
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			return false;
+		}
+
+		// The client isn't reading its responses. Keep this one and wait for room rather than blocking every client
+		if (!client->responsePending && !WatchClient(client, EPOLLOUT)) {
+			return false;
+		}
+		client->responsePending = true;
+		return true;
+	}
+
+	if (client->responsePending && !WatchClient(client, EPOLLIN)) {
+		return false;
+	}
+	client->responsePending = false;
+	return true;
+}
+
+bool PosixIPCServerTransport::WatchClient(SocketInstance* client, const uint32_t events) {
+	epoll_event clientEvent = {};
+	clientEvent.events = events;
+	clientEvent.data.ptr = client;
+	return epoll_ctl(m_epollFd, EPOLL_CTL_MOD, client->fd, &clientEvent) == 0;
+}
+
+void PosixIPCServerTransport::CloseClient(SocketInstance* client, IIPCRequestHandler& handler) {
+	handler.OnDisconnected(client->connection);
+
+	epoll_ctl(m_epollFd, EPOLL_CTL_DEL, client->fd, nullptr);
+	close(client->fd);
+	m_clients.erase(client);
+	delete client;
+}
+
+PosixIPCClientTransport::PosixIPCClientTransport() : m_fd(-1) {}
+
+PosixIPCClientTransport::~PosixIPCClientTransport() {
+	Close();
+}
+
+bool PosixIPCClientTransport::Connect(const std::string& name, const uint32_t timeoutMs) {
+	Close();
+
+	m_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if (m_fd < 0) {
+		return false;
+	}
+
+	// A connect to a server with a full backlog waits up to the send timeout, which is cleared again once connected
+	timeval timeout = {};
+	timeout.tv_sec = timeoutMs / 1000;
+	timeout.tv_usec = (timeoutMs % 1000) * 1000;
+	setsockopt(m_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	sockaddr_un address;
+	const socklen_t addressLength = SocketAddress(name, address);
+	if (connect(m_fd, reinterpret_cast<const sockaddr*>(&address), addressLength) != 0) {
+		const int error = errno;
+		Close();
+		errno = error;
+		return false;
+	}
+
+	timeout = {};
+	setsockopt(m_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	return true;
+}
+
+void PosixIPCClientTransport::Close() {
+	if (m_fd >= 0) {
+		close(m_fd);
+		m_fd = -1;
+	}
+}
+
+bool PosixIPCClientTransport::Write(const void* buffer, const size_t size) {
+	ssize_t bytesWritten;
+	do {
+		bytesWritten = send(m_fd, buffer, size, MSG_NOSIGNAL);
+	} while (bytesWritten < 0 && errno == EINTR);
+
+	return bytesWritten == static_cast<ssize_t>(size);
+}
+
+bool PosixIPCClientTransport::Read(void* buffer, const size_t size, size_t& outRead) {
+	ssize_t bytesRead;
+	do {
+		bytesRead = recv(m_fd, buffer, size, 0);
+	} while (bytesRead < 0 && errno == EINTR);
+
+	if (bytesRead <= 0) {
+		// 0 means the server hung up
+		if (bytesRead == 0) {
+			errno = ECONNRESET;
+		}
+		outRead = 0;
+		return false;
+	}
+
+	outRead = static_cast<size_t>(bytesRead);
+	return true;
+}
+
+bool PosixIPCClientTransport::Available() {
+	pollfd pfd = {};
+	pfd.fd = m_fd;
+	pfd.events = POLLIN;
+	return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN) != 0;
+}
+
+std::string PosixIPCClientTransport::LastError() const {
+	return ErrnoString();
+}
+
+#endif // __linux__
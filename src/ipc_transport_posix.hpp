@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>
+#include <set>
+
+#include "ipc_transport.hpp"
+
+/// <summary>
+/// Server transport on a SOCK_SEQPACKET Unix domain socket in the abstract namespace, which keeps each request and
+/// response a message of its own like a message mode pipe does. Run sleeps in epoll on the listening socket, every
+/// client, and an eventfd so Interrupt can wake it.
+/// </summary>
+class PosixIPCServerTransport : public IIPCServerTransport {
+	struct SocketInstance {
+		int fd;
+		IPCConnection_t connection;
+		// The response in the connection's write buffer is waiting for room in the socket, see SendResponse
+		bool responsePending;
+	};
+
+public:
+	PosixIPCServerTransport();
+	~PosixIPCServerTransport() override;
+
+	bool Listen(const std::string& name) override;
+	bool Run(IIPCRequestHandler& handler) override;
+	void Interrupt() override;
+
+	std::string LastError() const override;
+
+private:
+	// Accepts every client waiting on the listening socket
+	bool AcceptClients(IIPCRequestHandler& handler);
+	// Handles every request the client has sent. Returns false if the client hung up or errored
+	bool ServiceClient(SocketInstance* client, IIPCRequestHandler& handler);
+	// Sends the response in the client's write buffer, or waits on EPOLLOUT to send it if the client's socket is full.
+	// Returns false if the client hung up or errored
+	bool SendResponse(SocketInstance* client);
+	// Sets which events epoll wakes for on the client's socket
+	bool WatchClient(SocketInstance* client, const uint32_t events);
+	void CloseClient(SocketInstance* client, IIPCRequestHandler& handler);
+
+private:
+	int m_listenFd;
+	int m_epollFd;
+	int m_wakeFd;
+	std::atomic<bool> m_stop;
+
+	std::set<SocketInstance*> m_clients;
+};
+
+/// <summary>
+/// Client transport on a SOCK_SEQPACKET Unix domain socket.
+/// </summary>
+class PosixIPCClientTransport : public IIPCClientTransport {
+public:
+	PosixIPCClientTransport();
+	~PosixIPCClientTransport() override;
+
+	bool Connect(const std::string& name, const uint32_t timeoutMs) override;
+	void Close() override;
+
+	bool Write(const void* buffer, const size_t size) override;
+	bool Read(void* buffer, const size_t size, size_t& outRead) override;
+	bool Available() override;
+
+	std::string LastError() const override;
+
+private:
+	int m_fd;
+};
+
+#endif // __linux__
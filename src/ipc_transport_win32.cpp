@@ -0,0 +1,356 @@
+#ifdef _WIN32
+
+#include "ipc_transport_win32.hpp"
+
+#define PIPE_TIMEOUT 5000
+
+std::unique_ptr<IIPCServerTransport> CreateIPCServerTransport() {
+	return std::make_unique<Win32IPCServerTransport>();
+}
+
+std::unique_ptr<IIPCClientTransport> CreateIPCClientTransport() {
+	return std::make_unique<Win32IPCClientTransport>();
+}
+
+static std::wstring PipeName(const std::string& name) {
+	return L"\\\\.\\pipe\\" + std::wstring(name.begin(), name.end());
+}
+
+static std::string LastErrorString() {
+	const DWORD lastError = ::GetLastError();
+	if (lastError == 0) {
+		return std::string();
+	}
+
+	LPSTR buffer = nullptr;
+	const size_t size = FormatMessageA(
+		FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+		NULL, lastError, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPSTR)&buffer, 0, NULL
+	);
+	std::string message(buffer, size);
+	LocalFree(buffer);
+	return std::to_string(lastError) + ": " + message;
+}
+
+Win32IPCServerTransport::Win32IPCServerTransport()
+	: m_pipeName(), m_connectEvent(NULL), m_stop(false), m_pipes(), m_handler(nullptr) {}
+
+Win32IPCServerTransport::~Win32IPCServerTransport() {
+	if (m_connectEvent != NULL) {
+		CloseHandle(m_connectEvent);
+	}
+}
+
+bool Win32IPCServerTransport::Listen(const std::string& name) {
+	m_pipeName = PipeName(name);
+
+	// Create one event object for the connect operation. Created here rather than in Run, so Interrupt can always signal it
+	m_connectEvent = CreateEvent(
+		NULL,    // default security attribute
+		TRUE,    // manual reset event
+		TRUE,    // initial state = signaled
+		NULL);   // unnamed event object
+
+	return m_connectEvent != NULL;
+}
+
+bool Win32IPCServerTransport::Run(IIPCRequestHandler& handler) {
+	m_handler = &handler;
+
+	OVERLAPPED oConnect = {};
+	PipeInstance* lpPipeInst;
+	DWORD dwWait, cbRet;
+	BOOL fSuccess, fPendingIO;
+	HANDLE hPipe;
+	bool succeeded = true;
+
+	oConnect.hEvent = m_connectEvent;
+
+	// Call a subroutine to create one instance, and wait for the client to connect.
+	fPendingIO = CreateAndConnectInstance(&oConnect, hPipe);
+
+	while (succeeded && hPipe != INVALID_HANDLE_VALUE && !m_stop)
+	{
+		// Wait for a client to connect, or for a read or write operation to be completed, which causes a completion routine to be queued for execution.
+		dwWait = WaitForSingleObjectEx(
+			m_connectEvent, // event object to wait for
+			INFINITE,       // waits indefinitely
+			TRUE);          // alertable wait enabled
+
+		if (m_stop) {
+			break;
+		}
+
+		switch (dwWait)
+		{
+			// The wait conditions are satisfied by a completed connect operation.
+		case 0:
+		{
+			// If an operation is pending, get the result of the connect operation.
+			if (fPendingIO) {
+				fSuccess = GetOverlappedResult(
+					hPipe,     // pipe handle
+					&oConnect, // OVERLAPPED structure
+					&cbRet,    // bytes transferred
+					FALSE);    // does not wait
+
+				if (!fSuccess) {
+					succeeded = false;
+					break;
+				}
+			}
+
+			// Allocate storage for this instance.
+			lpPipeInst = CreatePipeInstance(hPipe);
+
+			// Start the read operation for this client. Note that this same routine is later used as a completion routine after a write operation.
+			lpPipeInst->connection.writeBuffer.dataSize = 0;
+			CompletedWriteRoutine(0, 0, (LPOVERLAPPED)lpPipeInst);
+
+			// Create new pipe instance for the next client.
+			fPendingIO = CreateAndConnectInstance(&oConnect, hPipe);
+			break;
+		}
+
+		// The wait is satisfied by a completed read or write operation. This allows the system to execute the completion routine.
+		case WAIT_IO_COMPLETION:
+			break;
+
+			// An error occurred in the wait function.
+		default:
+			succeeded = false;
+			break;
+		}
+	}
+
+	// The instance still waiting for a client was never handed to the handler
+	if (hPipe != INVALID_HANDLE_VALUE) {
+		CloseHandle(hPipe);
+	} else {
+		succeeded = false;
+	}
+
+	while (!m_pipes.empty()) {
+		ClosePipeInstance(*m_pipes.begin());
+	}
+
+	m_handler = nullptr;
+	return succeeded;
+}
+
+void Win32IPCServerTransport::Interrupt() {
+	m_stop = true;
+	if (m_connectEvent != NULL) {
+		SetEvent(m_connectEvent);
+	}
+}
+
+std::string Win32IPCServerTransport::LastError() const {
+	return LastErrorString();
+}
+
+Win32IPCServerTransport::PipeInstance* Win32IPCServerTransport::CreatePipeInstance(HANDLE pipe) {
+	PipeInstance* pipeInst = new PipeInstance();
+	pipeInst->hPipeInst = pipe;
+	pipeInst->transport = this;
+
+	m_pipes.insert(pipeInst);
+	m_handler->OnConnected(pipeInst->connection);
+	return pipeInst;
+}
+
+void Win32IPCServerTransport::ClosePipeInstance(PipeInstance* pipeInst) {
+	m_handler->OnDisconnected(pipeInst->connection);
+
+	DisconnectNamedPipe(pipeInst->hPipeInst);
+	CloseHandle(pipeInst->hPipeInst);
+	m_pipes.erase(pipeInst);
+	delete pipeInst;
+}
+
+// This function creates a pipe instance and connects to the client. It returns TRUE if the connect operation is pending, and FALSE if the connection has been completed.
+BOOL Win32IPCServerTransport::CreateAndConnectInstance(LPOVERLAPPED lpoOverlap, HANDLE& pipe) {
+	pipe = CreateNamedPipeW(
+		m_pipeName.c_str(),       // pipe name
+		PIPE_ACCESS_DUPLEX |      // read/write access
+		FILE_FLAG_OVERLAPPED,     // overlapped mode
+		PIPE_TYPE_MESSAGE |       // message-type pipe
+		PIPE_READMODE_MESSAGE |   // message read mode
+		PIPE_WAIT,                // blocking mode
+		PIPE_UNLIMITED_INSTANCES, // unlimited instances
+		IPC_BUFFER_SIZE * sizeof(CHAR),    // output buffer size
+		IPC_BUFFER_SIZE * sizeof(CHAR),    // input buffer size
+		PIPE_TIMEOUT,             // client time-out
+		NULL);                    // default security attributes
+
+	if (pipe == INVALID_HANDLE_VALUE) {
+		return 0;
+	}
+
+	// Call a subroutine to connect to the new client.
+	return ConnectToNewClient(pipe, lpoOverlap);
+}
+
+// This routine is called as a completion routine after writing to the pipe, or when a new client has connected to a pipe instance. It starts another read operation.
+VOID WINAPI Win32IPCServerTransport::CompletedWriteRoutine(DWORD dwErr, DWORD cbWritten, LPOVERLAPPED lpOverLap) {
+	PipeInstance* lpPipeInst;
+	BOOL fRead = FALSE;
+
+	// lpOverlap points to storage for this instance.
+	lpPipeInst = (PipeInstance*)lpOverLap;
+
+	// The write operation has finished, so read the next request (if there is no error).
+	if ((dwErr == 0) && (cbWritten == lpPipeInst->connection.writeBuffer.dataSize)) {
+		fRead = ReadFileEx(
+			lpPipeInst->hPipeInst,
+			lpPipeInst->connection.readBuffer.data,
+			IPC_BUFFER_SIZE * sizeof(CHAR),
+			(LPOVERLAPPED)lpPipeInst,
+			(LPOVERLAPPED_COMPLETION_ROUTINE)CompletedReadRoutine);
+	}
+
+	// Disconnect if an error occurred.
+	if (!fRead) {
+		lpPipeInst->transport->ClosePipeInstance(lpPipeInst);
+	}
+}
+
+// This routine is called as an I/O completion routine after reading a request from the client. It gets data and writes it to the pipe.
+VOID WINAPI Win32IPCServerTransport::CompletedReadRoutine(DWORD dwErr, DWORD cbBytesRead, LPOVERLAPPED lpOverLap) {
+	PipeInstance* lpPipeInst;
+	BOOL fWrite = FALSE;
+
+	// lpOverlap points to storage for this instance.
+	lpPipeInst = (PipeInstance*)lpOverLap;
+	IPCConnection_t& connection = lpPipeInst->connection;
+
+	// The read operation has finished, so write a response (if no error occurred).
+	if ((dwErr == 0) && (cbBytesRead != 0)) {
+		// Requests vary in size, glove updates only carry the fields which changed
+		connection.readBuffer.dataSize = cbBytesRead;
+		lpPipeInst->transport->m_handler->HandleRequest(connection);
+
+		// One way requests have no response, so go straight back to reading
+		if (connection.writeBuffer.dataSize == 0) {
+			CompletedWriteRoutine(0, 0, (LPOVERLAPPED)lpPipeInst);
+			return;
+		}
+
+		fWrite = WriteFileEx(
+			lpPipeInst->hPipeInst,
+			connection.writeBuffer.data,
+			static_cast<DWORD>(connection.writeBuffer.dataSize),
+			(LPOVERLAPPED)lpPipeInst,
+			(LPOVERLAPPED_COMPLETION_ROUTINE)CompletedWriteRoutine);
+	}
+
+	// Disconnect if an error occurred.
+	if (!fWrite) {
+		lpPipeInst->transport->ClosePipeInstance(lpPipeInst);
+	}
+}
+
+BOOL Win32IPCServerTransport::ConnectToNewClient(HANDLE hPipe, LPOVERLAPPED lpo) {
+	BOOL fConnected, fPendingIO = FALSE;
+
+	// Start an overlapped connection for this pipe instance.
+	fConnected = ConnectNamedPipe(hPipe, lpo);
+
+	// Overlapped ConnectNamedPipe should return zero.
+	if (fConnected) {
+		return 0;
+	}
+
+	switch (GetLastError()) {
+		// The overlapped connection in progress.
+	case ERROR_IO_PENDING:
+		fPendingIO = TRUE;
+		break;
+
+		// Client is already connected, so signal an event.
+	case ERROR_PIPE_CONNECTED:
+		if (SetEvent(lpo->hEvent))
+			break;
+
+		// If an error occurs during the connect operation...
+	default:
+		return 0;
+	}
+	return fPendingIO;
+}
+
+Win32IPCClientTransport::Win32IPCClientTransport() : m_pipe(INVALID_HANDLE_VALUE) {}
+
+Win32IPCClientTransport::~Win32IPCClientTransport() {
+	Close();
+}
+
+bool Win32IPCClientTransport::Connect(const std::string& name, const uint32_t timeoutMs) {
+	Close();
+
+	const std::wstring pipeName = PipeName(name);
+	while (true) {
+		m_pipe = CreateFileW(
+			pipeName.c_str(), // pipe name
+			GENERIC_READ |    // read and write access
+			GENERIC_WRITE,
+			0,                // no sharing
+			NULL,             // default security attributes
+			OPEN_EXISTING,    // opens existing pipe
+			0,                // default attributes
+			NULL);            // no template file
+
+		// Break if the pipe handle is valid.
+		if (m_pipe != INVALID_HANDLE_VALUE) {
+			break;
+		}
+
+		// Exit if an error other than ERROR_PIPE_BUSY occurs.
+		if (GetLastError() != ERROR_PIPE_BUSY) {
+			return false;
+		}
+
+		// All pipe instances are busy, so wait for one to free up.
+		if (!WaitNamedPipeW(pipeName.c_str(), timeoutMs)) {
+			return false;
+		}
+	}
+
+	DWORD mode = PIPE_READMODE_MESSAGE;
+	if (!SetNamedPipeHandleState(m_pipe, &mode, 0, 0)) {
+		return false;
+	}
+
+	return true;
+}
+
+void Win32IPCClientTransport::Close() {
+	if (m_pipe != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_pipe);
+		m_pipe = INVALID_HANDLE_VALUE;
+	}
+}
+
+bool Win32IPCClientTransport::Write(const void* buffer, const size_t size) {
+	DWORD bytesWritten;
+	return WriteFile(m_pipe, buffer, static_cast<DWORD>(size), &bytesWritten, 0) && bytesWritten == size;
+}
+
+bool Win32IPCClientTransport::Read(void* buffer, const size_t size, size_t& outRead) {
+	DWORD bytesRead = 0;
+	const BOOL success = ReadFile(m_pipe, buffer, static_cast<DWORD>(size), &bytesRead, 0);
+	outRead = bytesRead;
+	// ERROR_MORE_DATA means the message was larger than the buffer, which it filled. The rest is left in the pipe
+	return success || GetLastError() == ERROR_MORE_DATA;
+}
+
+bool Win32IPCClientTransport::Available() {
+	DWORD bytesAvailable = 0;
+	return PeekNamedPipe(m_pipe, NULL, 0, NULL, &bytesAvailable, NULL) && bytesAvailable != 0;
+}
+
+std::string Win32IPCClientTransport::LastError() const {
+	return LastErrorString();
+}
+
+#endif // _WIN32
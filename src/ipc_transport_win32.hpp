@@ -0,0 +1,78 @@
+#pragma once
+
+#ifdef _WIN32
+
+#include <atomic>
+#include <set>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+#include "ipc_transport.hpp"
+
+/// <summary>
+/// Server transport on overlapped named pipes. Reads and writes complete through APC completion routines, which run
+/// while Run sleeps in an alertable wait on the event signalled when a client connects.
+/// </summary>
+class Win32IPCServerTransport : public IIPCServerTransport {
+	struct PipeInstance {
+		// First, so the OVERLAPPED a completion routine is given is the instance
+		OVERLAPPED oOverlap;
+		HANDLE hPipeInst;
+		Win32IPCServerTransport* transport;
+
+		IPCConnection_t connection;
+	};
+
+public:
+	Win32IPCServerTransport();
+	~Win32IPCServerTransport() override;
+
+	bool Listen(const std::string& name) override;
+	bool Run(IIPCRequestHandler& handler) override;
+	void Interrupt() override;
+
+	std::string LastError() const override;
+
+private:
+	PipeInstance* CreatePipeInstance(HANDLE pipe);
+	void ClosePipeInstance(PipeInstance* pipeInst);
+
+	BOOL CreateAndConnectInstance(LPOVERLAPPED lpoOverlap, HANDLE& pipe);
+	static BOOL ConnectToNewClient(HANDLE hPipe, LPOVERLAPPED lpo);
+
+	static VOID WINAPI CompletedWriteRoutine(DWORD dwErr, DWORD cbWritten, LPOVERLAPPED lpOverLap);
+	static VOID WINAPI CompletedReadRoutine(DWORD dwErr, DWORD cbBytesRead, LPOVERLAPPED lpOverLap);
+
+private:
+	std::wstring m_pipeName;
+	HANDLE m_connectEvent;
+	std::atomic<bool> m_stop;
+
+	std::set<PipeInstance*> m_pipes;
+	// Only set while Run is servicing clients
+	IIPCRequestHandler* m_handler;
+};
+
+/// <summary>
+/// Client transport on a message mode named pipe.
+/// </summary>
+class Win32IPCClientTransport : public IIPCClientTransport {
+public:
+	Win32IPCClientTransport();
+	~Win32IPCClientTransport() override;
+
+	bool Connect(const std::string& name, const uint32_t timeoutMs) override;
+	void Close() override;
+
+	bool Write(const void* buffer, const size_t size) override;
+	bool Read(void* buffer, const size_t size, size_t& outRead) override;
+	bool Available() override;
+
+	std::string LastError() const override;
+
+private:
+	HANDLE m_pipe;
+};
+
+#endif // _WIN32
@@ -2,7 +2,9 @@
 #include "device_provider.hpp"
 #include "maths.hpp"
 
-ContactGloveDevice::ContactGloveDevice(DeviceProvider* devProvider, bool isLeft)
+#include <cmath>
+
+ContactGloveDevice::ContactGloveDevice(DeviceProvider* devProvider, uint32_t glovePair, bool isLeft)
     :	m_isLeft(isLeft),
         m_devProvider(devProvider),
         m_isActiveInSteamVR(false),
@@ -16,7 +18,11 @@ ContactGloveDevice::ContactGloveDevice(DeviceProvider* devProvider, bool isLeft)
         m_thumbActivation({}),
         m_triggerActivation({}),
         m_gripActivation({}),
-        m_poseOffset({}),
+        m_calibrationGeneration(0),
+        m_poseOffset({ {}, HmdQuaternion_Identity }),
+        m_thumbThresholds({}),
+        m_triggerThresholds({}),
+        m_gripThresholds({}),
         m_lastState({}),
         m_curlThumb(0),
         m_curlIndex(0),
@@ -36,6 +42,9 @@ ContactGloveDevice::ContactGloveDevice(DeviceProvider* devProvider, bool isLeft)
     } else {
         m_serial = "ContactGlove-Right";
     }
+    if (glovePair != 0) {
+        m_serial += "-" + std::to_string(glovePair + 1);
+    }
     m_deviceManufacturer = "Diver-X";
     memset(m_inputComponentHandles, vr::k_ulInvalidInputComponentHandle, sizeof m_inputComponentHandles);
     memset(m_handTransforms, 0, sizeof m_inputComponentHandles);
@@ -269,8 +278,14 @@ void ContactGloveDevice::PoseUpdateThread() {
                     vr::DriverPose_t refPose = driverPose;
                     m_lastPose = driverPose;
 
+                    protocol::ContactGloveState_t::CalibrationData_t::PoseOffset_t poseOffset;
+                    {
+                        std::lock_guard<std::mutex> lock(m_calibrationMutex);
+                        poseOffset = m_poseOffset;
+                    }
+
                     const vr::HmdVector3d_t refPosition = { refPose.vecPosition[0], refPose.vecPosition[1], refPose.vecPosition[2] };
-                    const vr::HmdVector3d_t newPosition = refPosition + (m_poseOffset.pos * refPose.qRotation);
+                    const vr::HmdVector3d_t newPosition = refPosition + (poseOffset.pos * refPose.qRotation);
 
                     // Align the position, by offseting our offset by the current tracker rotation then offsetting by it's position
                     driverPose.vecPosition[0] = newPosition.v[0];
@@ -278,7 +293,16 @@ void ContactGloveDevice::PoseUpdateThread() {
                     driverPose.vecPosition[2] = newPosition.v[2];
 
                     // Align the rotation by doing rotation composition
-                    driverPose.qRotation = refPose.qRotation * m_poseOffset.rot;
+                    driverPose.qRotation = refPose.qRotation * poseOffset.rot;
+
+                    // Extrapolate the rotation with the glove's IMU, to get ahead of fast wrist rotations. The tracker's
+                    // angular velocity is in driver space, the predictor wants it in the glove's frame
+                    const vr::HmdVector3d_t refAngularVelocity = { refPose.vecAngularVelocity[0], refPose.vecAngularVelocity[1], refPose.vecAngularVelocity[2] };
+                    {
+                        std::lock_guard<std::mutex> lock(m_imuPredictorMutex);
+                        m_imuPredictor.Align(refAngularVelocity * -driverPose.qRotation);
+                        driverPose.qRotation = driverPose.qRotation * m_imuPredictor.Predict(protocol::MonotonicTimestamp(), IMU_PREDICTION_HORIZON_SECONDS);
+                    }
                 }
 
                 vr::VRServerDriverHost()->TrackedDevicePoseUpdated(m_deviceId, driverPose, sizeof(vr::DriverPose_t));
@@ -309,7 +333,7 @@ void ContactGloveDevice::Update(const protocol::ContactGloveState_t& updateState
     if (updateState.isConnected) {
         if (!m_isConnected) {
             // First frame where the glove has been connected. Add it to SteamVR
-            LOG("Glove %s connected! Magnetra: %d", m_serial.c_str(), updateState.hasMagnetra);
+            LOG("Glove %s connected! Magnetra: %d", m_serial.c_str(), (updateState.sample.buttons & protocol::GloveButtonMagnetra) != 0);
             vr::VRServerDriverHost()->TrackedDeviceAdded(m_serial.c_str(), vr::TrackedDeviceClass_Controller, this);
         } else {
             // Glove has already been added to SteamVR, update props etc
@@ -319,9 +343,11 @@ void ContactGloveDevice::Update(const protocol::ContactGloveState_t& updateState
             m_doInput.exchange(true);
             memcpy(&m_lastState, &updateState, sizeof updateState);
             m_doInput.exchange(false);
-            
-            // Copy the pose offset
-            memcpy(&m_poseOffset, &updateState.calibration.poseOffset, sizeof(m_poseOffset));
+
+            if (updateState.imuTimestamp != 0) {
+                std::lock_guard<std::mutex> lock(m_imuPredictorMutex);
+                m_imuPredictor.AddSample(updateState.imuRotation, updateState.imuTimestamp);
+            }
         }
     }
 
@@ -329,108 +355,80 @@ void ContactGloveDevice::Update(const protocol::ContactGloveState_t& updateState
     if (m_isConnectedMainThreadLocal != updateState.isConnected) {
         m_isConnected.exchange(updateState.isConnected);
         m_isConnectedMainThreadLocal = updateState.isConnected;
+
+        // The IMU may have been remounted while the glove was off
+        std::lock_guard<std::mutex> lock(m_imuPredictorMutex);
+        m_imuPredictor.Reset();
     }
 }
 
-// Approximates a curl value given a metacarpal bone, proximal bone and distal bone
-float ContactGloveDevice::ApproximateSingleFingerCurl(HandSkeletonBone metacarpal, HandSkeletonBone distal) {
-
-    vr::HmdVector4_t metacarpalPos  = m_handTransforms[static_cast<short>(metacarpal)].position;
-    vr::HmdVector4_t proximalPos    = m_handTransforms[static_cast<short>(metacarpal) + 1].position;
-    vr::HmdVector4_t distalPos      = m_handTransforms[static_cast<short>(distal)].position;
-
-    // Compute absolute proximal position since bone positions are relative
-    proximalPos.v[0] = metacarpalPos.v[0] + proximalPos.v[0];
-    proximalPos.v[1] = metacarpalPos.v[1] + proximalPos.v[1];
-    proximalPos.v[2] = metacarpalPos.v[2] + proximalPos.v[2];
-
-    // Bone positions are relative, add them to compute the absolute position of the distal bone
-    for (int i = metacarpal; i <= distal; i++) {
-        vr::HmdVector4_t bonePosition = m_handTransforms[static_cast<short>(i)].position;
-        distalPos.v[0] = distalPos.v[0] + bonePosition.v[0];
-        distalPos.v[1] = distalPos.v[1] + bonePosition.v[1];
-        distalPos.v[2] = distalPos.v[2] + bonePosition.v[2];
+void ContactGloveDevice::UpdateCalibration(const protocol::GloveCalibration_t& calibration) {
+    if (calibration.generation == m_calibrationGeneration) {
+        return;
     }
 
-    // Compute the direction from the metacarpal to the proximal and distal
-    vr::HmdVector3_t proximalDir = {
-        .v = {
-            proximalPos.v[0] - metacarpalPos.v[0],
-            proximalPos.v[1] - metacarpalPos.v[1],
-            proximalPos.v[2] - metacarpalPos.v[2]
-        }
-    };
-
-    vr::HmdVector3_t distalDir = {
-        .v = {
-            distalPos.v[0] - metacarpalPos.v[0],
-            distalPos.v[1] - metacarpalPos.v[1],
-            distalPos.v[2] - metacarpalPos.v[2]
-        }
+    // The pose thread composes with the offset rotation every pose, so it's normalised once here
+    protocol::ContactGloveState_t::CalibrationData_t::PoseOffset_t poseOffset = calibration.calibration.poseOffset;
+    const vr::HmdQuaternion_t rot = poseOffset.rot;
+    const double length = std::sqrt(rot.w * rot.w + rot.x * rot.x + rot.y * rot.y + rot.z * rot.z);
+    poseOffset.rot = length > 0.0 ? vr::HmdQuaternion_t{ rot.w / length, rot.x / length, rot.y / length, rot.z / length } : HmdQuaternion_Identity;
+
+    const auto deriveGestureThresholds = [](const protocol::ContactGloveState_t::CalibrationData_t::GestureThreshold_t& threshold) {
+        return GestureThresholds{
+            .activate   = threshold.activate,
+            .deactivate = threshold.deactivate,
+            .scale      = threshold.deactivate < 1.0f ? 1.0f / (1.0f - threshold.deactivate) : 0.0f,
+        };
     };
 
-    double distanceProximal = sqrt(
-        proximalDir.v[0] * proximalDir.v[0] +
-        proximalDir.v[1] * proximalDir.v[1] +
-        proximalDir.v[2] * proximalDir.v[2]);
-
-    double distanceDistal = sqrt(
-        distalDir.v[0] * distalDir.v[0] +
-        distalDir.v[1] * distalDir.v[1] +
-        distalDir.v[2] * distalDir.v[2]);
-
-    double dotProduct =
-        distalDir.v[0] / distanceProximal * distalDir.v[0] / distanceDistal +
-        distalDir.v[1] / distanceProximal * distalDir.v[1] / distanceDistal +
-        distalDir.v[2] / distanceProximal * distalDir.v[2] / distanceDistal;
-
-    // Now that we have the length we can compute the angle it's at
-    double angle = acos(dotProduct);
-    const double ninetyDeg = DegToRad(90.f);
-
-    return Clamp((float) (angle / ninetyDeg), -1.f, 1.f);
+    std::lock_guard<std::mutex> lock(m_calibrationMutex);
+    m_calibrationGeneration = calibration.generation;
+    m_poseOffset            = poseOffset;
+    m_thumbThresholds       = deriveGestureThresholds(calibration.calibration.gestures.thumb);
+    m_triggerThresholds     = deriveGestureThresholds(calibration.calibration.gestures.trigger);
+    m_gripThresholds        = deriveGestureThresholds(calibration.calibration.gestures.grip);
 }
 
 // Approximates curl values from a skeletal input pose
-void ContactGloveDevice::ApproximateCurls(const protocol::ContactGloveState_t& updateState) {
+void ContactGloveDevice::ApproximateCurls(const protocol::ContactGloveState_t& updateState, const float (&joints)[protocol::GloveJoint_Count]) {
 
     if (updateState.useCurl) {
-        m_curlThumb     = ApproximateSingleFingerCurl(HandSkeletonBone::kHandSkeletonBone_Thumb0,           HandSkeletonBone::kHandSkeletonBone_Thumb3);
-        m_curlIndex     = ApproximateSingleFingerCurl(HandSkeletonBone::kHandSkeletonBone_IndexFinger1,     HandSkeletonBone::kHandSkeletonBone_IndexFinger4);
-        m_curlMiddle    = ApproximateSingleFingerCurl(HandSkeletonBone::kHandSkeletonBone_MiddleFinger1,    HandSkeletonBone::kHandSkeletonBone_MiddleFinger4);
-        m_curlRing      = ApproximateSingleFingerCurl(HandSkeletonBone::kHandSkeletonBone_RingFinger1,      HandSkeletonBone::kHandSkeletonBone_RingFinger4);
-        m_curlPinky     = ApproximateSingleFingerCurl(HandSkeletonBone::kHandSkeletonBone_PinkyFinger1,     HandSkeletonBone::kHandSkeletonBone_PinkyFinger4);
+        m_curlThumb     = ApproximateSingleFingerCurl(m_handTransforms, HandSkeletonBone::kHandSkeletonBone_Thumb0,           HandSkeletonBone::kHandSkeletonBone_Thumb3);
+        m_curlIndex     = ApproximateSingleFingerCurl(m_handTransforms, HandSkeletonBone::kHandSkeletonBone_IndexFinger1,     HandSkeletonBone::kHandSkeletonBone_IndexFinger4);
+        m_curlMiddle    = ApproximateSingleFingerCurl(m_handTransforms, HandSkeletonBone::kHandSkeletonBone_MiddleFinger1,    HandSkeletonBone::kHandSkeletonBone_MiddleFinger4);
+        m_curlRing      = ApproximateSingleFingerCurl(m_handTransforms, HandSkeletonBone::kHandSkeletonBone_RingFinger1,      HandSkeletonBone::kHandSkeletonBone_RingFinger4);
+        m_curlPinky     = ApproximateSingleFingerCurl(m_handTransforms, HandSkeletonBone::kHandSkeletonBone_PinkyFinger1,     HandSkeletonBone::kHandSkeletonBone_PinkyFinger4);
     } else {
-        m_curlThumb     = (float)(0.3 * updateState.thumbRoot   + 0.7 * updateState.thumbTip);
-        m_curlIndex     = (float)(0.3 * updateState.indexRoot   + 0.7 * updateState.indexTip);
-        m_curlMiddle    = (float)(0.3 * updateState.middleRoot  + 0.7 * updateState.middleTip);
-        m_curlRing      = (float)(0.3 * updateState.ringRoot    + 0.7 * updateState.ringTip);
-        m_curlPinky     = (float)(0.3 * updateState.pinkyRoot   + 0.7 * updateState.pinkyTip);
+        m_curlThumb     = (float)(0.3 * joints[protocol::GloveJointThumbRoot]   + 0.7 * joints[protocol::GloveJointThumbTip]);
+        m_curlIndex     = (float)(0.3 * joints[protocol::GloveJointIndexRoot]   + 0.7 * joints[protocol::GloveJointIndexTip]);
+        m_curlMiddle    = (float)(0.3 * joints[protocol::GloveJointMiddleRoot]  + 0.7 * joints[protocol::GloveJointMiddleTip]);
+        m_curlRing      = (float)(0.3 * joints[protocol::GloveJointRingRoot]    + 0.7 * joints[protocol::GloveJointRingTip]);
+        m_curlPinky     = (float)(0.3 * joints[protocol::GloveJointPinkyRoot]   + 0.7 * joints[protocol::GloveJointPinkyTip]);
     }
 }
 
-void ContactGloveDevice::UpdateSkeletalInput(const protocol::ContactGloveState_t& updateState) {
+void ContactGloveDevice::UpdateSkeletalInput(const protocol::ContactGloveState_t& updateState, const float (&joints)[protocol::GloveJoint_Count]) {
 
     GloveFingerCurls curls = {
         .thumb = {
-            .proximal   = updateState.thumbRoot,
-            .distal     = updateState.thumbTip
+            .proximal   = joints[protocol::GloveJointThumbRoot],
+            .distal     = joints[protocol::GloveJointThumbTip]
         },
         .index = {
-            .proximal   = updateState.indexRoot,
-            .distal     = updateState.indexTip
+            .proximal   = joints[protocol::GloveJointIndexRoot],
+            .distal     = joints[protocol::GloveJointIndexTip]
         },
         .middle = {
-            .proximal   = updateState.middleRoot,
-            .distal     = updateState.middleTip
+            .proximal   = joints[protocol::GloveJointMiddleRoot],
+            .distal     = joints[protocol::GloveJointMiddleTip]
         },
         .ring = {
-            .proximal   = updateState.ringRoot,
-            .distal     = updateState.ringTip
+            .proximal   = joints[protocol::GloveJointRingRoot],
+            .distal     = joints[protocol::GloveJointRingTip]
         },
         .pinky = {
-            .proximal   = updateState.pinkyRoot,
-            .distal     = updateState.pinkyTip
+            .proximal   = joints[protocol::GloveJointPinkyRoot],
+            .distal     = joints[protocol::GloveJointPinkyTip]
         }
     };
     GloveFingerSplays splays = {};
@@ -440,12 +438,12 @@ void ContactGloveDevice::UpdateSkeletalInput(const protocol::ContactGloveState_t
     vr::VRDriverInput()->UpdateSkeletonComponent(m_skeletalComponentHandle, vr::VRSkeletalMotionRange_WithController,    m_handTransforms, NUM_BONES);
     vr::VRDriverInput()->UpdateSkeletonComponent(m_skeletalComponentHandle, vr::VRSkeletalMotionRange_WithoutController, m_handTransforms, NUM_BONES);
 
-    ApproximateCurls(updateState);
+    ApproximateCurls(updateState, joints);
 }
 
 // Apply a threshold
-void ContactGloveDevice::HandleGesture(ThresholdState& param, const protocol::ContactGloveState_t::CalibrationData_t::GestureThreshold_t& thresholds, const float value) {
-    param.value = max(min((value - thresholds.deactivate) / (1.0f - thresholds.deactivate), 1.0f), 0.0f);
+void ContactGloveDevice::HandleGesture(ThresholdState& param, const GestureThresholds& thresholds, const float value) {
+    param.value = max(min((value - thresholds.deactivate) * thresholds.scale, 1.0f), 0.0f);
 
     if (param.isActive == false) {
         // If the value is below the threshold and we aren't active
@@ -460,46 +458,79 @@ void ContactGloveDevice::HandleGesture(ThresholdState& param, const protocol::Co
     }
 }
 
+// Time offset in seconds from now to when a sample was received, as expected by the driver input API
+static double SampleTimeOffset(const uint32_t sampleTimestamp) {
+    const uint64_t now = protocol::MonotonicTimestamp();
+    const uint64_t timestamp = protocol::ExpandGloveSampleTimestamp(sampleTimestamp, now);
+    if (timestamp == 0 || timestamp >= now) {
+        return 0.0;
+    }
+    return -static_cast<double>(now - timestamp) * 1e-9;
+}
+
 void ContactGloveDevice::UpdateInputs(const protocol::ContactGloveState_t& updateState) {
     if (updateState.isConnected) {
+        const protocol::GloveSample_t& sample = updateState.sample;
+
         // Update battery percentage
-        float gloveBattery = updateState.gloveBattery * 0.01f;
+        float gloveBattery = sample.battery * 0.01f;
         vr::VRProperties()->SetFloatProperty(m_ulProps, vr::Prop_DeviceBatteryPercentage_Float, gloveBattery);
 
+        // Report inputs relative to when the dongle received them, rather than now
+        const double sampleTimeOffset   = SampleTimeOffset(sample.timestamp);
+
+        float joints[protocol::GloveJoint_Count];
+        protocol::UnpackGloveJoints(sample.joints, joints);
+        const float joystickX           = protocol::DequantiseGloveAxis(sample.joystick[0]);
+        const float joystickY           = protocol::DequantiseGloveAxis(sample.joystick[1]);
+        const bool hasMagnetra          = (sample.buttons & protocol::GloveButtonMagnetra) != 0;
+        const bool systemUp             = (sample.buttons & protocol::GloveButtonSystemUp) != 0;
+        const bool systemDown           = (sample.buttons & protocol::GloveButtonSystemDown) != 0;
+        const bool buttonUp             = (sample.buttons & protocol::GloveButtonUp) != 0;
+        const bool buttonDown           = (sample.buttons & protocol::GloveButtonDown) != 0;
+        const bool joystickClick        = (sample.buttons & protocol::GloveButtonJoystickClick) != 0;
+
         // Handle skeletal input
-        UpdateSkeletalInput(updateState);
+        UpdateSkeletalInput(updateState, joints);
         
         // Activate thresholds
+        GestureThresholds thumbThresholds, triggerThresholds, gripThresholds;
+        {
+            std::lock_guard<std::mutex> lock(m_calibrationMutex);
+            thumbThresholds     = m_thumbThresholds;
+            triggerThresholds   = m_triggerThresholds;
+            gripThresholds      = m_gripThresholds;
+        }
         if (updateState.useCurl) {
-            HandleGesture(m_thumbActivation, updateState.calibration.gestures.thumb, m_curlThumb);
-            HandleGesture(m_triggerActivation, updateState.calibration.gestures.trigger, m_curlIndex);
-            HandleGesture(m_gripActivation, updateState.calibration.gestures.grip, (m_curlMiddle + m_curlRing + m_curlPinky) / 3.0f);
+            HandleGesture(m_thumbActivation, thumbThresholds, m_curlThumb);
+            HandleGesture(m_triggerActivation, triggerThresholds, m_curlIndex);
+            HandleGesture(m_gripActivation, gripThresholds, (m_curlMiddle + m_curlRing + m_curlPinky) / 3.0f);
         } else {
-            HandleGesture(m_thumbActivation, updateState.calibration.gestures.thumb, updateState.thumbTip);
-            HandleGesture(m_triggerActivation, updateState.calibration.gestures.trigger, updateState.indexTip);
-            HandleGesture(m_gripActivation, updateState.calibration.gestures.grip, (updateState.middleTip + updateState.ringTip + updateState.pinkyTip) / 3.0f);
+            HandleGesture(m_thumbActivation, thumbThresholds, joints[protocol::GloveJointThumbTip]);
+            HandleGesture(m_triggerActivation, triggerThresholds, joints[protocol::GloveJointIndexTip]);
+            HandleGesture(m_gripActivation, gripThresholds, (joints[protocol::GloveJointMiddleTip] + joints[protocol::GloveJointRingTip] + joints[protocol::GloveJointPinkyTip]) / 3.0f);
         }
 
-        if (updateState.hasMagnetra) {
+        if (hasMagnetra) {
             // Update inputs only if magnetra is connected
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickX)],       updateState.joystickX,  0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickY)],       -updateState.joystickY, 0); // Flipped in SteamVR for some reason
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickClick)],  updateState.joystickClick, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickTouch)],  updateState.joystickClick, 0);
-
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::AClick)],           updateState.buttonDown, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ATouch)],           updateState.buttonDown || m_thumbActivation.isActive, 0); // Thumb is also going to activate A touch
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::BClick)],           updateState.buttonUp, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::BTouch)],           updateState.buttonUp, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemClick)],      updateState.systemUp || updateState.systemDown, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemTouch)],      updateState.systemUp || updateState.systemDown, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemUpClick)],    updateState.systemUp, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemUpTouch)],    updateState.systemUp, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemDownClick)],  updateState.systemDown, 0);
-            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemDownTouch)],  updateState.systemDown, 0);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickX)],       joystickX,  0);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickY)],       -joystickY, sampleTimeOffset); // Flipped in SteamVR for some reason
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickClick)],  joystickClick, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickTouch)],  joystickClick, sampleTimeOffset);
+
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::AClick)],           buttonDown, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ATouch)],           buttonDown || m_thumbActivation.isActive, sampleTimeOffset); // Thumb is also going to activate A touch
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::BClick)],           buttonUp, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::BTouch)],           buttonUp, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemClick)],      systemUp || systemDown, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemTouch)],      systemUp || systemDown, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemUpClick)],    systemUp, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemUpTouch)],    systemUp, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemDownClick)],  systemDown, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemDownTouch)],  systemDown, sampleTimeOffset);
 
             // Log inputs for vrchat
-            DriverLog("Joy %s :: (X: %f, Y: %f)", (m_isLeft ? "(L)" : "(R)"), updateState.joystickX, -updateState.joystickY);
+            DriverLog("Joy %s :: (X: %f, Y: %f)", (m_isLeft ? "(L)" : "(R)"), joystickX, -joystickY);
         } else {
             // Default values
             vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::ThumbstickX)],       0, 0);
@@ -519,30 +550,30 @@ void ContactGloveDevice::UpdateInputs(const protocol::ContactGloveState_t& updat
             vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::SystemDownTouch)],  false, 0);
         }
 
-        vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TriggerClick)],         m_triggerActivation.isActive, 0);
-        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TriggerValue)],          m_triggerActivation.value, 0);
+        vr::VRDriverInput()->UpdateBooleanComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TriggerClick)],         m_triggerActivation.isActive, sampleTimeOffset);
+        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TriggerValue)],          m_triggerActivation.value, sampleTimeOffset);
         // Grip value => pull?
         // Grip force => force
-        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::GripValue)],             m_gripActivation.value, 0);
-        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::GripForce)],             m_gripActivation.value, 0);
+        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::GripValue)],             m_gripActivation.value, sampleTimeOffset);
+        vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::GripForce)],             m_gripActivation.value, sampleTimeOffset);
         // vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TrackpadForce)], m_thumbActivation.value, 0);
         // vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TrackpadX)], 0, 0);
         // vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::TrackpadY)], m_thumbActivation.value * -1, 0);
 
         // Finger curl for knuckles emu to work
         if (updateState.useCurl) {
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerThumb)],       m_curlThumb, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerIndex)],       m_curlIndex, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerMiddle)],      m_curlMiddle, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerRing)],        m_curlRing, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerPinky)],       m_curlPinky, 0);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerThumb)],       m_curlThumb, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerIndex)],       m_curlIndex, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerMiddle)],      m_curlMiddle, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerRing)],        m_curlRing, sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerPinky)],       m_curlPinky, sampleTimeOffset);
         }
         else {
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerThumb)],       updateState.thumbRoot, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerIndex)],       updateState.indexRoot, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerMiddle)],      updateState.middleRoot, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerRing)],        updateState.ringRoot, 0);
-            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerPinky)],       updateState.pinkyRoot, 0);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerThumb)],       joints[protocol::GloveJointThumbRoot], sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerIndex)],       joints[protocol::GloveJointIndexRoot], sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerMiddle)],      joints[protocol::GloveJointMiddleRoot], sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerRing)],        joints[protocol::GloveJointRingRoot], sampleTimeOffset);
+            vr::VRDriverInput()->UpdateScalarComponent(m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::FingerPinky)],       joints[protocol::GloveJointPinkyRoot], sampleTimeOffset);
         }
 
         // Update the current input state
@@ -7,6 +7,7 @@
 #include "../ipc_protocol.hpp"
 #include "driverlog.hpp"
 #include "hand_simulation.hpp"
+#include "imu_prediction.hpp"
 
 class DeviceProvider;
 const double INPUT_FREQUENCY = 1000.0 / 90.0; // 90Hz input thread
@@ -55,8 +56,18 @@ private:
         bool isActive;
     };
 
+    // A gesture's thresholds, derived from the calibration
+    struct GestureThresholds {
+    public:
+        float activate;
+        float deactivate;
+        // 1 / (1 - deactivate), scales values past the deactivation threshold to [0, 1]
+        float scale;
+    };
+
 public:
-    ContactGloveDevice(DeviceProvider* devProvider, bool isLeft);
+    // Each dongle's gloves are a pair, pair 0 keeps the serials the driver always had so existing bindings still apply
+    ContactGloveDevice(DeviceProvider* devProvider, uint32_t glovePair, bool isLeft);
 
     vr::EVRInitError Activate(uint32_t unObjectId) override;
     void Deactivate() override;
@@ -69,17 +80,18 @@ public:
     // Steamvr Tick
     void Tick();
     void Update(const protocol::ContactGloveState_t& updateState);
-    void UpdateSkeletalInput(const protocol::ContactGloveState_t& updateState);
+    // Rebuilds what is derived from the calibration, if its generation differs from the one cached
+    void UpdateCalibration(const protocol::GloveCalibration_t& calibration);
+    void UpdateSkeletalInput(const protocol::ContactGloveState_t& updateState, const float (&joints)[protocol::GloveJoint_Count]);
     void UpdateInputs(const protocol::ContactGloveState_t& updateState);
     void SetupProps();
-    void ApproximateCurls(const protocol::ContactGloveState_t& updateState);
-    float ApproximateSingleFingerCurl(HandSkeletonBone metacarpal, HandSkeletonBone distal);
+    void ApproximateCurls(const protocol::ContactGloveState_t& updateState, const float (&joints)[protocol::GloveJoint_Count]);
 
     void PoseUpdateThread();
     void InputUpdateThread();
 
 private:
-    void HandleGesture(ThresholdState& param, const protocol::ContactGloveState_t::CalibrationData_t::GestureThreshold_t& thresholds, const float value);
+    void HandleGesture(ThresholdState& param, const GestureThresholds& thresholds, const float value);
 
 private:
     uint32_t m_deviceId;
@@ -123,9 +135,21 @@ private:
     vr::VRBoneTransform_t m_handTransforms[NUM_BONES];
     vr::VRInputComponentHandle_t m_inputComponentHandles[static_cast<int>(KnuckleDeviceComponentIndex_t::_Count)];
 
-    protocol::ContactGloveState_t::CalibrationData_t::PoseOffset_t m_poseOffset;
     protocol::ContactGloveState_t m_lastState;
 
+    // Derived from the overlay's calibration, written when a new generation arrives and read by the pose and input
+    // threads
+    std::mutex m_calibrationMutex;
+    uint32_t m_calibrationGeneration;
+    protocol::ContactGloveState_t::CalibrationData_t::PoseOffset_t m_poseOffset;
+    GestureThresholds m_thumbThresholds;
+    GestureThresholds m_triggerThresholds;
+    GestureThresholds m_gripThresholds;
+
     // Skeletal input simulation
     GloveHandSimulation m_handSimulation;
+
+    // Fed from glove updates, read by the pose thread
+    std::mutex m_imuPredictorMutex;
+    ImuOrientationPredictor m_imuPredictor;
 };
\ No newline at end of file
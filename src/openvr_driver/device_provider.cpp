@@ -1,5 +1,9 @@
 #include "device_provider.hpp"
 #include "interface_hook_injector.hpp"
+#include "../glove_state_delta.hpp"
+#include "../timestamp.hpp"
+
+#include <new>
 
 vr::EVRInitError DeviceProvider::Init(vr::IVRDriverContext* pDriverContext) {
     VR_INIT_SERVER_DRIVER_CONTEXT(pDriverContext);
@@ -7,6 +11,22 @@ vr::EVRInitError DeviceProvider::Init(vr::IVRDriverContext* pDriverContext) {
     LOG("FreeScuba::DeviceProvider::Init()");
 
     InjectHooks(this, pDriverContext);
+
+    // Created before the pipe is listening, so the overlay always finds it once it has connected
+    if (m_gloveStateRegion.Create(FREESCUBA_GLOVE_STATE_NAME, sizeof(GloveStateBlock_t))) {
+        m_gloveState = new (m_gloveStateRegion.Data()) GloveStateBlock_t();
+        m_gloveState->version = protocol::Version;
+    } else {
+        LOG("Failed to create the glove state block, glove updates will go through the pipe");
+    }
+    if (m_poseStreamRegion.Create(FREESCUBA_POSE_STREAM_NAME, sizeof(PoseStreamBlock_t))) {
+        PoseStreamBlock_t* poseStream = new (m_poseStreamRegion.Data()) PoseStreamBlock_t();
+        poseStream->version = protocol::Version;
+        m_poseStream.SetBlock(poseStream);
+    } else {
+        LOG("Failed to create the pose stream block, the overlay will have to request poses");
+    }
+
     m_server.Run();
 
     return vr::VRInitError_None;
@@ -15,6 +35,10 @@ vr::EVRInitError DeviceProvider::Init(vr::IVRDriverContext* pDriverContext) {
 void DeviceProvider::Cleanup() {
     LOG("ServerTrackedDeviceProvider::Cleanup()");
     m_server.Stop();
+    m_gloveState = nullptr;
+    m_gloveStateRegion.Close();
+    m_poseStream.SetBlock(nullptr);
+    m_poseStreamRegion.Close();
     DisableHooks();
     VR_CLEANUP_SERVER_DRIVER_CONTEXT();
 }
@@ -24,8 +48,13 @@ const char* const* DeviceProvider::GetInterfaceVersions() {
 }
 
 void DeviceProvider::RunFrame() {
-    m_leftGlove.Tick();
-    m_rightGlove.Tick();
+    PollGloveState();
+
+    for (const auto& pair : m_gloves) {
+        for (const std::unique_ptr<ContactGloveDevice>& glove : pair) {
+            glove->Tick();
+        }
+    }
 }
 
 bool DeviceProvider::ShouldBlockStandbyMode() {
@@ -40,11 +69,61 @@ void DeviceProvider::LeaveStandby() {
 
 }
 
-void DeviceProvider::HandleGloveUpdate(protocol::ContactGloveState_t updateState, bool isLeft) {
-    if (isLeft) {
-        m_leftGlove.Update(updateState);
-    } else {
-        m_rightGlove.Update(updateState);
+void DeviceProvider::HandleGloveUpdate(protocol::ContactGloveState_t updateState, uint32_t glovePair, bool isLeft) {
+    m_gloves[glovePair][isLeft ? protocol::LeftGlove : protocol::RightGlove]->Update(updateState);
+}
+
+void DeviceProvider::HandleGloveUpdate(const protocol::GloveStateDelta_t& delta, uint32_t glovePair, bool isLeft) {
+    const int glove = isLeft ? protocol::LeftGlove : protocol::RightGlove;
+    if (!delta.keyframe && !m_pipeGloveSynced[glovePair][glove]) {
+        return;
+    }
+
+    if (!ApplyGloveStateDelta(delta, m_pipeGloveState[glovePair][glove])) {
+        LOG("Malformed glove state delta for the %s glove of pair %u, waiting for the next keyframe", isLeft ? "left" : "right", glovePair);
+        m_pipeGloveSynced[glovePair][glove] = false;
+        return;
+    }
+    m_pipeGloveSynced[glovePair][glove] = true;
+
+    HandleGloveUpdate(m_pipeGloveState[glovePair][glove], glovePair, isLeft);
+}
+
+void DeviceProvider::HandleGloveCalibration(const protocol::GloveCalibration_t& calibration, uint32_t glovePair, bool isLeft) {
+    m_gloves[glovePair][isLeft ? protocol::LeftGlove : protocol::RightGlove]->UpdateCalibration(calibration);
+}
+
+void DeviceProvider::PollGloveState() {
+    if (m_gloveState == nullptr) {
+        return;
+    }
+
+    for (uint32_t pair = 0; pair < protocol::MAX_GLOVE_PAIRS; pair++) {
+        for (int glove = protocol::LeftGlove; glove <= protocol::RightGlove; glove++) {
+            // Calibration first, so a glove's state is never handled with calibration older than the overlay had for it
+            const SeqLock<protocol::GloveCalibration_t>& publishedCalibration = m_gloveState->calibrations[pair][glove];
+            const uint32_t calibrationSequence = publishedCalibration.Sequence();
+            if (calibrationSequence != m_gloveCalibrationSequence[pair][glove]) {
+                protocol::GloveCalibration_t calibration;
+                if (publishedCalibration.TryLoad(calibration)) {
+                    m_gloveCalibrationSequence[pair][glove] = calibrationSequence;
+                    HandleGloveCalibration(calibration, pair, glove == protocol::LeftGlove);
+                }
+            }
+
+            const SeqLock<protocol::ContactGloveState_t>& published = m_gloveState->gloves[pair][glove];
+            const uint32_t sequence = published.Sequence();
+            if (sequence == m_gloveStateSequence[pair][glove]) {
+                continue;
+            }
+
+            // Never wait on the overlay from SteamVR's thread, if it's mid write the update is picked up next frame
+            protocol::ContactGloveState_t updateState;
+            if (published.TryLoad(updateState)) {
+                m_gloveStateSequence[pair][glove] = sequence;
+                HandleGloveUpdate(updateState, pair, glove == protocol::LeftGlove);
+            }
+        }
     }
 }
 
@@ -53,9 +132,15 @@ bool DeviceProvider::HandleDevicePoseUpdated(uint32_t openVRID, vr::DriverPose_t
     m_poseCache[openVRID] = pose;
     m_poseMutex.exchange(false);
 
+    m_poseStream.Push(openVRID, pose);
+
     return true;
 }
 
+bool DeviceProvider::SubscribePoses(const protocol::PoseSubscription_t& subscription) {
+    return m_poseStream.Subscribe(subscription);
+}
+
 vr::DriverPose_t DeviceProvider::GetCachedPose(uint32_t trackedDeviceIndex) {
     m_poseMutex.exchange(true);
     vr::DriverPose_t pose = m_poseCache[trackedDeviceIndex];
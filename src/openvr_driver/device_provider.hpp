@@ -1,13 +1,18 @@
 #pragma once
 
+#include <memory>
 #include <mutex>
 
 #include "openvr_driver.h"
 #include "driverlog.hpp"
 #include "contactglove_device.hpp"
 #include "ipc_server.hpp"
+#include "pose_stream_writer.hpp"
+#include "../glove_state_block.hpp"
+#include "../pose_stream_block.hpp"
+#include "../shared_memory.hpp"
 
-class DeviceProvider : public vr::IServerTrackedDeviceProvider {
+class DeviceProvider : public vr::IServerTrackedDeviceProvider, public IIPCDriver {
 public:
     // Inherited via IServerTrackedDeviceProvider
     vr::EVRInitError Init(vr::IVRDriverContext* pDriverContext) override;
@@ -19,20 +24,53 @@ public:
     void LeaveStandby() override;
 
 public:
-    DeviceProvider() : m_server(this), m_poseMutex(false) { memset(m_poseCache, 0, sizeof m_poseCache); }
+    DeviceProvider() : m_server(this), m_poseMutex(false), m_gloveStateRegion(), m_gloveState(nullptr), m_gloveStateSequence{}, m_gloveCalibrationSequence{}, m_pipeGloveState{}, m_pipeGloveSynced{},
+        m_poseStreamRegion(), m_poseStream() {
+        memset(m_poseCache, 0, sizeof m_poseCache);
+        for (uint32_t pair = 0; pair < protocol::MAX_GLOVE_PAIRS; pair++) {
+            m_gloves[pair][protocol::LeftGlove] = std::make_unique<ContactGloveDevice>(this, pair, true);
+            m_gloves[pair][protocol::RightGlove] = std::make_unique<ContactGloveDevice>(this, pair, false);
+        }
+    }
 
     bool HandleDevicePoseUpdated(uint32_t openVRID, vr::DriverPose_t& pose);
 
-    void HandleGloveUpdate(protocol::ContactGloveState_t updateState, bool isLeft);
+    // glovePair must be below protocol::MAX_GLOVE_PAIRS
+    void HandleGloveUpdate(protocol::ContactGloveState_t updateState, uint32_t glovePair, bool isLeft);
+    // Glove updates over the pipe are deltas, applied in place to the last state the pipe delivered for that glove
+    void HandleGloveUpdate(const protocol::GloveStateDelta_t& delta, uint32_t glovePair, bool isLeft) override;
+    void HandleGloveCalibration(const protocol::GloveCalibration_t& calibration, uint32_t glovePair, bool isLeft) override;
 
-    vr::DriverPose_t GetCachedPose(uint32_t trackedDeviceIndex);
+    vr::DriverPose_t GetCachedPose(uint32_t trackedDeviceIndex) override;
+    // Starts pushing the poses of the subscribed devices to the pose stream block, replacing the previous subscription
+    bool SubscribePoses(const protocol::PoseSubscription_t& subscription) override;
+
+private:
+    // Applies whatever the overlay published to the glove state block since the last frame
+    void PollGloveState();
 
 private:
     Hekky::IPC::IPCServer m_server;
 
+    // Glove updates from the overlay. Updates can still come through the pipe if the overlay couldn't open the block
+    SharedMemoryRegion m_gloveStateRegion;
+    GloveStateBlock_t* m_gloveState;
+    uint32_t m_gloveStateSequence[protocol::MAX_GLOVE_PAIRS][2];
+    uint32_t m_gloveCalibrationSequence[protocol::MAX_GLOVE_PAIRS][2];
+
+    // Glove state rebuilt from pipe updates, indexed by glove pair then protocol::GloveDevice_t. Deltas are dropped
+    // until a keyframe has been applied
+    protocol::ContactGloveState_t m_pipeGloveState[protocol::MAX_GLOVE_PAIRS][2];
+    bool m_pipeGloveSynced[protocol::MAX_GLOVE_PAIRS][2];
+
+    // Poses the overlay subscribed to, pushed as devices update instead of the overlay asking for them
+    SharedMemoryRegion m_poseStreamRegion;
+    PoseStreamWriter m_poseStream;
+
     std::atomic_bool m_poseMutex;
     vr::DriverPose_t m_poseCache[vr::k_unMaxTrackedDeviceCount];
 
-    ContactGloveDevice m_leftGlove{ this, true };
-    ContactGloveDevice m_rightGlove{ this, false };
+    // One pair per dongle, indexed by glove pair then protocol::GloveDevice_t. A glove is only added to SteamVR once
+    // the overlay reports it connected
+    std::unique_ptr<ContactGloveDevice> m_gloves[protocol::MAX_GLOVE_PAIRS][2];
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "hand_simulation.hpp"
 #include "maths.hpp"
 
+#include <cmath>
+
 struct HandSimSplayableJoint
 {
     vr::HmdVector2_t swing = { 0.f, 0.f };
@@ -268,4 +270,63 @@ void GloveHandSimulation::ComputeSkeletonTransforms(vr::ETrackedControllerRole r
 
     // Now compute
     ComputeSkeletalTransforms(hand, out_transforms);
-}
\ No newline at end of file
+}
+
+// Approximates a curl value given a metacarpal bone, proximal bone and distal bone
+float ApproximateSingleFingerCurl(const vr::VRBoneTransform_t* transforms, HandSkeletonBone metacarpal, HandSkeletonBone distal) {
+
+    vr::HmdVector4_t metacarpalPos  = transforms[static_cast<short>(metacarpal)].position;
+    vr::HmdVector4_t proximalPos    = transforms[static_cast<short>(metacarpal) + 1].position;
+    vr::HmdVector4_t distalPos      = transforms[static_cast<short>(distal)].position;
+
+    // Compute absolute proximal position since bone positions are relative
+    proximalPos.v[0] = metacarpalPos.v[0] + proximalPos.v[0];
+    proximalPos.v[1] = metacarpalPos.v[1] + proximalPos.v[1];
+    proximalPos.v[2] = metacarpalPos.v[2] + proximalPos.v[2];
+
+    // Bone positions are relative, add them to compute the absolute position of the distal bone
+    for (int i = metacarpal; i <= distal; i++) {
+        vr::HmdVector4_t bonePosition = transforms[static_cast<short>(i)].position;
+        distalPos.v[0] = distalPos.v[0] + bonePosition.v[0];
+        distalPos.v[1] = distalPos.v[1] + bonePosition.v[1];
+        distalPos.v[2] = distalPos.v[2] + bonePosition.v[2];
+    }
+
+    // Compute the direction from the metacarpal to the proximal and distal
+    vr::HmdVector3_t proximalDir = {
+        .v = {
+            proximalPos.v[0] - metacarpalPos.v[0],
+            proximalPos.v[1] - metacarpalPos.v[1],
+            proximalPos.v[2] - metacarpalPos.v[2]
+        }
+    };
+
+    vr::HmdVector3_t distalDir = {
+        .v = {
+            distalPos.v[0] - metacarpalPos.v[0],
+            distalPos.v[1] - metacarpalPos.v[1],
+            distalPos.v[2] - metacarpalPos.v[2]
+        }
+    };
+
+    double distanceProximal = sqrt(
+        proximalDir.v[0] * proximalDir.v[0] +
+        proximalDir.v[1] * proximalDir.v[1] +
+        proximalDir.v[2] * proximalDir.v[2]);
+
+    double distanceDistal = sqrt(
+        distalDir.v[0] * distalDir.v[0] +
+        distalDir.v[1] * distalDir.v[1] +
+        distalDir.v[2] * distalDir.v[2]);
+
+    double dotProduct =
+        distalDir.v[0] / distanceProximal * distalDir.v[0] / distanceDistal +
+        distalDir.v[1] / distanceProximal * distalDir.v[1] / distanceDistal +
+        distalDir.v[2] / distanceProximal * distalDir.v[2] / distanceDistal;
+
+    // Now that we have the length we can compute the angle it's at
+    double angle = acos(dotProduct);
+    const double ninetyDeg = DegToRad(90.f);
+
+    return Clamp((float) (angle / ninetyDeg), -1.f, 1.f);
+}
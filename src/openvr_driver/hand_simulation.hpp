@@ -69,4 +69,8 @@ class GloveHandSimulation
 {
 public:
 	void ComputeSkeletonTransforms(vr::ETrackedControllerRole role, const GloveFingerCurls& curls, const GloveFingerSplays& splays, vr::VRBoneTransform_t* out_transforms);
-};
\ No newline at end of file
+};
+
+// Approximates a finger's curl (0 straight, 1 curled 90 degrees) from a skeleton's bone transforms, given the finger's
+// metacarpal and distal bones
+float ApproximateSingleFingerCurl(const vr::VRBoneTransform_t* transforms, HandSkeletonBone metacarpal, HandSkeletonBone distal);
@@ -0,0 +1,137 @@
+#define _USE_MATH_DEFINES
+
+#include "imu_prediction.hpp"
+#include "maths.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Gaps between IMU samples longer than this (dropouts) don't give a usable angular velocity
+constexpr double IMU_MAX_SAMPLE_GAP_SECONDS = 0.1;
+// Weight of the newest angular velocity estimate
+constexpr double IMU_VELOCITY_SMOOTHING = 0.5;
+// Never extrapolate by more than this in one prediction, radians
+constexpr double IMU_MAX_PREDICTION_ANGLE = 0.35;
+
+// The mounting is only refined while both the IMU and the pose rotate faster than this, radians/second, as the axes
+// of slow rotations are mostly noise
+constexpr double IMU_ALIGNMENT_MIN_SPEED = 1.0;
+// Fraction of the axis error corrected per update
+constexpr double IMU_ALIGNMENT_GAIN = 0.05;
+constexpr double IMU_ALIGNMENT_ERROR_SMOOTHING = 0.05;
+// Mean axis error below which the mounting is trusted, radians
+constexpr double IMU_ALIGNMENT_MAX_ERROR = 0.2;
+constexpr uint32_t IMU_ALIGNMENT_MIN_UPDATES = 100;
+
+static double Length(const vr::HmdVector3d_t& v) {
+    return std::sqrt(v.v[0] * v.v[0] + v.v[1] * v.v[1] + v.v[2] * v.v[2]);
+}
+
+static vr::HmdQuaternion_t Normalize(const vr::HmdQuaternion_t& q) {
+    const double length = std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (length <= 0.0) {
+        return HmdQuaternion_Identity;
+    }
+    return { q.w / length, q.x / length, q.y / length, q.z / length };
+}
+
+// Rotation of angle radians around a unit axis
+static vr::HmdQuaternion_t AxisAngle(const vr::HmdVector3d_t& axis, const double angle) {
+    const double s = std::sin(angle * 0.5);
+    return { std::cos(angle * 0.5), axis.v[0] * s, axis.v[1] * s, axis.v[2] * s };
+}
+
+ImuOrientationPredictor::ImuOrientationPredictor() {
+    Reset();
+}
+
+void ImuOrientationPredictor::Reset() {
+    m_lastOrientation   = HmdQuaternion_Identity;
+    m_lastTimestamp     = 0;
+    m_angularVelocity   = { 0.0, 0.0, 0.0 };
+    m_mounting          = HmdQuaternion_Identity;
+    m_alignmentError    = M_PI;
+    m_alignmentUpdates  = 0;
+}
+
+void ImuOrientationPredictor::AddSample(const vr::HmdQuaternion_t& orientation, const uint64_t timestamp) {
+    // The same sample is forwarded with every glove update until a newer one arrives
+    if (timestamp <= m_lastTimestamp) {
+        return;
+    }
+
+    const vr::HmdQuaternion_t current = Normalize(orientation);
+    const double dt = (timestamp - m_lastTimestamp) * 1e-9;
+
+    if (m_lastTimestamp != 0 && dt <= IMU_MAX_SAMPLE_GAP_SECONDS) {
+        // Rotation since the last sample, in the IMU's frame, taking the short way round
+        vr::HmdQuaternion_t delta = -m_lastOrientation * current;
+        if (delta.w < 0.0) {
+            delta = { -delta.w, -delta.x, -delta.y, -delta.z };
+        }
+
+        const vr::HmdVector3d_t axis = { delta.x, delta.y, delta.z };
+        const double sinHalfAngle = Length(axis);
+        // angle / sin(angle / 2), which tends to 2 for small rotations
+        const double scale = sinHalfAngle > 1e-9 ? 2.0 * std::atan2(sinHalfAngle, delta.w) / sinHalfAngle : 2.0;
+
+        for (int i = 0; i < 3; i++) {
+            const double velocity = axis.v[i] * scale / dt;
+            m_angularVelocity.v[i] = Lerp(m_angularVelocity.v[i], velocity, IMU_VELOCITY_SMOOTHING);
+        }
+    } else {
+        m_angularVelocity = { 0.0, 0.0, 0.0 };
+    }
+
+    m_lastOrientation   = current;
+    m_lastTimestamp     = timestamp;
+}
+
+void ImuOrientationPredictor::Align(const vr::HmdVector3d_t& poseAngularVelocity) {
+    const vr::HmdVector3d_t imuVelocity = m_angularVelocity * m_mounting;
+    const double imuSpeed = Length(imuVelocity);
+    const double poseSpeed = Length(poseAngularVelocity);
+    if (imuSpeed < IMU_ALIGNMENT_MIN_SPEED || poseSpeed < IMU_ALIGNMENT_MIN_SPEED) {
+        return;
+    }
+
+    const vr::HmdVector3d_t a = { imuVelocity.v[0] / imuSpeed, imuVelocity.v[1] / imuSpeed, imuVelocity.v[2] / imuSpeed };
+    const vr::HmdVector3d_t b = { poseAngularVelocity.v[0] / poseSpeed, poseAngularVelocity.v[1] / poseSpeed, poseAngularVelocity.v[2] / poseSpeed };
+
+    const vr::HmdVector3d_t cross = {
+        a.v[1] * b.v[2] - a.v[2] * b.v[1],
+        a.v[2] * b.v[0] - a.v[0] * b.v[2],
+        a.v[0] * b.v[1] - a.v[1] * b.v[0],
+    };
+    const double crossLength = Length(cross);
+    const double error = std::atan2(crossLength, a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2]);
+
+    m_alignmentError = Lerp(m_alignmentError, error, IMU_ALIGNMENT_ERROR_SMOOTHING);
+    m_alignmentUpdates++;
+
+    // Turn the mounting a little, so the IMU's axis moves towards the pose's. Opposite axes have no unique correction,
+    // later updates sort them out
+    if (crossLength > 1e-9) {
+        const vr::HmdVector3d_t correctionAxis = { cross.v[0] / crossLength, cross.v[1] / crossLength, cross.v[2] / crossLength };
+        m_mounting = Normalize(AxisAngle(correctionAxis, error * IMU_ALIGNMENT_GAIN) * m_mounting);
+    }
+}
+
+bool ImuOrientationPredictor::IsAligned() const {
+    return m_alignmentUpdates >= IMU_ALIGNMENT_MIN_UPDATES && m_alignmentError < IMU_ALIGNMENT_MAX_ERROR;
+}
+
+vr::HmdQuaternion_t ImuOrientationPredictor::Predict(const uint64_t now, const double horizon) const {
+    if (!IsAligned() || m_lastTimestamp == 0 || now < m_lastTimestamp || (now - m_lastTimestamp) * 1e-9 > IMU_STALE_SECONDS) {
+        return HmdQuaternion_Identity;
+    }
+
+    const vr::HmdVector3d_t velocity = m_angularVelocity * m_mounting;
+    const double speed = Length(velocity);
+    if (speed <= 1e-9) {
+        return HmdQuaternion_Identity;
+    }
+
+    const vr::HmdVector3d_t axis = { velocity.v[0] / speed, velocity.v[1] / speed, velocity.v[2] / speed };
+    return AxisAngle(axis, std::min(speed * horizon, IMU_MAX_PREDICTION_ANGLE));
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include "openvr_driver.h"
+
+// How far ahead of the shadow tracker's pose the glove's orientation is extrapolated
+constexpr double IMU_PREDICTION_HORIZON_SECONDS = 0.008;
+// IMU samples older than this are not used for prediction
+constexpr double IMU_STALE_SECONDS = 0.05;
+
+/// <summary>
+/// Short-horizon orientation predictor fed by the glove's IMU. The angular velocity is derived from successive IMU
+/// orientations, and mapped into the glove pose's frame through the IMU's mounting, which is learnt online by lining the
+/// IMU's rotation axis up with the shadow tracker's. Predictions are only made once the mounting has converged.
+/// </summary>
+class ImuOrientationPredictor {
+public:
+    ImuOrientationPredictor();
+
+    void Reset();
+
+    // An IMU orientation, and when it was received (see protocol::MonotonicTimestamp). Repeated samples are ignored
+    void AddSample(const vr::HmdQuaternion_t& orientation, const uint64_t timestamp);
+    // Refines the IMU's mounting against the pose's angular velocity, in the pose's local frame (radians/second)
+    void Align(const vr::HmdVector3d_t& poseAngularVelocity);
+
+    bool IsAligned() const;
+    // Rotation to compose on the right of the pose to extrapolate it by horizon seconds, or identity if the IMU is
+    // stale or not aligned yet
+    vr::HmdQuaternion_t Predict(const uint64_t now, const double horizon) const;
+
+private:
+    vr::HmdQuaternion_t m_lastOrientation;
+    uint64_t m_lastTimestamp;
+
+    // Smoothed angular velocity in the IMU's frame, radians/second
+    vr::HmdVector3d_t m_angularVelocity;
+
+    // Rotation from the IMU's frame to the glove pose's frame
+    vr::HmdQuaternion_t m_mounting;
+    // Smoothed angle between the mapped IMU rotation axis and the pose's, radians
+    double m_alignmentError;
+    uint32_t m_alignmentUpdates;
+};
@@ -73,76 +73,41 @@ private:
 
 #include <openvr_driver.h>
 #include "../ipc_protocol.hpp"
+#include "../ipc_request_dispatch.hpp"
+#include "../ipc_transport.hpp"
 
+#include <memory>
 #include <thread>
-#include <set>
-
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-
-class DeviceProvider;
 
 namespace Hekky {
 	namespace IPC {
 
-#define PIPE_TIMEOUT 5000
-#define PIPE_BUFFER_SIZE 4096
-
-		struct PipeBuffer {
-			uint8_t data[PIPE_BUFFER_SIZE];
-			uint64_t dataSize;
-		};
-
-		class IPCServer {
-
-			struct PipeInstance {
-				OVERLAPPED oOverlap;
-				HANDLE hPipeInst;
-				IPCServer* server;
-
-				union {
-					PipeBuffer readBuffer;
-					protocol::Request_t request;
-				};
-				union {
-					PipeBuffer writeBuffer;
-					protocol::Response_t response;
-				};
-			};
-
+		// Answers the overlay's requests on a thread of its own, see DispatchIPCRequest. How clients connect is up to the
+		// platform's transport
+		class IPCServer : public IIPCRequestHandler {
 		public:
-			IPCServer(DeviceProvider* driver) : m_driver(driver), m_connectEvent(INVALID_HANDLE_VALUE) {} // : driver(driver) {}
+			IPCServer(IIPCDriver* driver) : m_driver(driver) {}
 			~IPCServer();
 
 			void Run();
 			void Stop();
 
 		private:
-			void HandleRequest(PipeInstance* pipe); // pipeInst->server->HandleRequest(pipeInst->request, pipeInst->response);
-			// void HandleRequest(const protocol::Request& request, protocol::Response& response);
-
-			PipeInstance* CreatePipeInstance(HANDLE pipe);
-			void ClosePipeInstance(PipeInstance* pipeInst);
+			void OnConnected(IPCConnection_t& connection) override;
+			void OnDisconnected(IPCConnection_t& connection) override;
+			void HandleRequest(IPCConnection_t& connection) override;
 
 			static void RunThread(IPCServer* _this);
 
-			static BOOL CreateAndConnectInstance(LPOVERLAPPED lpoOverlap, HANDLE& pipe);
-			static BOOL ConnectToNewClient(HANDLE hPipe, LPOVERLAPPED lpo);
-
-			static VOID WINAPI CompletedWriteRoutine(DWORD dwErr, DWORD cbWritten, LPOVERLAPPED lpOverLap);
-			static VOID WINAPI CompletedReadRoutine(DWORD dwErr, DWORD cbBytesRead, LPOVERLAPPED lpOverLap);
-
 		private:
 
 			std::thread m_pipeThread;
 
 			bool running = false;
-			bool stop = false;
 
-			std::set<PipeInstance*> pipes;
-			HANDLE m_connectEvent;
+			std::unique_ptr<IIPCServerTransport> m_transport;
 
-			DeviceProvider* m_driver;
+			IIPCDriver* m_driver;
 		};
 	}
 }
\ No newline at end of file
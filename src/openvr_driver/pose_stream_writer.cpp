@@ -0,0 +1,54 @@
+#include "pose_stream_writer.hpp"
+
+PoseStreamWriter::PoseStreamWriter() : m_block(nullptr), m_generation(0), m_interval(0), m_lastPushGeneration{}, m_lastPush{} {
+    for (std::atomic<uint32_t>& subscription : m_subscription) {
+        subscription.store(0, std::memory_order_relaxed);
+    }
+}
+
+void PoseStreamWriter::SetBlock(PoseStreamBlock_t* block) {
+    m_block.store(block, std::memory_order_release);
+}
+
+bool PoseStreamWriter::Subscribe(const protocol::PoseSubscription_t& subscription) {
+    if (!HasBlock() || subscription.deviceCount > protocol::POSE_SUBSCRIPTION_MAX_DEVICES) {
+        return false;
+    }
+
+    // 0 means unsubscribed, so it is skipped when the generation wraps
+    m_generation = m_generation + 1 != 0 ? m_generation + 1 : 1;
+    m_interval.store(subscription.rateHz == 0 ? 0 : 1000000000ull / subscription.rateHz, std::memory_order_relaxed);
+
+    bool subscribed[vr::k_unMaxTrackedDeviceCount] = {};
+    for (uint32_t i = 0; i < subscription.deviceCount; i++) {
+        if (subscription.deviceIndices[i] < vr::k_unMaxTrackedDeviceCount) {
+            subscribed[subscription.deviceIndices[i]] = true;
+        }
+    }
+    for (uint32_t deviceIndex = 0; deviceIndex < vr::k_unMaxTrackedDeviceCount; deviceIndex++) {
+        m_subscription[deviceIndex].store(subscribed[deviceIndex] ? m_generation : 0, std::memory_order_release);
+    }
+
+    return true;
+}
+
+void PoseStreamWriter::Push(const uint32_t deviceIndex, const vr::DriverPose_t& pose) {
+    PoseStreamBlock_t* block = m_block.load(std::memory_order_acquire);
+    if (block == nullptr || deviceIndex >= vr::k_unMaxTrackedDeviceCount) {
+        return;
+    }
+
+    const uint32_t generation = m_subscription[deviceIndex].load(std::memory_order_acquire);
+    if (generation == 0) {
+        return;
+    }
+
+    const uint64_t now = protocol::MonotonicTimestamp();
+    if (generation == m_lastPushGeneration[deviceIndex] && now - m_lastPush[deviceIndex] < m_interval.load(std::memory_order_relaxed)) {
+        return;
+    }
+    m_lastPushGeneration[deviceIndex] = generation;
+    m_lastPush[deviceIndex] = now;
+
+    block->poses[deviceIndex].Store(StreamedPose_t{ deviceIndex, now, pose });
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "openvr_driver.h"
+#include "../pose_stream_block.hpp"
+
+/// <summary>
+/// The driver's side of the pose stream block. Subscribe is called from the IPC thread, and Push from whichever thread
+/// updated a device's pose. Each device has its own slot in the block, so however often the subscription changes, a
+/// slot's SeqLock is only ever written by the thread updating that device.
+/// </summary>
+class PoseStreamWriter {
+public:
+    PoseStreamWriter();
+
+    // Where poses are pushed to, nullptr stops pushing them
+    void SetBlock(PoseStreamBlock_t* block);
+    inline bool HasBlock() const { return m_block.load(std::memory_order_acquire) != nullptr; }
+
+    // Replaces the previous subscription. Returns false if there is no block or the subscription is invalid
+    bool Subscribe(const protocol::PoseSubscription_t& subscription);
+    // Pushes the device's pose if it is subscribed to, and its last push was at least the subscription's interval ago
+    void Push(const uint32_t deviceIndex, const vr::DriverPose_t& pose);
+
+private:
+    std::atomic<PoseStreamBlock_t*> m_block;
+
+    // Subscription each device belongs to, 0 when it isn't subscribed to. Each subscription has a new generation, so a
+    // device's first pose after subscribing is never held back by the previous subscription's interval
+    std::atomic<uint32_t> m_subscription[vr::k_unMaxTrackedDeviceCount];
+    uint32_t m_generation;
+    // Nanoseconds, see protocol::MonotonicTimestamp
+    std::atomic<uint64_t> m_interval;
+
+    // Only touched by the thread updating the device
+    uint32_t m_lastPushGeneration[vr::k_unMaxTrackedDeviceCount];
+    uint64_t m_lastPush[vr::k_unMaxTrackedDeviceCount];
+};
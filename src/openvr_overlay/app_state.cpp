@@ -3,86 +3,111 @@
 AppState::AppState() {
 
     doAutoLaunch                                        = true;
+    dongleCount                                         = 0;
+    donglesConnected                                    = 0;
     dongleAvailable                                     = false;
-    gloveLeft                                           = {};
-    gloveRight                                          = {};
+    dongleFramesPerRead                                 = 0.0;
+    donglePacketQueueDepth                              = 0;
+    dongleDroppedPackets                                = 0;
+    dongleLinkStatistics                                = {};
+    dongleFramesPerSecond                               = 0.0;
+    dongleCaptureEnabled                                = false;
+    selectedDongle                                      = 0;
     uiState                                             = {};
     ipcClient                                           = nullptr;
+    poseStream                                          = nullptr;
 
-    uiState.leftGloveBatteryBuffer.Init(BATTERY_WINDOW_SIZE);
-    uiState.rightGloveBatteryBuffer.Init(BATTERY_WINDOW_SIZE);
-
-    // Joystick calibration must initially set mins to max value
-    gloveLeft.calibration.joystick.XMax                 = 62000;
-    gloveLeft.calibration.joystick.XMin                 = 18000;
-    gloveLeft.calibration.joystick.YMax                 = 55000;
-    gloveLeft.calibration.joystick.YMin                 = 8000;
-    gloveLeft.calibration.joystick.forwardAngle         = -0.20632386207580566;
-    
-    // Default calibration for right glove joystick
-    gloveRight.calibration.joystick.XMax                = 62000;
-    gloveRight.calibration.joystick.XMin                = 14000;
-    gloveRight.calibration.joystick.YMax                = 59000;
-    gloveRight.calibration.joystick.YMin                = 11000;
-    gloveRight.calibration.joystick.forwardAngle        = -3.0471484661102295f;
-
-    // Default deadzone
-    gloveLeft.calibration.joystick.threshold            = 0.1f;
-    gloveRight.calibration.joystick.threshold           = 0.1f;
-
-    // Default finger calibration
-    gloveLeft.calibration.fingers.thumb.proximal.close  = 0xFFFF;
-    gloveLeft.calibration.fingers.thumb.distal.close    = 0xFFFF;
-    gloveLeft.calibration.fingers.index.proximal.close  = 0xFFFF;
-    gloveLeft.calibration.fingers.index.distal.close    = 0xFFFF;
-    gloveLeft.calibration.fingers.middle.proximal.close = 0xFFFF;
-    gloveLeft.calibration.fingers.middle.distal.close   = 0xFFFF;
-    gloveLeft.calibration.fingers.ring.proximal.close   = 0xFFFF;
-    gloveLeft.calibration.fingers.ring.distal.close     = 0xFFFF;
-    gloveLeft.calibration.fingers.pinky.proximal.close  = 0xFFFF;
-    gloveLeft.calibration.fingers.pinky.distal.close    = 0xFFFF;
-
-    // Default pose calibration for left glove
-    gloveLeft.calibration.poseOffset.pos.v[0]           =  0.022108916431138825;
-    gloveLeft.calibration.poseOffset.pos.v[1]           = -0.10298597531413284;
-    gloveLeft.calibration.poseOffset.pos.v[2]           = -0.043071794351218051;
-
-    gloveLeft.calibration.poseOffset.rot.w              =  0.79839363620734938;
-    gloveLeft.calibration.poseOffset.rot.x              =  0.56994138349383228;
-    gloveLeft.calibration.poseOffset.rot.y              = -0.0095891559420182571;
-    gloveLeft.calibration.poseOffset.rot.z              =  0.1940166723069508;
-
-    // Default pose calibration for right glove
-    gloveRight.calibration.poseOffset.pos.v[0]          =  0.014676248807481751;
-    gloveRight.calibration.poseOffset.pos.v[1]          =  0.12989163327871586;
-    gloveRight.calibration.poseOffset.pos.v[2]          = -0.07395779910121722;
-
-    gloveRight.calibration.poseOffset.rot.w             =  0.74633244094972939;
-    gloveRight.calibration.poseOffset.rot.x             = -0.61839448536096064;
-    gloveRight.calibration.poseOffset.rot.y             =  0.15040583272822428;
-    gloveRight.calibration.poseOffset.rot.z             = -0.19481846304316558;
-
-    // Default gesture values for left glove
-    gloveLeft.calibration.gestures.grip.activate        = 0.508f;
-    gloveLeft.calibration.gestures.grip.deactivate      = 0.644f;
-    gloveLeft.calibration.gestures.thumb.activate       = 0.757f;
-    gloveLeft.calibration.gestures.thumb.deactivate     = 0.757f;
-    gloveLeft.calibration.gestures.trigger.activate     = 0.850f;
-    gloveLeft.calibration.gestures.trigger.deactivate   = 0.722f;
-
-    // Default gesture values for right glove
-    gloveRight.calibration.gestures.grip.activate       = 0.551f;
-    gloveRight.calibration.gestures.grip.deactivate     = 0.683f;
-    gloveRight.calibration.gestures.thumb.activate      = 0.757f;
-    gloveRight.calibration.gestures.thumb.deactivate    = 0.757f;
-    gloveRight.calibration.gestures.trigger.activate    = 0.850f;
-    gloveRight.calibration.gestures.trigger.deactivate  = 0.722f;
-
-    // Default battery life
-    gloveLeft.gloveBattery                              = protocol::GLOVE_BATTERY_INVALID;
-    gloveLeft.gloveBatteryRaw                           = protocol::GLOVE_BATTERY_INVALID;
-    gloveRight.gloveBattery                             = protocol::GLOVE_BATTERY_INVALID;
-    gloveRight.gloveBatteryRaw                          = protocol::GLOVE_BATTERY_INVALID;
+    uiState.subscribedPoseDevice                        = CONTACT_GLOVE_INVALID_DEVICE_ID;
+
+    // Every pair starts from the same defaults, until the configuration is loaded
+    for (GlovePair_t& glovePair : glovePairs) {
+        glovePair.left                                           = {};
+        glovePair.right                                          = {};
+        glovePair.driverCalibration[protocol::LeftGlove]         = {};
+        glovePair.driverCalibration[protocol::RightGlove]        = {};
+        glovePair.leftBatteryBuffer.Init(BATTERY_WINDOW_SIZE);
+        glovePair.rightBatteryBuffer.Init(BATTERY_WINDOW_SIZE);
+
+        // Joystick calibration must initially set mins to max value
+        glovePair.left.calibration.joystick.XMax                 = 62000;
+        glovePair.left.calibration.joystick.XMin                 = 18000;
+        glovePair.left.calibration.joystick.YMax                 = 55000;
+        glovePair.left.calibration.joystick.YMin                 = 8000;
+        glovePair.left.calibration.joystick.forwardAngle         = -0.20632386207580566;
+
+        // Default calibration for right glove joystick
+        glovePair.right.calibration.joystick.XMax                = 62000;
+        glovePair.right.calibration.joystick.XMin                = 14000;
+        glovePair.right.calibration.joystick.YMax                = 59000;
+        glovePair.right.calibration.joystick.YMin                = 11000;
+        glovePair.right.calibration.joystick.forwardAngle        = -3.0471484661102295f;
+
+        // Default deadzone
+        glovePair.left.calibration.joystick.threshold            = 0.1f;
+        glovePair.right.calibration.joystick.threshold           = 0.1f;
+
+        // Default finger calibration
+        glovePair.left.calibration.fingers.thumb.proximal.close  = 0xFFFF;
+        glovePair.left.calibration.fingers.thumb.distal.close    = 0xFFFF;
+        glovePair.left.calibration.fingers.index.proximal.close  = 0xFFFF;
+        glovePair.left.calibration.fingers.index.distal.close    = 0xFFFF;
+        glovePair.left.calibration.fingers.middle.proximal.close = 0xFFFF;
+        glovePair.left.calibration.fingers.middle.distal.close   = 0xFFFF;
+        glovePair.left.calibration.fingers.ring.proximal.close   = 0xFFFF;
+        glovePair.left.calibration.fingers.ring.distal.close     = 0xFFFF;
+        glovePair.left.calibration.fingers.pinky.proximal.close  = 0xFFFF;
+        glovePair.left.calibration.fingers.pinky.distal.close    = 0xFFFF;
+
+        // Default pose calibration for left glove
+        glovePair.left.calibration.poseOffset.pos.v[0]           =  0.022108916431138825;
+        glovePair.left.calibration.poseOffset.pos.v[1]           = -0.10298597531413284;
+        glovePair.left.calibration.poseOffset.pos.v[2]           = -0.043071794351218051;
+
+        glovePair.left.calibration.poseOffset.rot.w              =  0.79839363620734938;
+        glovePair.left.calibration.poseOffset.rot.x              =  0.56994138349383228;
+        glovePair.left.calibration.poseOffset.rot.y              = -0.0095891559420182571;
+        glovePair.left.calibration.poseOffset.rot.z              =  0.1940166723069508;
+
+        // Default pose calibration for right glove
+        glovePair.right.calibration.poseOffset.pos.v[0]          =  0.014676248807481751;
+        glovePair.right.calibration.poseOffset.pos.v[1]          =  0.12989163327871586;
+        glovePair.right.calibration.poseOffset.pos.v[2]          = -0.07395779910121722;
+
+        glovePair.right.calibration.poseOffset.rot.w             =  0.74633244094972939;
+        glovePair.right.calibration.poseOffset.rot.x             = -0.61839448536096064;
+        glovePair.right.calibration.poseOffset.rot.y             =  0.15040583272822428;
+        glovePair.right.calibration.poseOffset.rot.z             = -0.19481846304316558;
+
+        // Default gesture values for left glove
+        glovePair.left.calibration.gestures.grip.activate        = 0.508f;
+        glovePair.left.calibration.gestures.grip.deactivate      = 0.644f;
+        glovePair.left.calibration.gestures.thumb.activate       = 0.757f;
+        glovePair.left.calibration.gestures.thumb.deactivate     = 0.757f;
+        glovePair.left.calibration.gestures.trigger.activate     = 0.850f;
+        glovePair.left.calibration.gestures.trigger.deactivate   = 0.722f;
+
+        // Default gesture values for right glove
+        glovePair.right.calibration.gestures.grip.activate       = 0.551f;
+        glovePair.right.calibration.gestures.grip.deactivate     = 0.683f;
+        glovePair.right.calibration.gestures.thumb.activate      = 0.757f;
+        glovePair.right.calibration.gestures.thumb.deactivate    = 0.757f;
+        glovePair.right.calibration.gestures.trigger.activate    = 0.850f;
+        glovePair.right.calibration.gestures.trigger.deactivate  = 0.722f;
+
+        // Default battery life
+        glovePair.left.gloveBattery                              = protocol::GLOVE_BATTERY_INVALID;
+        glovePair.left.gloveBatteryRaw                           = protocol::GLOVE_BATTERY_INVALID;
+        glovePair.right.gloveBattery                             = protocol::GLOVE_BATTERY_INVALID;
+        glovePair.right.gloveBatteryRaw                          = protocol::GLOVE_BATTERY_INVALID;
+    }
+
+    // Nothing has been received from the gloves yet
+    GloveInputSnapshot_t noInput                        = {};
+    noInput.batteryRaw                                  = protocol::GLOVE_BATTERY_INVALID;
+    for (DongleInput_t& dongle : dongleInputs) {
+        dongle.gloveLeft.Store(noInput);
+        dongle.gloveRight.Store(noInput);
+    }
 
     // Finger calibration state
     uiState.targetFinger                                = CalibrationFinger_t::Finger_Thumb;
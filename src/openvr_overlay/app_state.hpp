@@ -1,13 +1,19 @@
 #pragma once
 
 #include "contact_glove/serial_communication.hpp"
+#include "glove_state.hpp"
 #include "ipc_client.hpp"
 #include "ring_buffer.hpp"
+#include "../pose_stream_block.hpp"
+#include "../seqlock.hpp"
 #include <openvr.h>
 
 // #define BATTERY_WINDOW_SIZE 128
 constexpr uint8_t BATTERY_WINDOW_SIZE = 128;
 
+// Most dongles (each with its own pair of gloves) serviced at once, each forwarded to its own pair of driver devices
+constexpr size_t MAX_DONGLES = protocol::MAX_GLOVE_PAIRS;
+
 enum class ScreenState_t {
     ScreenStateViewData,
     ScreenStateCalibrateJoystick,
@@ -48,16 +54,74 @@ enum class CalibrationFinger_t {
     Finger_Pinky,
 };
 
+// Raw input from a single glove, as last received from the dongle
+struct GloveInputSnapshot_t {
+    // When each part was last received, see protocol::MonotonicTimestamp. 0 if it never was
+    uint64_t inputTimestamp;
+    uint64_t fingersTimestamp;
+    uint64_t imuTimestamp;
+    // Last packet which proves the glove is connected
+    uint64_t lastSeenTimestamp;
+
+    GloveInputData_t input;
+    GlovePacketFingers_t fingers;
+    GlovePacketImu_t imu;
+
+    uint8_t batteryRaw;
+    uint8_t firmwareMajor;
+    uint8_t firmwareMinor;
+};
+
+// Raw input from the pair of gloves paired with a single dongle, published by the serial dispatch thread
+struct DongleInput_t {
+    SeqLock<GloveInputSnapshot_t> gloveLeft;
+    SeqLock<GloveInputSnapshot_t> gloveRight;
+};
+
+// Protocol state for the pair of gloves paired with a single dongle. Only touched by the UI thread
+struct GlovePair_t {
+    GloveState_t left;
+    GloveState_t right;
+    MostCommonElementRingBuffer leftBatteryBuffer;
+    MostCommonElementRingBuffer rightBatteryBuffer;
+    // Calibration last sent to the driver, indexed by protocol::GloveDevice_t
+    protocol::GloveCalibration_t driverCalibration[2];
+};
+
 struct AppState {
 public:
     AppState();
 
-    // Protocol state
-    protocol::ContactGloveState_t gloveLeft;
-    protocol::ContactGloveState_t gloveRight;
+    // Raw glove input for each dongle, indexed like the serial reactor's dongles. Each dongle's input is copied into
+    // its glove pair once per frame
+    DongleInput_t dongleInputs[MAX_DONGLES];
+    size_t dongleCount;
+    size_t donglesConnected;
+
+    // Indexed like dongleInputs, each pair is forwarded to the driver as its own devices
+    GlovePair_t glovePairs[MAX_DONGLES];
+    // The dongle whose gloves the UI shows and calibrates, below dongleCount once any dongle was found
+    size_t selectedDongle;
+
+    inline GloveState_t& GloveLeft() { return glovePairs[selectedDongle].left; }
+    inline GloveState_t& GloveRight() { return glovePairs[selectedDongle].right; }
+
+    // Statistics for the selected dongle
     bool dongleAvailable;
+    // Average number of frames the serial thread extracts per read call
+    double dongleFramesPerRead;
+    // Decoded packets waiting to be processed, and packets dropped because processing fell behind
+    size_t donglePacketQueueDepth;
+    uint64_t dongleDroppedPackets;
+    // Link quality, refreshed about once a second
+    LinkStatistics_t dongleLinkStatistics;
+    double dongleFramesPerSecond;
+    // Whether every dongle's raw link is being captured to a file, toggled from the UI
+    bool dongleCaptureEnabled;
 
     IPCClient* ipcClient;
+    // Poses the driver pushes for the devices we subscribed to, nullptr if the block couldn't be opened
+    const PoseStreamBlock_t* poseStream;
 
     // For the SteamVR Overlay
     bool doAutoLaunch;
@@ -76,9 +140,6 @@ public:
 
         CalibrationFinger_t targetFinger;
 
-        MostCommonElementRingBuffer leftGloveBatteryBuffer;
-        MostCommonElementRingBuffer rightGloveBatteryBuffer;
-
         // For joystick calibration
         uint16_t joystickForwardX;
         uint16_t joystickForwardY;
@@ -103,5 +164,9 @@ public:
 
         vr::HmdVector3d_t initialTrackerPos;
         vr::HmdQuaternion_t initialTrackerRot;
+
+        // Device whose pose is being streamed for pose offset calibration, and when it was subscribed to
+        uint32_t subscribedPoseDevice;
+        uint64_t poseSubscriptionTime;
     } uiState;
 };
\ No newline at end of file
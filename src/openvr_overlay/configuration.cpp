@@ -1,6 +1,8 @@
 #include "configuration.hpp"
 
 #include <picojson.h>
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
 #include <shlobj_core.h>
 #include <locale>
 #include <codecvt>
@@ -49,6 +51,11 @@ inline void TryReadUint16(uint16_t& propToWriteTo, picojson::object objectToRead
 	} catch (std::runtime_error) {}
 }
 
+// The first dongle's gloves keep the keys they always had, so older configs still load
+static std::string GlovePairConfigKey(const char* hand, const size_t glovePair) {
+	return glovePair == 0 ? std::string(hand) : std::string(hand) + "_" + std::to_string(glovePair + 1);
+}
+
 void ReadPoseOffset(protocol::ContactGloveState_t::CalibrationData_t::PoseOffset_t& state, picojson::object& jsonObj) {
 
 	try {
@@ -193,25 +200,29 @@ void LoadConfiguration(AppState& state) {
 			// } catch (std::runtime_error) {}
 			TryReadBool(state.doAutoLaunch, rootObj, "doAutoLaunch");
 
-			// Load left glove config
-			try {
-				auto leftGloveObj = rootObj["left"].get<picojson::object>();
-		
-				ReadPoseOffset(state.gloveLeft.calibration.poseOffset, leftGloveObj);
-				ReadJoystickCalibration(state.gloveLeft.calibration.joystick, leftGloveObj);
-				ReadFingersCalibration(state.gloveLeft.calibration.fingers, leftGloveObj);
-				ReadGestures(state.gloveLeft.calibration.gestures, leftGloveObj);
-			} catch (std::runtime_error) {}
-
-			// Load right glove config
-			try {
-				auto rightGloveObj = rootObj["right"].get<picojson::object>();
-		
-				ReadPoseOffset(state.gloveRight.calibration.poseOffset, rightGloveObj);
-				ReadJoystickCalibration(state.gloveRight.calibration.joystick, rightGloveObj);
-				ReadFingersCalibration(state.gloveRight.calibration.fingers, rightGloveObj);
-				ReadGestures(state.gloveRight.calibration.gestures, rightGloveObj);
-			} catch (std::runtime_error) {}
+			for (size_t pair = 0; pair < MAX_DONGLES; pair++) {
+				GlovePair_t& glovePair = state.glovePairs[pair];
+
+				// Load left glove config
+				try {
+					auto leftGloveObj = rootObj[GlovePairConfigKey("left", pair)].get<picojson::object>();
+
+					ReadPoseOffset(glovePair.left.calibration.poseOffset, leftGloveObj);
+					ReadJoystickCalibration(glovePair.left.calibration.joystick, leftGloveObj);
+					ReadFingersCalibration(glovePair.left.calibration.fingers, leftGloveObj);
+					ReadGestures(glovePair.left.calibration.gestures, leftGloveObj);
+				} catch (std::runtime_error) {}
+
+				// Load right glove config
+				try {
+					auto rightGloveObj = rootObj[GlovePairConfigKey("right", pair)].get<picojson::object>();
+
+					ReadPoseOffset(glovePair.right.calibration.poseOffset, rightGloveObj);
+					ReadJoystickCalibration(glovePair.right.calibration.joystick, rightGloveObj);
+					ReadFingersCalibration(glovePair.right.calibration.fingers, rightGloveObj);
+					ReadGestures(glovePair.right.calibration.gestures, rightGloveObj);
+				} catch (std::runtime_error) {}
+			}
 
 		} catch (std::runtime_error){}
 		
@@ -326,24 +337,28 @@ void SaveConfiguration(AppState& state) {
 
 		picojson::object config;
 
-		picojson::object gloveLeftConfig;
+		for (size_t pair = 0; pair < MAX_DONGLES; pair++) {
+			GlovePair_t& glovePair = state.glovePairs[pair];
 
-		// Write props
-		WritePoseCalibration(state.gloveLeft.calibration.poseOffset, gloveLeftConfig);
-		WriteJoystickCalibration(state.gloveLeft.calibration.joystick, gloveLeftConfig);
-		WriteFingersCalibration(state.gloveLeft.calibration.fingers, gloveLeftConfig);
-		WriteThresholds(state.gloveLeft.calibration.gestures, gloveLeftConfig);
+			picojson::object gloveLeftConfig;
 
-		picojson::object gloveRightConfig;
-		
-		// Write props
-		WritePoseCalibration(state.gloveRight.calibration.poseOffset, gloveRightConfig);
-		WriteJoystickCalibration(state.gloveRight.calibration.joystick, gloveRightConfig);
-		WriteFingersCalibration(state.gloveRight.calibration.fingers, gloveRightConfig);
-		WriteThresholds(state.gloveRight.calibration.gestures, gloveRightConfig);
-
-		config["left"].set<picojson::object>(gloveLeftConfig);
-		config["right"].set<picojson::object>(gloveRightConfig);
+			// Write props
+			WritePoseCalibration(glovePair.left.calibration.poseOffset, gloveLeftConfig);
+			WriteJoystickCalibration(glovePair.left.calibration.joystick, gloveLeftConfig);
+			WriteFingersCalibration(glovePair.left.calibration.fingers, gloveLeftConfig);
+			WriteThresholds(glovePair.left.calibration.gestures, gloveLeftConfig);
+
+			picojson::object gloveRightConfig;
+
+			// Write props
+			WritePoseCalibration(glovePair.right.calibration.poseOffset, gloveRightConfig);
+			WriteJoystickCalibration(glovePair.right.calibration.joystick, gloveRightConfig);
+			WriteFingersCalibration(glovePair.right.calibration.fingers, gloveRightConfig);
+			WriteThresholds(glovePair.right.calibration.gestures, gloveRightConfig);
+
+			config[GlovePairConfigKey("left", pair)].set<picojson::object>(gloveLeftConfig);
+			config[GlovePairConfigKey("right", pair)].set<picojson::object>(gloveRightConfig);
+		}
 
 		// Write do automatic launch
 		config["doAutoLaunch"].set<bool>(state.doAutoLaunch);
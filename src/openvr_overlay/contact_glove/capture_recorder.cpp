@@ -0,0 +1,139 @@
+#include "capture_recorder.hpp"
+#include "../../timestamp.hpp"
+
+#include <cstring>
+
+static_assert((CAPTURE_BUFFER_SIZE & (CAPTURE_BUFFER_SIZE - 1)) == 0, "CAPTURE_BUFFER_SIZE must be a power of 2!");
+
+constexpr size_t CAPTURE_BUFFER_MASK = CAPTURE_BUFFER_SIZE - 1;
+
+CaptureRecorder::CaptureRecorder()
+	: m_buffer(new uint8_t[CAPTURE_BUFFER_SIZE]), m_write(0), m_read(0), m_recording(false), m_writerSignal(0), m_file(nullptr),
+	  m_recorded(0), m_dropped(0) {}
+
+CaptureRecorder::~CaptureRecorder() {
+	Stop();
+	delete[] m_buffer;
+}
+
+bool CaptureRecorder::Start(const std::string& path) {
+	if (IsRecording()) {
+		return false;
+	}
+
+	m_file = fopen(path.c_str(), "wb");
+	if (m_file == nullptr) {
+		printf("Failed to create capture file %s\n", path.c_str());
+		return false;
+	}
+
+	CaptureFileHeader_t header = {};
+	memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+	header.version			= CAPTURE_VERSION;
+	header.headerSize		= sizeof(CaptureFileHeader_t);
+	header.startTimestamp	= protocol::MonotonicTimestamp();
+	fwrite(&header, sizeof(header), 1, m_file);
+
+	// Skip anything left over from the previous capture. The writer thread isn't running, so we own the read side
+	m_read.store(m_write.load(std::memory_order_acquire), std::memory_order_release);
+	m_recorded	= 0;
+	m_dropped	= 0;
+
+	m_recording.store(true, std::memory_order_release);
+	m_writerThread = std::thread(&CaptureRecorder::WriterThread, this);
+
+	printf("Started capture to %s\n", path.c_str());
+	return true;
+}
+
+void CaptureRecorder::Stop() {
+	if (!m_recording.exchange(false)) {
+		return;
+	}
+
+	m_writerSignal.fetch_add(1, std::memory_order_release);
+	m_writerSignal.notify_one();
+	m_writerThread.join();
+
+	fclose(m_file);
+	m_file = nullptr;
+
+	printf("Stopped capture, %llu frames recorded, %llu dropped\n", (unsigned long long)RecordedFrames(), (unsigned long long)DroppedFrames());
+}
+
+void CaptureRecorder::Append(const uint8_t* data, const size_t size, size_t& position) {
+	const size_t index		= position & CAPTURE_BUFFER_MASK;
+	const size_t untilWrap	= CAPTURE_BUFFER_SIZE - index;
+	const size_t first		= size < untilWrap ? size : untilWrap;
+
+	memcpy(&m_buffer[index], data, first);
+	memcpy(&m_buffer[0], data + first, size - first);
+	position += size;
+}
+
+void CaptureRecorder::Record(const uint64_t timestamp, const RawFrame_t& raw, const FrameStatus_t status, const crc checksum) {
+	if (!IsRecording()) {
+		return;
+	}
+
+	const size_t recordSize	= CAPTURE_RECORD_HEADER_SIZE + raw.size();
+	size_t position			= m_write.load(std::memory_order_relaxed);
+
+	if (CAPTURE_BUFFER_SIZE - (position - m_read.load(std::memory_order_acquire)) < recordSize) {
+		m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		return;
+	}
+
+	uint8_t header[CAPTURE_RECORD_HEADER_SIZE] = {};
+	const uint16_t length = static_cast<uint16_t>(raw.size());
+	memcpy(&header[0], &timestamp, sizeof(timestamp));
+	memcpy(&header[8], &length, sizeof(length));
+	header[10] = static_cast<uint8_t>(status);
+	header[11] = checksum;
+
+	Append(header, sizeof(header), position);
+	Append(raw.first.data(), raw.first.size(), position);
+	Append(raw.second.data(), raw.second.size(), position);
+
+	// Publish the whole record at once, so the writer never sees half of one
+	m_write.store(position, std::memory_order_release);
+	m_recorded.store(m_recorded.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void CaptureRecorder::Commit() {
+	if (!IsRecording()) {
+		return;
+	}
+
+	m_writerSignal.fetch_add(1, std::memory_order_release);
+	m_writerSignal.notify_one();
+}
+
+void CaptureRecorder::WriterThread() {
+	while (true) {
+		const uint32_t signal	= m_writerSignal.load(std::memory_order_acquire);
+		const bool recording	= IsRecording();
+
+		// Write everything published so far, in at most two contiguous chunks
+		const size_t write	= m_write.load(std::memory_order_acquire);
+		size_t read			= m_read.load(std::memory_order_relaxed);
+		while (read != write) {
+			const size_t index		= read & CAPTURE_BUFFER_MASK;
+			const size_t untilWrap	= CAPTURE_BUFFER_SIZE - index;
+			const size_t available	= write - read;
+			const size_t chunk		= available < untilWrap ? available : untilWrap;
+
+			fwrite(&m_buffer[index], 1, chunk, m_file);
+			read += chunk;
+			m_read.store(read, std::memory_order_release);
+		}
+
+		if (!recording) {
+			fflush(m_file);
+			return;
+		}
+
+		// Sleep until the serial thread commits more frames
+		m_writerSignal.wait(signal, std::memory_order_acquire);
+	}
+}
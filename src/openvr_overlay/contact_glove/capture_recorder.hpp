@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "crc.hpp"
+#include "packet_framer.hpp"
+
+/*
+Capture file format, little endian:
+
+	CaptureFileHeader_t
+	Records, each one CAPTURE_RECORD_HEADER_SIZE bytes followed by the raw frame:
+	    uint64_t    timestamp   Monotonic receive time in nanoseconds, see protocol::MonotonicTimestamp
+	    uint16_t    length      Number of raw bytes following the record header
+	    uint8_t     status      FrameStatus_t
+	    uint8_t     checksum    CRC of the decoded frame, CRC_RESULT_OK if it is intact
+	    uint8_t     raw[length] The frame as it was received: COBS encoded, without the 0x00 delimiter
+*/
+
+constexpr char CAPTURE_MAGIC[4]             = { 'F', 'S', 'C', 'P' };
+constexpr uint16_t CAPTURE_VERSION          = 1;
+constexpr size_t CAPTURE_RECORD_HEADER_SIZE = 12;
+
+// Size of the buffer between the serial thread and the writer thread. Must be a power of 2
+constexpr size_t CAPTURE_BUFFER_SIZE        = 1 << 20;
+
+struct CaptureFileHeader_t {
+	char magic[4];
+	uint16_t version;
+	// Size of this header, so fields can be appended without breaking older readers
+	uint16_t headerSize;
+	// When the capture was started, see protocol::MonotonicTimestamp
+	uint64_t startTimestamp;
+};
+
+/// <summary>
+/// Records every raw frame received from a dongle to a binary capture file. Frames are appended to a preallocated
+/// buffer by the serial thread, and written to disk by a background thread, so recording never blocks ingest. If the
+/// writer falls behind, frames are dropped (and counted) rather than stalling the serial thread.
+/// </summary>
+class CaptureRecorder {
+public:
+	CaptureRecorder();
+	~CaptureRecorder();
+
+	// Creates the capture file and starts recording. Call from any thread other than the serial thread
+	bool Start(const std::string& path);
+	// Writes everything recorded so far and closes the file
+	void Stop();
+	inline bool IsRecording() const { return m_recording.load(std::memory_order_acquire); }
+
+	// Serial thread only. Never blocks, and does nothing unless recording
+	void Record(const uint64_t timestamp, const RawFrame_t& raw, const FrameStatus_t status, const crc checksum);
+	// Serial thread only. Wakes the writer thread, call once per read rather than once per frame
+	void Commit();
+
+	inline uint64_t RecordedFrames() const { return m_recorded.load(std::memory_order_relaxed); }
+	inline uint64_t DroppedFrames() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	void WriterThread();
+	void Append(const uint8_t* data, const size_t size, size_t& position);
+
+private:
+	// Preallocated once, so recording never allocates
+	uint8_t* m_buffer;
+
+	// Free running byte offsets into m_buffer. m_write is only written by the serial thread, m_read by the writer thread
+	alignas(64) std::atomic<size_t> m_write;
+	alignas(64) std::atomic<size_t> m_read;
+
+	std::atomic<bool> m_recording;
+	// Bumped by Commit and Stop to wake the writer thread
+	std::atomic<uint32_t> m_writerSignal;
+	std::thread m_writerThread;
+	FILE* m_file;
+
+	std::atomic<uint64_t> m_recorded;
+	std::atomic<uint64_t> m_dropped;
+};
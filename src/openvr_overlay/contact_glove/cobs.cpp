@@ -44,4 +44,105 @@ size_t cobs::decode(uint8_t* buffer, const size_t size) {
 	}
 
 	return size - 1;
-}
\ No newline at end of file
+}
+
+size_t cobs::decode_crc(uint8_t* buffer, const size_t size, crc& outCrc) {
+
+	outCrc = F_CRC_Finalise(INITIAL_VALUE);
+
+	// COBS can only encode up to 254 bytes
+	if (size < 1 || size > 255) {
+		return 0;
+	}
+
+	uint8_t* bufferSrc = buffer;
+	crc runningCrc = INITIAL_VALUE;
+
+	const uint8_t* end = bufferSrc + size;
+	while (bufferSrc < end) {
+		int i, code = *bufferSrc++;
+		for (i = 1; i < code && bufferSrc < end; i++) {
+			const uint8_t value = *bufferSrc++;
+			runningCrc = F_CRC_Update(runningCrc, value);
+			*buffer++ = value;
+		}
+		// The zero implied by the last block terminates the frame, and is not part of the data
+		if (code < 0xFF && bufferSrc < end) {
+			runningCrc = F_CRC_Update(runningCrc, 0);
+			*buffer++ = 0;
+		}
+	}
+
+	outCrc = F_CRC_Finalise(runningCrc);
+
+	return size - 1;
+}
+
+cobs::StreamDecoder::StreamDecoder()
+	: m_frame{}, m_length(0), m_code(0), m_remaining(0), m_pendingZero(false), m_overflowed(false), m_crc(INITIAL_VALUE) {}
+
+void cobs::StreamDecoder::Reset() {
+	m_length		= 0;
+	m_code			= 0;
+	m_remaining		= 0;
+	m_pendingZero	= false;
+	m_overflowed	= false;
+	m_crc			= INITIAL_VALUE;
+}
+
+cobs::StreamDecoder::Result_t cobs::StreamDecoder::Push(const uint8_t byte) {
+
+	// Delimiter, the frame is complete
+	if (byte == 0) {
+		Result_t result = Result_t::FrameComplete;
+		if (m_overflowed) {
+			result = Result_t::FrameOverflow;
+		} else if (m_remaining != 0) {
+			result = Result_t::FrameMalformed;
+		}
+
+		// The zero implied by the last block is never part of the frame. Back to back delimiters yield an empty frame.
+		const size_t length = m_code == 0 ? 0 : m_length;
+		const crc checksum = m_code == 0 ? INITIAL_VALUE : m_crc;
+		Reset();
+		m_length = length;
+		m_crc = checksum;
+
+		return result;
+	}
+
+	// Start of a new frame, discard the previous one
+	if (m_code == 0) {
+		m_length = 0;
+		m_crc = INITIAL_VALUE;
+	}
+
+	if (m_remaining == 0) {
+		// Code byte, the previous block (if any) was followed by a zero
+		if (m_pendingZero) {
+			if (m_length < MAX_DECODED_SIZE) {
+				m_frame[m_length++] = 0;
+				m_crc = F_CRC_Update(m_crc, 0);
+			} else {
+				m_overflowed = true;
+			}
+		}
+
+		m_code			= byte;
+		m_remaining		= byte - 1;
+	} else {
+		// Data byte
+		if (m_length < MAX_DECODED_SIZE) {
+			m_frame[m_length++] = byte;
+			m_crc = F_CRC_Update(m_crc, byte);
+		} else {
+			m_overflowed = true;
+		}
+
+		m_remaining--;
+	}
+
+	m_pendingZero = m_remaining == 0 && m_code < 0xFF;
+
+	return Result_t::NeedMoreData;
+}
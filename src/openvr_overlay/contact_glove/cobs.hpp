@@ -2,11 +2,62 @@
 #define COBS_C_H
 
 #include <cinttypes>
+#include <cstddef>
+#include <span>
+
+#include "crc.hpp"
 
 namespace cobs {
 
     void encode(const uint8_t* ptr, uint32_t length, uint8_t* dst);
     size_t decode(uint8_t* buffer, const size_t size);
+    // Decodes in place like decode, updating the CRC of the decoded bytes as they are un-stuffed so the frame is only walked once.
+    // outCrc is the finalised CRC of the decoded frame, which is CRC_RESULT_OK when the frame ends in a valid checksum.
+    size_t decode_crc(uint8_t* buffer, const size_t size, crc& outCrc);
+
+    // COBS can only encode up to 254 bytes per frame
+    constexpr size_t MAX_DECODED_SIZE = 254;
+
+    /// <summary>
+    /// Incremental COBS decoder. Encoded bytes are pushed in as they arrive, and are decoded straight into a fixed frame
+    /// slot, so decoding never allocates.
+    /// </summary>
+    class StreamDecoder {
+    public:
+        enum class Result_t {
+            NeedMoreData,
+            FrameComplete,
+            // The frame was longer than MAX_DECODED_SIZE
+            FrameOverflow,
+            // The frame ended in the middle of a block
+            FrameMalformed,
+        };
+
+        StreamDecoder();
+
+        // Feeds a single encoded byte into the decoder. A 0x00 byte terminates the current frame.
+        Result_t Push(const uint8_t byte);
+        void Reset();
+
+        // The decoded frame. Only valid after Push returned FrameComplete, and until the next call to Push.
+        inline std::span<const uint8_t> Frame() const { return std::span<const uint8_t>(m_frame, m_length); }
+        // CRC of the decoded frame, computed while decoding. Same validity as Frame.
+        inline crc Checksum() const { return F_CRC_Finalise(m_crc); }
+
+    private:
+        uint8_t m_frame[MAX_DECODED_SIZE];
+        size_t m_length;
+
+        // Current block code, and how many data bytes are left in the block
+        uint8_t m_code;
+        uint8_t m_remaining;
+        // Blocks shorter than 0xFF imply a zero, which we only emit once we know it isn't the end of the frame
+        bool m_pendingZero;
+        bool m_overflowed;
+
+        // Running CRC of every byte written to the frame, including the trailing CRC byte
+        crc m_crc;
+    };
 }
 
 #endif // COBS_C_H
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "command_queue.hpp"
+
+#include <cstring>
+
+CommandQueue::CommandQueue()
+	: m_commands{}, m_count(0), m_nextSequence(0) {}
+
+void CommandQueue::Clear() {
+	m_count = 0;
+}
+
+CommandQueue::Result_t CommandQueue::Push(const std::string_view command, const CommandPriority_t priority) {
+	const size_t length = command.size() + COMMAND_TERMINATOR.size();
+	if (length > MAX_COMMAND_LENGTH) {
+		return Result_t::TooLong;
+	}
+
+	// Coalesce duplicates, keeping the more urgent priority. Every queued command has the same terminator
+	for (size_t i = 0; i < m_count; i++) {
+		QueuedCommand_t& queued = m_commands[i];
+		if (queued.length == length && memcmp(queued.data, command.data(), command.size()) == 0) {
+			if (priority < queued.priority) {
+				queued.priority = priority;
+			}
+			return Result_t::Coalesced;
+		}
+	}
+
+	if (m_count == COMMAND_QUEUE_SIZE) {
+		return Result_t::Full;
+	}
+
+	QueuedCommand_t& queued	= m_commands[m_count++];
+	memcpy(queued.data, command.data(), command.size());
+	memcpy(queued.data + command.size(), COMMAND_TERMINATOR.data(), COMMAND_TERMINATOR.size());
+	queued.length			= static_cast<uint8_t>(length);
+	queued.priority			= priority;
+	queued.sequence			= m_nextSequence++;
+
+	return Result_t::Queued;
+}
+
+bool CommandQueue::Pop(QueuedCommand_t& outCommand) {
+	if (m_count == 0) {
+		return false;
+	}
+
+	// The queue is tiny, so a linear scan is cheaper than keeping it sorted
+	size_t next = 0;
+	for (size_t i = 1; i < m_count; i++) {
+		const QueuedCommand_t& candidate	= m_commands[i];
+		const QueuedCommand_t& best			= m_commands[next];
+		if (candidate.priority < best.priority || (candidate.priority == best.priority && candidate.sequence < best.sequence)) {
+			next = i;
+		}
+	}
+
+	outCommand = m_commands[next];
+
+	// Order is tracked by the sequence number, so the last command can simply fill the gap
+	m_commands[next] = m_commands[m_count - 1];
+	m_count--;
+
+	return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <string_view>
+
+// Maximum number of commands waiting to be written to the dongle
+constexpr size_t COMMAND_QUEUE_SIZE		= 16;
+// Maximum length of a single command, including the trailing "\r\n"
+constexpr size_t MAX_COMMAND_LENGTH		= 64;
+// Ends every command written to the dongle, appended by CommandQueue::Push
+constexpr std::string_view COMMAND_TERMINATOR = "\r\n";
+
+// Lower values are written first
+enum class CommandPriority_t : uint8_t {
+	Haptics,
+	Config,
+};
+
+struct QueuedCommand_t {
+	// The command followed by COMMAND_TERMINATOR, ready to be written as is
+	char data[MAX_COMMAND_LENGTH];
+	uint8_t length;
+	CommandPriority_t priority;
+	// Order in which commands were queued, so commands of the same priority are written in order
+	uint64_t sequence;
+};
+
+/// <summary>
+/// Bounded queue of commands waiting to be written to the dongle. Commands are popped by priority, then in the order they
+/// were pushed. Pushing a command which is already queued coalesces the two instead of sending it twice.
+/// Not thread safe, the serial manager guards it with its write mutex.
+/// </summary>
+class CommandQueue {
+public:
+	enum class Result_t {
+		Queued,
+		// The same command was already queued
+		Coalesced,
+		Full,
+		TooLong,
+	};
+
+	CommandQueue();
+
+	// Queues command, without its terminator, which is appended in the queue's own storage so nothing is allocated
+	Result_t Push(const std::string_view command, const CommandPriority_t priority);
+	bool Pop(QueuedCommand_t& outCommand);
+	void Clear();
+
+	inline size_t Size() const { return m_count; }
+
+private:
+	QueuedCommand_t m_commands[COMMAND_QUEUE_SIZE];
+	size_t m_count;
+	uint64_t m_nextSequence;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cinttypes>
+#include <cstddef>
 
 /*
 
@@ -33,6 +34,7 @@ constexpr uint8_t DEVICES_VERSIONS							= 0x07;
 constexpr uint8_t DEVICES_STATUS							= 0x1E;
 constexpr uint8_t GLOVE_POWER_ON_PACKET						= 0x64;
 
+// Sizes include the leading delimiter. See packet_descriptors.cpp for the decoded lengths
 constexpr uint8_t GLOVE_RIGHT_PACKET_DATA					= 0x02; // 8  bytes
 constexpr uint8_t GLOVE_RIGHT_PACKET_FINGERS				= 0x05; // 23 bytes
 constexpr uint8_t GLOVE_RIGHT_PACKET_IMU					= 0x0B; // 11 bytes
@@ -98,15 +100,13 @@ public:
 	uint16_t fingerPinkyRoot;
 };
 
+// Orientation of the glove as reported by its IMU, in the IMU's own frame. Unit length up to quantisation
 struct GlovePacketImu_t {
 public:
-	uint16_t imu1;
-	uint16_t imu2;
-	uint16_t imu3;
-	uint16_t imu4;
-
-	float imu5;
-	float imu6;
+	float rotationW;
+	float rotationX;
+	float rotationY;
+	float rotationZ;
 };
 
 enum class PacketType_t {
@@ -123,10 +123,17 @@ enum class PacketType_t {
 	GloveRightImu,
 };
 
+// Number of packet types, for tables indexed by PacketType_t
+constexpr size_t PACKET_TYPE_COUNT = static_cast<size_t>(PacketType_t::GloveRightImu) + 1;
+
 // Common packet denominator
 struct ContactGlovePacket_t {
 public:
 	PacketType_t type;
+	// Which glove the packet came from, or Dongle for packets describing the dongle
+	ContactGloveDevice_t device;
+	// Monotonic time in nanoseconds (see protocol::MonotonicTimestamp) at which the frame's delimiter was read
+	uint64_t timestamp;
 	union ContactGlovePacket {
 		GloveInputData_t		gloveData;
 		GlovePacketFingers_t	gloveFingers;
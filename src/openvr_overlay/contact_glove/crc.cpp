@@ -33,14 +33,7 @@
 
 
 
- /*
-  * Derive parameters from the standard-specific parameters in crc.h.
-  */
-#ifndef WIDTH
-#define WIDTH    (8 * sizeof(crc))
-#endif
-#define TOPBIT   (((crc)1) << (WIDTH - 1))
-
+#if (CALCULATE_LOOKUPTABLE == FALSE)
 #if (REVERSED_DATA == TRUE)
 #define FP_reflect_DATA(_DATO)                      ((uint8_t)(FP_reflect((_DATO), 8)&0xFF))
 #define FP_reflect_CRCTableValue(_CRCTableValue)	((crc) FP_reflect((_CRCTableValue), WIDTH))
@@ -48,10 +41,6 @@
 #define FP_reflect_DATA(_DATO)                      (_DATO)
 #define FP_reflect_CRCTableValue(_CRCTableValue)	(_CRCTableValue)
 
-#endif
-
-#if (CALCULATE_LOOKUPTABLE == TRUE)
-static crc  A_crcLookupTable[256] = { 0 };
 #endif
 /*********************************************************************
  *
@@ -109,28 +98,9 @@ static crc F_CRC_ObtainTableValue(uint8_t VP_Pos_Tabla)
     return (FP_reflect_CRCTableValue(VP_CRCTableValue));
 }
 
-#if (CALCULATE_LOOKUPTABLE == TRUE)
-
-/*********************************************************************
- *
- * Function:    F_CRC_InitialiseTable()
- *
- * Description: Create the lookup table for the CRC
- *
- *********************************************************************/
-void F_CRC_InitialiseTable(void)
-{
-    uint16_t VP_Pos_Array = 0;
-
-    for (VP_Pos_Array = 0; VP_Pos_Array < 256; VP_Pos_Array++)
-    {
-        A_crcLookupTable[VP_Pos_Array] = F_CRC_ObtainTableValue((uint8_t)(VP_Pos_Array & 0xFF));
-
-    }
-
-}
-
+#endif
 
+#if (CALCULATE_LOOKUPTABLE == TRUE)
 
 /*********************************************************************
  *
@@ -138,7 +108,7 @@ void F_CRC_InitialiseTable(void)
  *
  * Description: Calculate the CRC value from a Lookup Table.
  *
- * Notes:		F_CRC_InitialiseTable() must be called first.
+ * Notes:		The table is generated at compile time in crc.hpp, so no initialisation is required.
  *                      Since AF_Data is a char array, it is possible to compute any kind of file or array.
  *
  * Returns:		The CRC of the AF_Data.
@@ -147,28 +117,13 @@ void F_CRC_InitialiseTable(void)
 crc F_CRC_CalculateCheckSum(uint8_t const AF_Data[], size_t VF_nBytes)
 {
     crc	VP_CRCTableValue = INITIAL_VALUE;
-    uint16_t VP_bytes = 0;
-
-    for (VP_bytes = 0; VP_bytes < VF_nBytes; VP_bytes++)
-    {
-#if (REVERSED_DATA == TRUE)
-        VP_CRCTableValue = (VP_CRCTableValue >> 8) ^ A_crcLookupTable[((uint8_t)(VP_CRCTableValue & 0xFF)) ^ AF_Data[VP_bytes]];
-#else
-        VP_CRCTableValue = (VP_CRCTableValue << 8) ^ A_crcLookupTable[((uint8_t)((VP_CRCTableValue >> (WIDTH - 8)) & 0xFF)) ^ AF_Data[VP_bytes]];
-#endif
-    }
 
-    if ((8 * sizeof(crc)) > WIDTH)
+    for (size_t VP_bytes = 0; VP_bytes < VF_nBytes; VP_bytes++)
     {
-        VP_CRCTableValue = VP_CRCTableValue & ((((crc)(1)) << WIDTH) - 1);
+        VP_CRCTableValue = F_CRC_Update(VP_CRCTableValue, AF_Data[VP_bytes]);
     }
 
-#if (REVERSED_OUT == FALSE)
-    return (VP_CRCTableValue ^ FINAL_XOR_VALUE);
-#else
-    return (~VP_CRCTableValue ^ FINAL_XOR_VALUE);
-#endif
-
+    return F_CRC_Finalise(VP_CRCTableValue);
 }
 #else
 
@@ -94,6 +94,7 @@
   */
 
 #include <stdint.h>
+#include <stddef.h>
 
 
 
@@ -107,7 +108,8 @@
 #define CRC_8
 
 //Indicate here if you want to do the calculation using a LookupTable
-#define CALCULATE_LOOKUPTABLE   FALSE
+//The table is generated at compile time, so it costs nothing at startup
+#define CALCULATE_LOOKUPTABLE   TRUE
 
 
 #if defined(CRC_8)
@@ -203,11 +205,124 @@ typedef uint64_t crc;
 
 #endif
 
-#if (CALCULATE_LOOKUPTABLE == FALSE)
-#define F_CRC_InitialiseTable()
+/*
+ * Derive parameters from the standard-specific parameters above.
+ */
+#ifndef WIDTH
+#define WIDTH    (8 * sizeof(crc))
+#endif
+#define TOPBIT   (((crc)1) << (WIDTH - 1))
+
+#if (CALCULATE_LOOKUPTABLE == TRUE)
+
+#include <array>
+
+/*********************************************************************
+ *
+ * Function:    FP_CRC_ReflectConstexpr()
+ *
+ * Description: Compile time version of FP_reflect(), used to build the lookup table.
+ *
+ *********************************************************************/
+constexpr crc FP_CRC_ReflectConstexpr(crc VF_dato, uint8_t VF_nBits)
+{
+    crc VP_reflection = 0;
+
+    for (uint8_t VP_Pos_bit = 0; VP_Pos_bit < VF_nBits; VP_Pos_bit++)
+    {
+        if ((VF_dato & 1) == 1)
+        {
+            VP_reflection |= (((crc)1) << ((VF_nBits - 1) - VP_Pos_bit));
+        }
+
+        VF_dato = (VF_dato >> 1);
+    }
+    return (VP_reflection);
+}
+
+/*********************************************************************
+ *
+ * Function:    F_CRC_GenerateTable()
+ *
+ * Description: Create the lookup table for the CRC at compile time
+ *
+ *********************************************************************/
+constexpr std::array<crc, 256> F_CRC_GenerateTable()
+{
+    std::array<crc, 256> VP_table = {};
+
+    for (uint16_t VP_Pos_Array = 0; VP_Pos_Array < 256; VP_Pos_Array++)
+    {
+#if (REVERSED_DATA == TRUE)
+        crc VP_CRCTableValue = ((crc)(FP_CRC_ReflectConstexpr((crc)VP_Pos_Array, 8) & 0xFF)) << (WIDTH - 8);
+#else
+        crc VP_CRCTableValue = ((crc)VP_Pos_Array) << (WIDTH - 8);
+#endif
+
+        for (uint8_t VP_Pos_bit = 0; VP_Pos_bit < 8; VP_Pos_bit++)
+        {
+            if (VP_CRCTableValue & TOPBIT)
+            {
+                VP_CRCTableValue = (VP_CRCTableValue << 1) ^ POLYNOMIAL;
+            }
+            else
+            {
+                VP_CRCTableValue = (VP_CRCTableValue << 1);
+            }
+        }
+
+#if (REVERSED_DATA == TRUE)
+        VP_table[VP_Pos_Array] = FP_CRC_ReflectConstexpr(VP_CRCTableValue, WIDTH);
 #else
-void F_CRC_InitialiseTable(void);
+        VP_table[VP_Pos_Array] = VP_CRCTableValue;
 #endif
+    }
+
+    return VP_table;
+}
+
+inline constexpr std::array<crc, 256> A_crcLookupTable = F_CRC_GenerateTable();
+
+/*********************************************************************
+ *
+ * Function:    F_CRC_Update()
+ *
+ * Description: Feeds a single byte into a running CRC. Start from INITIAL_VALUE, and pass the
+ *              result through F_CRC_Finalise() once every byte has been fed in.
+ *
+ *********************************************************************/
+constexpr crc F_CRC_Update(crc VF_crc, uint8_t VF_byte)
+{
+#if (REVERSED_DATA == TRUE)
+    return (VF_crc >> 8) ^ A_crcLookupTable[((uint8_t)(VF_crc & 0xFF)) ^ VF_byte];
+#else
+    return (VF_crc << 8) ^ A_crcLookupTable[((uint8_t)((VF_crc >> (WIDTH - 8)) & 0xFF)) ^ VF_byte];
+#endif
+}
+
+/*********************************************************************
+ *
+ * Function:    F_CRC_Finalise()
+ *
+ * Description: Turns a running CRC into the CRC of the data that was fed in.
+ *
+ *********************************************************************/
+constexpr crc F_CRC_Finalise(crc VF_crc)
+{
+    if ((8 * sizeof(crc)) > WIDTH)
+    {
+        VF_crc = VF_crc & ((((crc)(1)) << WIDTH) - 1);
+    }
+
+#if (REVERSED_OUT == FALSE)
+    return (VF_crc ^ FINAL_XOR_VALUE);
+#else
+    return (~VF_crc ^ FINAL_XOR_VALUE);
+#endif
+}
+
+#endif
+
 crc F_CRC_CalculateCheckSum(uint8_t const AF_Data[], size_t VF_nBytes);
 
 #define CRC_RESULT_OK 0
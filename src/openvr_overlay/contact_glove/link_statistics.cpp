@@ -0,0 +1,70 @@
+#include "link_statistics.hpp"
+#include "../../timestamp.hpp"
+
+#include <bit>
+
+LinkStatistics::LinkStatistics()
+	: m_bytesReceived(0), m_frames(0), m_crcFailures(0), m_cobsErrors(0), m_overflows(0), m_unknownIds(0), m_rejectedLengths(0),
+	  m_packetFrames{}, m_interArrival{}, m_lastArrival{} {}
+
+void LinkStatistics::RecordBytes(const size_t bytes) {
+	Add(m_bytesReceived, bytes);
+}
+
+void LinkStatistics::RecordFrame(const PacketType_t type, const uint64_t timestamp) {
+	const size_t index = static_cast<size_t>(type);
+
+	Add(m_frames, 1);
+	Add(m_packetFrames[index], 1);
+
+	// The first frame of each type has nothing to be compared against
+	if (m_lastArrival[index] != 0 && timestamp >= m_lastArrival[index]) {
+		const uint64_t gapUs = (timestamp - m_lastArrival[index]) / 1000;
+		// std::bit_width is the index of the highest set bit plus one, i.e. 0 for 0us, 1 for 1us, 2 for 2-3us...
+		const size_t bucket = static_cast<size_t>(std::bit_width(gapUs));
+		Add(m_interArrival[index][bucket < LINK_JITTER_BUCKETS ? bucket : LINK_JITTER_BUCKETS - 1], 1);
+	}
+	m_lastArrival[index] = timestamp;
+}
+
+void LinkStatistics::RecordCrcFailure() {
+	Add(m_crcFailures, 1);
+}
+
+void LinkStatistics::RecordUnknownId() {
+	Add(m_unknownIds, 1);
+}
+
+void LinkStatistics::RecordRejectedLength() {
+	Add(m_rejectedLengths, 1);
+}
+
+void LinkStatistics::RecordFramerErrors(const uint64_t overflows, const uint64_t malformed) {
+	m_overflows.store(overflows, std::memory_order_relaxed);
+	m_cobsErrors.store(malformed, std::memory_order_relaxed);
+}
+
+void LinkStatistics::Snapshot(LinkStatistics_t& outStatistics) const {
+	outStatistics.timestamp         = protocol::MonotonicTimestamp();
+	outStatistics.bytesReceived     = m_bytesReceived.load(std::memory_order_relaxed);
+	outStatistics.frames            = m_frames.load(std::memory_order_relaxed);
+	outStatistics.crcFailures       = m_crcFailures.load(std::memory_order_relaxed);
+	outStatistics.cobsErrors        = m_cobsErrors.load(std::memory_order_relaxed);
+	outStatistics.overflows         = m_overflows.load(std::memory_order_relaxed);
+	outStatistics.unknownIds        = m_unknownIds.load(std::memory_order_relaxed);
+	outStatistics.rejectedLengths   = m_rejectedLengths.load(std::memory_order_relaxed);
+
+	for (size_t type = 0; type < PACKET_TYPE_COUNT; type++) {
+		outStatistics.packets[type].frames = m_packetFrames[type].load(std::memory_order_relaxed);
+		for (size_t bucket = 0; bucket < LINK_JITTER_BUCKETS; bucket++) {
+			outStatistics.packets[type].interArrival[bucket] = m_interArrival[type][bucket].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+double LinkFramesPerSecond(const LinkStatistics_t& previous, const LinkStatistics_t& current) {
+	if (current.timestamp <= previous.timestamp || current.frames < previous.frames) {
+		return 0.0;
+	}
+	return static_cast<double>(current.frames - previous.frames) * 1e9 / static_cast<double>(current.timestamp - previous.timestamp);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+
+#include "contact_glove_structs.hpp"
+
+// Inter-arrival times are bucketed by powers of 2 microseconds. Bucket 0 counts gaps under 1us (frames which arrived in
+// the same read), bucket i gaps in [2^(i-1), 2^i) us, and the last bucket every gap longer than that (~16ms)
+constexpr size_t LINK_JITTER_BUCKETS = 16;
+
+struct LinkPacketStatistics_t {
+	// Valid frames of this packet type
+	uint64_t frames;
+	// Histogram of the time between two consecutive frames of this packet type, see LINK_JITTER_BUCKETS
+	uint64_t interArrival[LINK_JITTER_BUCKETS];
+};
+
+/// <summary>
+/// Link quality counters for a single dongle, since it was first connected. Radio problems show up as CRC failures, COBS
+/// errors and long inter-arrival gaps, while software stalls show up as overflows and bursts of frames in the same read.
+/// Plain data, so it can be copied into shared memory for external tools.
+/// </summary>
+struct LinkStatistics_t {
+	// When the statistics were read, see protocol::MonotonicTimestamp. Rates are computed between two snapshots
+	uint64_t timestamp;
+
+	uint64_t bytesReceived;
+	// Frames which passed the CRC check and were decoded
+	uint64_t frames;
+	uint64_t crcFailures;
+	// Frames with invalid COBS encoding
+	uint64_t cobsErrors;
+	// Frames too long for the decoder, usually a missed delimiter
+	uint64_t overflows;
+	// Valid frames with an unknown packet id
+	uint64_t unknownIds;
+	// Valid frames with the wrong length for their packet id
+	uint64_t rejectedLengths;
+
+	LinkPacketStatistics_t packets[PACKET_TYPE_COUNT];
+};
+
+// Valid frames per second between two snapshots of the same dongle
+double LinkFramesPerSecond(const LinkStatistics_t& previous, const LinkStatistics_t& current);
+
+/// <summary>
+/// Live link quality counters. Written only by the serial thread servicing the dongle, and read from any thread without
+/// locking. Each counter is individually consistent, but a snapshot may mix counters from either side of a read.
+/// </summary>
+class LinkStatistics {
+public:
+	LinkStatistics();
+
+	void RecordBytes(const size_t bytes);
+	void RecordFrame(const PacketType_t type, const uint64_t timestamp);
+	void RecordCrcFailure();
+	void RecordUnknownId();
+	void RecordRejectedLength();
+	// The framer keeps its own running totals
+	void RecordFramerErrors(const uint64_t overflows, const uint64_t malformed);
+
+	void Snapshot(LinkStatistics_t& outStatistics) const;
+	inline uint64_t RejectedLengths() const { return m_rejectedLengths.load(std::memory_order_relaxed); }
+
+private:
+	// There is a single writer, so a plain load and store is enough and avoids a locked instruction
+	static inline void Add(std::atomic<uint64_t>& counter, const uint64_t value) {
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint64_t> m_bytesReceived;
+	std::atomic<uint64_t> m_frames;
+	std::atomic<uint64_t> m_crcFailures;
+	std::atomic<uint64_t> m_cobsErrors;
+	std::atomic<uint64_t> m_overflows;
+	std::atomic<uint64_t> m_unknownIds;
+	std::atomic<uint64_t> m_rejectedLengths;
+
+	std::atomic<uint64_t> m_packetFrames[PACKET_TYPE_COUNT];
+	std::atomic<uint64_t> m_interArrival[PACKET_TYPE_COUNT][LINK_JITTER_BUCKETS];
+
+	// Only touched by the serial thread
+	uint64_t m_lastArrival[PACKET_TYPE_COUNT];
+};
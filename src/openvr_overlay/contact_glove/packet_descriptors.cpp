@@ -0,0 +1,157 @@
+#include "packet_descriptors.hpp"
+
+#include <array>
+#include <cstring>
+
+// The dongle packs its fields with no regard for alignment
+template <typename T>
+static inline T ReadUnaligned(const uint8_t* pData) {
+	T value;
+	memcpy(&value, pData, sizeof(T));
+	return value;
+}
+
+static void ExtractGloveData(const uint8_t* pData, ContactGlovePacket_t* outPacket) {
+	outPacket->packet.gloveData.joystickX = ReadUnaligned<uint16_t>(pData + 2);
+	outPacket->packet.gloveData.joystickY = ReadUnaligned<uint16_t>(pData + 4);
+
+	const uint8_t button_mask = pData[1];
+
+	// KNOWN VALUES:
+	// None             :: 0x3F   0011 1111
+	// System Up        :: 0x2F   0010 1111
+	// System Down      :: 0x37   0011 0111
+	// A (BTN_DOWN)     :: 0x3E   0011 1110
+	// B (BTN_UP)       :: 0x3D   0011 1101
+	// Joystick Click   :: 0x3B   0011 1011
+	// Magnetra unavail :: 0x1F   0001 1111
+
+	outPacket->packet.gloveData.hasMagnetra		=   (button_mask & CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT)	== CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT;
+	outPacket->packet.gloveData.systemUp		= !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP)			== CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP);
+	outPacket->packet.gloveData.systemDown		= !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN)		== CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN);
+	outPacket->packet.gloveData.buttonUp		= !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_UP)			== CONTACT_GLOVE_INPUT_MASK_BUTTON_UP);
+	outPacket->packet.gloveData.buttonDown		= !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN)		== CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN);
+	outPacket->packet.gloveData.joystickClick	= !((button_mask & CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK)		== CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK);
+}
+
+static void ExtractGloveFingers(const uint8_t* pData, ContactGlovePacket_t* outPacket) {
+	// 10 little endian uint16s, starting with the pinky
+	const uint8_t* pFingers = pData + 1;
+
+	outPacket->packet.gloveFingers.fingerPinkyTip	= ReadUnaligned<uint16_t>(pFingers + 0 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerPinkyRoot	= ReadUnaligned<uint16_t>(pFingers + 1 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerRingRoot	= ReadUnaligned<uint16_t>(pFingers + 2 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerRingTip	= ReadUnaligned<uint16_t>(pFingers + 3 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerMiddleRoot	= ReadUnaligned<uint16_t>(pFingers + 4 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerMiddleTip	= ReadUnaligned<uint16_t>(pFingers + 5 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerIndexRoot	= ReadUnaligned<uint16_t>(pFingers + 6 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerIndexTip	= ReadUnaligned<uint16_t>(pFingers + 7 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerThumbRoot	= ReadUnaligned<uint16_t>(pFingers + 8 * sizeof(uint16_t));
+	outPacket->packet.gloveFingers.fingerThumbTip	= ReadUnaligned<uint16_t>(pFingers + 9 * sizeof(uint16_t));
+}
+
+// IMU components are offset binary: 0x8000 is zero, and 32768 is one
+static inline float ImuComponent(const uint8_t* pData) {
+	return (static_cast<int32_t>(ReadUnaligned<uint16_t>(pData)) - 0x8000) / 32768.0f;
+}
+
+static void ExtractGloveImu(const uint8_t* pData, ContactGlovePacket_t* outPacket) {
+	// 4 little endian uint16s forming a quaternion (w, x, y, z), followed by the CRC. The recorded packets in
+	// contact_glove_structs.hpp both come out as unit quaternions close to identity this way
+	const uint8_t* pImu = pData + 1;
+
+	outPacket->packet.gloveImu.rotationW = ImuComponent(pImu + 0 * sizeof(uint16_t));
+	outPacket->packet.gloveImu.rotationX = ImuComponent(pImu + 1 * sizeof(uint16_t));
+	outPacket->packet.gloveImu.rotationY = ImuComponent(pImu + 2 * sizeof(uint16_t));
+	outPacket->packet.gloveImu.rotationZ = ImuComponent(pImu + 3 * sizeof(uint16_t));
+}
+
+static void ExtractDevicesFirmware(const uint8_t* pData, ContactGlovePacket_t* outPacket) {
+	// This is version a.b, for the dongle and each glove
+	outPacket->packet.firmware.dongleMajor		= pData[1];
+	outPacket->packet.firmware.dongleMinor		= pData[2];
+	outPacket->packet.firmware.gloveLeftMajor	= pData[3];
+	outPacket->packet.firmware.gloveLeftMinor	= pData[4];
+	outPacket->packet.firmware.gloveRightMajor	= pData[5];
+	outPacket->packet.firmware.gloveRightMinor	= pData[6];
+}
+
+static void ExtractDevicesStatus(const uint8_t* pData, ContactGlovePacket_t* outPacket) {
+	outPacket->packet.status.gloveLeftBattery	= pData[1];
+	outPacket->packet.status.gloveRightBattery	= pData[3];
+}
+
+static void ExtractNothing(const uint8_t* /* pData */, ContactGlovePacket_t* /* outPacket */) {}
+
+// Lengths are taken from the packets recorded in contact_glove_structs.hpp
+static constexpr PacketDescriptor_t PACKET_DESCRIPTORS[] = {
+	{ DEVICES_VERSIONS,				8,	PacketType_t::DevicesFirmware,		ContactGloveDevice_t::Dongle,		ExtractDevicesFirmware },
+	{ DEVICES_STATUS,				7,	PacketType_t::DevicesStatus,		ContactGloveDevice_t::Dongle,		ExtractDevicesStatus },
+	{ GLOVE_POWER_ON_PACKET,		6,	PacketType_t::GlovePowerOn,			ContactGloveDevice_t::Dongle,		ExtractNothing },
+
+	{ GLOVE_LEFT_PACKET_DATA,		7,	PacketType_t::GloveLeftData,		ContactGloveDevice_t::LeftGlove,	ExtractGloveData },
+	{ GLOVE_LEFT_PACKET_FINGERS,	22,	PacketType_t::GloveLeftFingers,		ContactGloveDevice_t::LeftGlove,	ExtractGloveFingers },
+	{ GLOVE_LEFT_PACKET_IMU,		10,	PacketType_t::GloveLeftImu,			ContactGloveDevice_t::LeftGlove,	ExtractGloveImu },
+
+	{ GLOVE_RIGHT_PACKET_DATA,		7,	PacketType_t::GloveRightData,		ContactGloveDevice_t::RightGlove,	ExtractGloveData },
+	{ GLOVE_RIGHT_PACKET_FINGERS,	22,	PacketType_t::GloveRightFingers,	ContactGloveDevice_t::RightGlove,	ExtractGloveFingers },
+	{ GLOVE_RIGHT_PACKET_IMU,		10,	PacketType_t::GloveRightImu,		ContactGloveDevice_t::RightGlove,	ExtractGloveImu },
+};
+
+constexpr size_t PACKET_DESCRIPTOR_COUNT = sizeof(PACKET_DESCRIPTORS) / sizeof(PACKET_DESCRIPTORS[0]);
+constexpr uint8_t PACKET_ID_UNKNOWN = 0xFF;
+static_assert(PACKET_DESCRIPTOR_COUNT < PACKET_ID_UNKNOWN, "Too many packet descriptors!");
+
+// Maps every packet id to its index in PACKET_DESCRIPTORS, so that finding a descriptor is a single lookup
+static constexpr std::array<uint8_t, 256> BuildPacketIndex() {
+	std::array<uint8_t, 256> index = {};
+	index.fill(PACKET_ID_UNKNOWN);
+
+	for (size_t i = 0; i < PACKET_DESCRIPTOR_COUNT; i++) {
+		index[PACKET_DESCRIPTORS[i].id] = static_cast<uint8_t>(i);
+	}
+
+	return index;
+}
+
+static constexpr std::array<uint8_t, 256> PACKET_INDEX = BuildPacketIndex();
+
+static constexpr bool HasUniquePacketIds() {
+	for (size_t i = 0; i < PACKET_DESCRIPTOR_COUNT; i++) {
+		if (PACKET_INDEX[PACKET_DESCRIPTORS[i].id] != i) {
+			return false;
+		}
+	}
+	return true;
+}
+static_assert(HasUniquePacketIds(), "Packet descriptors must have unique ids!");
+
+const PacketDescriptor_t* FindPacketDescriptor(const uint8_t id) {
+	const uint8_t index = PACKET_INDEX[id];
+	if (index == PACKET_ID_UNKNOWN) {
+		return nullptr;
+	}
+	return &PACKET_DESCRIPTORS[index];
+}
+
+PacketDecodeResult_t DecodePacketFrame(const std::span<const uint8_t> frame, ContactGlovePacket_t* outPacket) {
+	if (frame.empty()) {
+		return PacketDecodeResult_t::UnknownId;
+	}
+
+	const PacketDescriptor_t* descriptor = FindPacketDescriptor(frame[0]);
+	if (descriptor == nullptr) {
+		return PacketDecodeResult_t::UnknownId;
+	}
+
+	// Reject frames which would have us read out of bounds (or which we don't know how to interpret)
+	if (frame.size() != descriptor->length) {
+		return PacketDecodeResult_t::BadLength;
+	}
+
+	outPacket->type		= descriptor->type;
+	outPacket->device	= descriptor->device;
+	descriptor->extract(frame.data(), outPacket);
+
+	return PacketDecodeResult_t::Decoded;
+}
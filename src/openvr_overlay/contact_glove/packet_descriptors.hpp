@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cinttypes>
+#include <span>
+
+#include "contact_glove_structs.hpp"
+
+/// <summary>
+/// Describes how to decode a single packet type received from the dongle. Adding a new packet type only needs a new
+/// entry in the descriptor table in packet_descriptors.cpp.
+/// </summary>
+struct PacketDescriptor_t {
+	uint8_t id;
+	// Decoded frame length, including the packet id and the trailing CRC byte
+	uint8_t length;
+	PacketType_t type;
+	// Which device the packet describes. Packets about the dongle itself (or both gloves) use Dongle
+	ContactGloveDevice_t device;
+	// Copies the payload into the packet. Only called once the frame length has been validated
+	void (*extract)(const uint8_t* pData, ContactGlovePacket_t* outPacket);
+};
+
+// Returns the descriptor for the given packet id, or nullptr if the packet is unknown
+const PacketDescriptor_t* FindPacketDescriptor(const uint8_t id);
+
+enum class PacketDecodeResult_t : uint8_t {
+	Decoded,
+	// No descriptor for the packet id
+	UnknownId,
+	// The frame's length doesn't match its packet type, so it can't be interpreted safely
+	BadLength,
+};
+
+// Decodes a CRC checked frame (packet id, payload and CRC byte) into outPacket. outPacket's timestamp is left untouched
+PacketDecodeResult_t DecodePacketFrame(const std::span<const uint8_t> frame, ContactGlovePacket_t* outPacket);
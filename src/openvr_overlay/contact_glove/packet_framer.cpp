@@ -0,0 +1,106 @@
+#include "packet_framer.hpp"
+#include "contact_glove_structs.hpp"
+
+static_assert((FRAMER_RING_SIZE & (FRAMER_RING_SIZE - 1)) == 0, "FRAMER_RING_SIZE must be a power of 2!");
+static_assert(FRAMER_RING_SIZE > FRAMER_MAX_RAW_FRAME + 1, "FRAMER_RING_SIZE must be able to hold at least one frame!");
+
+constexpr uint32_t FRAMER_RING_MASK = FRAMER_RING_SIZE - 1;
+
+PacketFramer::PacketFramer()
+	: m_ring{}, m_read(0), m_write(0), m_frameStart(0), m_rawDropped(false), m_decoder(), m_overflows(0), m_malformed(0) {}
+
+void PacketFramer::Reset() {
+	m_read			= 0;
+	m_write			= 0;
+	m_frameStart	= 0;
+	m_rawDropped	= false;
+	m_decoder.Reset();
+}
+
+uint8_t* PacketFramer::WriteRegion(size_t& outSize) {
+	const uint32_t writeIndex	= m_write & FRAMER_RING_MASK;
+	// The partially decoded frame is kept too, it's at most FRAMER_MAX_RAW_FRAME bytes
+	const uint32_t freeSpace	= FRAMER_RING_SIZE - (m_write - m_frameStart);
+	const uint32_t untilWrap	= FRAMER_RING_SIZE - writeIndex;
+
+	outSize = freeSpace < untilWrap ? freeSpace : untilWrap;
+	return &m_ring[writeIndex];
+}
+
+void PacketFramer::CommitWrite(const size_t size) {
+	m_write += static_cast<uint32_t>(size);
+}
+
+bool PacketFramer::NextFrame(std::span<const uint8_t>& outFrame, crc& outChecksum) {
+	FrameStatus_t status	= FrameStatus_t::Decoded;
+	RawFrame_t raw			= {};
+
+	while (NextFrameRaw(outFrame, outChecksum, status, raw)) {
+		if (status == FrameStatus_t::Decoded) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool PacketFramer::NextFrameRaw(std::span<const uint8_t>& outFrame, crc& outChecksum, FrameStatus_t& outStatus, RawFrame_t& outRaw) {
+	while (m_read != m_write) {
+		const cobs::StreamDecoder::Result_t result = m_decoder.Push(m_ring[m_read & FRAMER_RING_MASK]);
+		m_read++;
+
+		if (result == cobs::StreamDecoder::Result_t::NeedMoreData) {
+			// Stop holding onto a frame which can only overflow, so it can't fill the ring
+			if (m_read - m_frameStart > FRAMER_MAX_RAW_FRAME) {
+				m_frameStart	= m_read;
+				m_rawDropped	= true;
+			}
+			continue;
+		}
+
+		// Every other result means we just consumed a delimiter, which isn't part of the raw frame
+		const uint32_t rawStart		= m_frameStart;
+		const uint32_t rawLength	= m_read - 1 - rawStart;
+		const bool rawDropped		= m_rawDropped;
+		m_frameStart				= m_read;
+		m_rawDropped				= false;
+
+		outRaw = {};
+		if (!rawDropped) {
+			const uint32_t startIndex	= rawStart & FRAMER_RING_MASK;
+			const uint32_t untilWrap	= FRAMER_RING_SIZE - startIndex;
+			const uint32_t firstLength	= rawLength < untilWrap ? rawLength : untilWrap;
+
+			outRaw.first	= std::span<const uint8_t>(&m_ring[startIndex], firstLength);
+			outRaw.second	= std::span<const uint8_t>(&m_ring[0], rawLength - firstLength);
+		}
+
+		switch (result) {
+			case cobs::StreamDecoder::Result_t::FrameComplete:
+				// Back to back delimiters carry no data
+				if (m_decoder.Frame().empty()) {
+					continue;
+				}
+				outFrame	= m_decoder.Frame();
+				outChecksum	= m_decoder.Checksum();
+				outStatus	= FrameStatus_t::Decoded;
+				return true;
+
+			case cobs::StreamDecoder::Result_t::FrameOverflow:
+				m_overflows++;
+				outStatus	= FrameStatus_t::Overflow;
+				break;
+
+			default:
+				m_malformed++;
+				outStatus	= FrameStatus_t::Malformed;
+				break;
+		}
+
+		outFrame	= std::span<const uint8_t>();
+		outChecksum	= 0;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <span>
+
+#include "cobs.hpp"
+
+// Size of the receive ring buffer. Must be a power of 2 so that indices can wrap using a mask.
+constexpr uint32_t FRAMER_RING_SIZE = 4096;
+// Longest encoded frame whose raw bytes are kept, a full COBS frame plus its code byte. Longer frames overflow anyway
+constexpr uint32_t FRAMER_MAX_RAW_FRAME = cobs::MAX_DECODED_SIZE + 2;
+
+enum class FrameStatus_t : uint8_t {
+	// Decoded, check the CRC to know whether it is intact
+	Decoded,
+	// Longer than a COBS frame can be, usually a missed delimiter
+	Overflow,
+	// Invalid COBS encoding
+	Malformed,
+};
+
+// Encoded bytes of a frame, excluding the delimiter. Split in two where the frame wraps around the ring buffer
+struct RawFrame_t {
+	std::span<const uint8_t> first;
+	std::span<const uint8_t> second;
+
+	inline size_t size() const { return first.size() + second.size(); }
+};
+
+/// <summary>
+/// Accumulates raw bytes received from the dongle in a fixed size ring buffer, and splits them into
+/// COBS frames on the 0x00 delimiter. A single bulk read may contain any number of frames.
+/// Frames are decoded incrementally as they are extracted, so nothing is copied or allocated per frame.
+/// </summary>
+class PacketFramer {
+public:
+	PacketFramer();
+
+	/// <summary>
+	/// Returns the largest contiguous writable region of the ring buffer. Pass the number of bytes written to CommitWrite.
+	/// </summary>
+	uint8_t* WriteRegion(size_t& outSize);
+	void CommitWrite(const size_t size);
+
+	/// <summary>
+	/// Decodes the next complete frame. Returns false once every buffered byte has been consumed.
+	/// outFrame points into the decoder, and stays valid until the next call to NextFrame.
+	/// outChecksum is the CRC of the frame, computed while it was decoded. It is CRC_RESULT_OK for a valid frame.
+	/// </summary>
+	bool NextFrame(std::span<const uint8_t>& outFrame, crc& outChecksum);
+
+	/// <summary>
+	/// Like NextFrame, but also returns frames which failed to decode, and the raw encoded bytes of every frame for
+	/// capturing. outRaw is empty for frames longer than FRAMER_MAX_RAW_FRAME, and stays valid until the next CommitWrite.
+	/// </summary>
+	bool NextFrameRaw(std::span<const uint8_t>& outFrame, crc& outChecksum, FrameStatus_t& outStatus, RawFrame_t& outRaw);
+
+	void Reset();
+	inline uint32_t Overflows() const { return m_overflows; }
+	inline uint32_t MalformedFrames() const { return m_malformed; }
+
+private:
+	uint8_t m_ring[FRAMER_RING_SIZE];
+
+	// Free running indices, masked on access
+	uint32_t m_read;
+	uint32_t m_write;
+	// Where the frame being decoded started. Bytes from here on are never overwritten, so the raw frame can be returned
+	uint32_t m_frameStart;
+	// The frame being decoded got too long to keep its raw bytes
+	bool m_rawDropped;
+
+	cobs::StreamDecoder m_decoder;
+
+	uint32_t m_overflows;
+	uint32_t m_malformed;
+};
@@ -1,11 +1,13 @@
 #include "serial_communication.hpp"
-#include <SetupAPI.h>
 
 #include <chrono>
 #include "cobs.hpp"
+#include "packet_descriptors.hpp"
+#include <cstdio>
 #include <iomanip>
+#include <stdexcept>
 
-static const std::string c_serialDeviceId = "VID_10C4&PID_7B27";
+// Fallback retry interval, in case a device arrival notification is missed
 static const uint32_t LISTENER_WAIT_TIME = 1000;
 
 static void PrintBuffer(const std::string name, const uint8_t* buffer, const size_t size) {
@@ -22,193 +24,30 @@ static void PrintBuffer(const std::string name, const uint8_t* buffer, const siz
     std::cout << " };" << std::endl;
 }
 
-int SerialCommunicationManager::GetComPort() const {
-
-    HDEVINFO DeviceInfoSet;
-    SP_DEVINFO_DATA DeviceInfoData;
-    DEVPROPTYPE ulPropertyType;
-    DWORD DeviceIndex       = 0;
-    std::string DevEnum     = "USB";
-    char szBuffer[1024]     = { 0 };
-    DWORD dwSize            = 0;
-    DWORD Error             = 0;
-
-    DeviceInfoSet = SetupDiGetClassDevsA(NULL, DevEnum.c_str(), NULL, DIGCF_ALLCLASSES | DIGCF_PRESENT);
-
-    if (DeviceInfoSet == INVALID_HANDLE_VALUE) {
-        return -1;
-    }
-
-    ZeroMemory(&DeviceInfoData, sizeof(SP_DEVINFO_DATA));
-    DeviceInfoData.cbSize = sizeof(SP_DEVINFO_DATA);
-    // Receive information about an enumerated device
-
-    while ( SetupDiEnumDeviceInfo(DeviceInfoSet, DeviceIndex, &DeviceInfoData) ) {
-        DeviceIndex++;
-
-        // Retrieves a specified Plug and Play device property
-        if (SetupDiGetDeviceRegistryPropertyA(
-            DeviceInfoSet,
-            &DeviceInfoData,
-            SPDRP_HARDWAREID,
-            &ulPropertyType,
-            (BYTE*)szBuffer,
-            sizeof(szBuffer),  // The size, in bytes
-            &dwSize)) {
-
-            if ( std::string(szBuffer).find(c_serialDeviceId) == std::string::npos ) {
-                continue;
-            }
-
-            HKEY hDeviceRegistryKey = { 0 };
-            hDeviceRegistryKey      = SetupDiOpenDevRegKey(DeviceInfoSet, &DeviceInfoData, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
-
-            if ( hDeviceRegistryKey == INVALID_HANDLE_VALUE ) {
-                Error = GetLastError();
-                break;
-            } else {
-                char pszPortName[20]    = { 0 };
-                DWORD dwSize            = sizeof(pszPortName);
-                DWORD dwType            = 0;
-
-                if (
-                    ( RegQueryValueExA(hDeviceRegistryKey, "PortName", NULL, &dwType, (LPBYTE)pszPortName, &dwSize) == ERROR_SUCCESS ) &&
-                    ( dwType == REG_SZ ) )
-                {
-                    // @FIXME: Avoid allocating memory by using a std::string
-                    //         Should we consider implementing a substr function which takes in a char* ?
-                    std::string sPortName = pszPortName;
-                    try {
-                        if ( sPortName.substr( 0, 3 ) == "COM" ) {
-                            int nPortNr = std::stoi( pszPortName + 3 );
-                            if ( nPortNr != 0 ) {
-                                return nPortNr;
-                            }
-                        }
-                    } catch ( ... ) {
-                        printf("Parsing failed for a port\n");
-                    }
-                }
-                RegCloseKey(hDeviceRegistryKey);
-            }
-        }
-    } // while ( SetupDiEnumDeviceInfo(DeviceInfoSet, DeviceIndex, &DeviceInfoData) )
-
-    if (DeviceInfoSet) {
-        SetupDiDestroyDeviceInfoList(DeviceInfoSet);
-    }
-
-    return -1;
-}
-
-static std::string GetLastErrorAsString() {
-    DWORD errorMessageID = ::GetLastError();
-    if (errorMessageID == 0) {
-        return std::string();
-    }
-
-    LPSTR messageBuffer = nullptr;
-
-    size_t size = FormatMessageA(
-        FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
-        NULL,
-        errorMessageID,
-        MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-        (LPSTR)&messageBuffer,
-        0,
-        NULL);
-
-    std::string message(messageBuffer, size);
-
-    LocalFree(messageBuffer);
-
-    return message;
-}
-
-bool SerialCommunicationManager::SetCommunicationTimeout(
-    const uint32_t ReadIntervalTimeout,
-    const uint32_t ReadTotalTimeoutMultiplier,
-    const uint32_t ReadTotalTimeoutConstant,
-    const uint32_t WriteTotalTimeoutMultiplier,
-    const uint32_t WriteTotalTimeoutConstant) const {
-
-    COMMTIMEOUTS timeout = {
-        .ReadIntervalTimeout            = MAXDWORD,
-        .ReadTotalTimeoutMultiplier     = MAXDWORD,
-        .ReadTotalTimeoutConstant       = 10,
-        .WriteTotalTimeoutMultiplier    = WriteTotalTimeoutMultiplier,
-        .WriteTotalTimeoutConstant      = WriteTotalTimeoutConstant,
-    };
-
-    if (!SetCommTimeouts(m_hSerial, &timeout)) {
-        return false;
-    }
-
-    return true;
-}
-
 bool SerialCommunicationManager::Connect() {
     // We're not yet connected
     m_isConnected = false;
 
     LogMessage("Attempting connection to dongle...");
 
-    short port = GetComPort();
-    m_port = "\\\\.\\COM" + std::to_string(port);
-
-    // Try to connect to the given port throuh CreateFile
-    m_hSerial = CreateFileA(m_port.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-
-    if (m_hSerial == INVALID_HANDLE_VALUE) {
-        LogError("Received error connecting to port");
-        return false;
-    }
-
-    // If connected we try to set the comm parameters
-    DCB dcbSerialParams = { 0 };
-
-    if (!GetCommState(m_hSerial, &dcbSerialParams)) {
-        LogError("Failed to get current port parameters");
-        return false;
-    }
-
-    // Define serial connection parameters for the arduino board
-    dcbSerialParams.BaudRate        = CBR_115200;
-    dcbSerialParams.ByteSize        = 8;
-    dcbSerialParams.StopBits        = ONESTOPBIT;
-    dcbSerialParams.Parity          = NOPARITY;
-
-    // reset upon establishing a connection
-    dcbSerialParams.fDtrControl     = DTR_CONTROL_ENABLE;
-    dcbSerialParams.XonChar         = 0x11;
-    dcbSerialParams.XoffLim         = 0x4000;
-    dcbSerialParams.XoffChar        = 0x13;
-    dcbSerialParams.EofChar         = 0x1A;
-    dcbSerialParams.EvtChar         = 0;
-
-    // set the parameters and check for their proper application
-    if (!SetCommState(m_hSerial, &dcbSerialParams)) {
-        LogError("Failed to set serial parameters");
-        return false;
-    }
-
-    if (!SetCommunicationTimeout(MAXDWORD, MAXDWORD, 1000, 5, 0)) {
-        LogError("Failed to set communication timeout");
-        return false;
-    }
-
-    COMMTIMEOUTS timeout = {
-        .ReadIntervalTimeout            = MAXDWORD,
-        .ReadTotalTimeoutMultiplier     = MAXDWORD,
-        .ReadTotalTimeoutConstant       = 10,
-        .WriteTotalTimeoutMultiplier    = 5,
-        .WriteTotalTimeoutConstant      = 0,
-    };
-
-    if (!SetCommTimeouts(m_hSerial, &timeout)) {
-        LogError("Failed to set comm timeouts");
+    // Opening the port also configures it for the dongle
+    if (m_reactorWaitSet != nullptr) {
+        // Under a reactor every dongle shares the device list, so the reactor hands out ports as they arrive. Searching
+        // here could take the port another dongle is about to reconnect to
+        if (m_port.empty() || !m_transport->Open(m_port)) {
+            return false;
+        }
+    } else if (m_port.empty() || !m_transport->Open(m_port)) {
+        // A replugged dongle almost always comes back on the same port, so try that before enumerating every USB device
+        m_port = m_transport->FindDevice();
+        if (m_port.empty()) {
+            LogMessage("Could not find the dongle");
+            return false;
+        }
 
-        return false;
+        if (!m_transport->Open(m_port)) {
+            return false;
+        }
     }
 
     // If everything went fine we're connected
@@ -221,7 +60,8 @@ bool SerialCommunicationManager::Connect() {
 void SerialCommunicationManager::WaitAttemptConnection() {
     LogMessage("Attempting to connect to dongle");
     while (m_threadActive && !IsConnected() && !Connect()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(LISTENER_WAIT_TIME));
+        // Retry as soon as a device is plugged in, rather than sleeping out the full interval
+        m_transport->WaitForDevice(LISTENER_WAIT_TIME);
     }
     if (!m_threadActive) {
         return;
@@ -229,17 +69,20 @@ void SerialCommunicationManager::WaitAttemptConnection() {
 }
 
 void SerialCommunicationManager::BeginListener(
-    const std::function<void(const ContactGloveDevice_t handedness, const GloveInputData_t&)> inputCallback,
-    const std::function<void(const ContactGloveDevice_t handedness, const GlovePacketFingers_t&)> fingersCallback,
-    const std::function<void(const DevicesStatus_t&)> statusCallback,
-    const std::function<void(const DevicesFirmware_t&)> firmwareCallback) {
+    const std::function<void(const ContactGloveDevice_t handedness, const GloveInputData_t&, const uint64_t timestamp)> inputCallback,
+    const std::function<void(const ContactGloveDevice_t handedness, const GlovePacketFingers_t&, const uint64_t timestamp)> fingersCallback,
+    const std::function<void(const ContactGloveDevice_t handedness, const GlovePacketImu_t&, const uint64_t timestamp)> imuCallback,
+    const std::function<void(const DevicesStatus_t&, const uint64_t timestamp)> statusCallback,
+    const std::function<void(const DevicesFirmware_t&, const uint64_t timestamp)> firmwareCallback) {
 
     m_fingersCallback   = fingersCallback;
     m_inputCallback     = inputCallback;
+    m_imuCallback       = imuCallback;
     m_statusCallback    = statusCallback;
     m_firmwareCallback  = firmwareCallback;
 
     m_threadActive = true;
+    m_dispatchThread = std::thread(&SerialCommunicationManager::DispatchThread, this);
     m_serialThread = std::thread(&SerialCommunicationManager::ListenerThread, this);
 }
 
@@ -249,14 +92,22 @@ void SerialCommunicationManager::ListenerThread() {
     PurgeBuffer();
 
     while (m_threadActive) {
-        std::string receivedString;
-
         try {
-            if (!ReceiveNextPacket(receivedString)) {
+            uint64_t framesThisRead = 0;
+            const bool received = ReceiveNextPacket(true, framesThisRead);
+
+            // Wake the dispatch thread once per read rather than once per packet
+            if (framesThisRead > 0) {
+                m_dispatchSignal.fetch_add(1, std::memory_order_release);
+                m_dispatchSignal.notify_one();
+            }
+
+            if (!received) {
                 LogMessage("Detected device error. Disconnecting device and attempting reconnection...");
                 // UpdateDongleState(VRDongleState::disconnected);
 
                 if (DisconnectFromDevice(false)) {
+                    m_framer.Reset();
                     WaitAttemptConnection();
                     LogMessage("Successfully reconnected to device");
                     continue;
@@ -275,144 +126,207 @@ void SerialCommunicationManager::ListenerThread() {
             LogMessage("Received unknown error attempting to decode packet.");
         }
 
-        // If we haven't received anything don't bother with trying to decode anything
-        if (receivedString.empty()) {
-            goto finish;
-        }
-
-    finish:
         // write anything we need to
         WriteQueued();
     }
 }
 
-bool SerialCommunicationManager::ReceiveNextPacket(std::string& buff) {
-    DWORD dwRead    = 0;
-
-    char thisChar   = 0x00;
-    char lastChar   = 0x00;
+bool SerialCommunicationManager::ReceiveNextPacket(const bool wait, uint64_t& outFrames) {
+    size_t bytesRead    = 0;
+    size_t writableSize = 0;
+    uint8_t* pWrite     = m_framer.WriteRegion(writableSize);
 
-    do {
-        lastChar = thisChar;
+    outFrames = 0;
 
-        if (!ReadFile(m_hSerial, &thisChar, 1, &dwRead, NULL)) {
-            LogError("Error reading from file");
-            return false;
-        }
+    // Read everything the dongle has sent so far in one call. The transport sleeps until there is any data in the
+    // input queue, or until it's interrupted to write a command or shut down. A reactor has already waited for us.
+    const bool read = wait
+        ? m_transport->Read(pWrite, writableSize, bytesRead)
+        : m_transport->ReadAvailable(pWrite, writableSize, bytesRead);
+    if (!read) {
+        LogError("Error reading from file");
+        return false;
+    }
 
-        if (dwRead == 0) {
-            break;
-        }
+    if (bytesRead == 0) {
+        return true;
+    }
 
-        // Delimeter is 0, since data is encoded using COBS
-        if (thisChar == 0) {
-            // the last byte will be 0
-            uint8_t* pData = (uint8_t*)malloc(buff.size());
-            if (pData != 0) {
-                memset(pData, 0, buff.size());
-                memcpy(pData, buff.c_str(), buff.size());
-
-                // Decode data
-                cobs::decode(pData, buff.size());
-
-                crc CRC_Result = F_CRC_CalculateCheckSum(pData, buff.size());
-
-                if (CRC_Result == CRC_RESULT_OK) {
-                    ContactGlovePacket_t packet = {};
-                    if (DecodePacket(pData, buff.size(), &packet)) {
-                        switch (packet.type) {
-                            // Invoke callback
-                        case PacketType_t::GloveLeftData:
-                            m_inputCallback(ContactGloveDevice_t::LeftGlove, packet.packet.gloveData);
-                            break;
-                        case PacketType_t::GloveRightData:
-                            m_inputCallback(ContactGloveDevice_t::RightGlove, packet.packet.gloveData);
-                            break;
-                        case PacketType_t::GloveLeftFingers:
-                            m_fingersCallback(ContactGloveDevice_t::LeftGlove, packet.packet.gloveFingers);
-                            break;
-                        case PacketType_t::GloveRightFingers:
-                            m_fingersCallback(ContactGloveDevice_t::RightGlove, packet.packet.gloveFingers);
-                            break;
-                        case PacketType_t::DevicesStatus:
-                            m_statusCallback(packet.packet.status);
-                            break;
-                        case PacketType_t::DevicesFirmware:
-                            m_firmwareCallback(packet.packet.firmware);
-                            break;
-                        }
-                    }
-                }
+    // Every delimiter in this read arrived by the time the read returned, so this is when each of these frames was received
+    const uint64_t receivedAt = protocol::MonotonicTimestamp();
 
-                free(pData);
-            }
+    m_framer.CommitWrite(bytesRead);
+    m_linkStatistics.RecordBytes(bytesRead);
 
-            // Clear buffer
-            buff = "";
-        }
-        else {
-            // Only add the current character if 0 we aren't on the delimeter
-            buff += thisChar;
+    // Handle every complete frame we've received. Frames which failed to decode are only of interest to a capture
+    std::span<const uint8_t> frame;
+    crc checksum = 0;
+    FrameStatus_t status = FrameStatus_t::Decoded;
+    RawFrame_t raw = {};
+    uint64_t framesThisRead = 0;
+    while (m_framer.NextFrameRaw(frame, checksum, status, raw)) {
+        m_recorder.Record(receivedAt, raw, status, checksum);
+        if (status == FrameStatus_t::Decoded) {
+            HandleFrame(frame, checksum, receivedAt);
+            framesThisRead++;
         }
+    }
+    m_recorder.Commit();
 
-        if (buff.size() > MAX_PACKET_SIZE) {
-            LogError("Overflowed controller input. Resetting...");
-            buff = "";
-            break;
-        }
+    m_linkStatistics.RecordFramerErrors(m_framer.Overflows(), m_framer.MalformedFrames());
 
-    } while ((!(thisChar == -1 && lastChar == -1)) && m_threadActive);
+    if (m_framer.Overflows() != m_lastOverflows) {
+        m_lastOverflows = m_framer.Overflows();
+        LogError("Overflowed controller input. Resetting...");
+    }
+
+    m_readCalls++;
+    m_framesReceived += framesThisRead;
+    outFrames = framesThisRead;
 
     return true;
 }
 
-void SerialCommunicationManager::WriteCommand(const std::string& command) {
-    std::scoped_lock lock(m_writeMutex);
-
-    if (!m_isConnected) {
-        LogMessage("Cannot write to dongle as it is not connected.");
-
+void SerialCommunicationManager::HandleFrame(const std::span<const uint8_t> frame, const crc checksum, const uint64_t timestamp) {
+    // The frame has already been COBS decoded by the framer, which computed the CRC over it (including the trailing CRC byte)
+    if (checksum != CRC_RESULT_OK) {
+        m_linkStatistics.RecordCrcFailure();
         return;
     }
 
-    m_queuedWrite = command + "\r\n";
+    ContactGlovePacket_t packet = {};
+    packet.timestamp = timestamp;
+    if (DecodePacket(frame, &packet)) {
+        m_linkStatistics.RecordFrame(packet.type, timestamp);
+        // Never block the serial thread, if the dispatch thread can't keep up the packet is dropped (and counted)
+        m_packetQueue.TryPush(packet);
+    }
 }
 
-bool SerialCommunicationManager::WriteQueued() {
-    std::scoped_lock lock(m_writeMutex);
+void SerialCommunicationManager::DispatchThread() {
+    ContactGlovePacket_t packet = {};
 
-    if (!m_isConnected) {
-        return false;
+    while (m_threadActive) {
+        const uint32_t signal = m_dispatchSignal.load(std::memory_order_acquire);
+
+        while (m_packetQueue.TryPop(packet)) {
+            DispatchPacket(packet);
+        }
+
+        // Sleep until the serial thread queues more packets
+        m_dispatchSignal.wait(signal, std::memory_order_acquire);
     }
+}
 
-    if (m_queuedWrite.empty()) {
-        return true;
+void SerialCommunicationManager::DispatchPacket(const ContactGlovePacket_t& packet) {
+    switch (packet.type) {
+        // Invoke callback
+    case PacketType_t::GloveLeftData:
+    case PacketType_t::GloveRightData:
+        m_inputCallback(packet.device, packet.packet.gloveData, packet.timestamp);
+        break;
+    case PacketType_t::GloveLeftFingers:
+    case PacketType_t::GloveRightFingers:
+        m_fingersCallback(packet.device, packet.packet.gloveFingers, packet.timestamp);
+        break;
+    case PacketType_t::GloveLeftImu:
+    case PacketType_t::GloveRightImu:
+        m_imuCallback(packet.device, packet.packet.gloveImu, packet.timestamp);
+        break;
+    case PacketType_t::DevicesStatus:
+        m_statusCallback(packet.packet.status, packet.timestamp);
+        break;
+    case PacketType_t::DevicesFirmware:
+        m_firmwareCallback(packet.packet.firmware, packet.timestamp);
+        break;
+    default:
+        break;
     }
+}
 
-    const char* buf = m_queuedWrite.c_str();
-    DWORD bytesSend;
-    if (!WriteFile(this->m_hSerial, (void*)buf, (DWORD)m_queuedWrite.size(), &bytesSend, 0)) {
-        LogError("Error writing to port");
-        return false;
+double SerialCommunicationManager::GetFramesPerRead() const {
+    const uint64_t readCalls = m_readCalls;
+    if (readCalls == 0) {
+        return 0.0;
     }
+    return static_cast<double>(m_framesReceived) / static_cast<double>(readCalls);
+}
 
-    printf("Wrote: %s\n", m_queuedWrite.c_str());
+void SerialCommunicationManager::WriteCommand(const std::string_view command, const CommandPriority_t priority) {
+    {
+        std::scoped_lock lock(m_writeMutex);
 
-    m_queuedWrite.clear();
+        if (!m_isConnected) {
+            LogMessage("Cannot write to dongle as it is not connected.");
 
-    return true;
+            return;
+        }
+
+        switch (m_commandQueue.Push(command, priority)) {
+        case CommandQueue::Result_t::Queued:
+        case CommandQueue::Result_t::Coalesced:
+            break;
+        case CommandQueue::Result_t::Full:
+            LogWarning(("Command queue is full, dropping command " + std::string(command)).c_str());
+            return;
+        case CommandQueue::Result_t::TooLong:
+            LogWarning(("Command is too long, dropping command " + std::string(command)).c_str());
+            return;
+        }
+    }
+
+    // Wake the serial thread so the command is written now, rather than once the dongle next sends something
+    Wake();
+}
+
+void SerialCommunicationManager::Wake() {
+    if (m_reactorWaitSet != nullptr) {
+        m_reactorWaitSet->Interrupt();
+    } else {
+        m_transport->Interrupt();
+    }
+}
+
+bool SerialCommunicationManager::WriteQueued() {
+    QueuedCommand_t command = {};
+
+    while (true) {
+        // Only hold the lock while popping, so other threads can keep queueing while we write
+        {
+            std::scoped_lock lock(m_writeMutex);
+
+            if (!m_isConnected) {
+                return false;
+            }
+
+            if (!m_commandQueue.Pop(command)) {
+                return true;
+            }
+        }
+
+        if (!m_transport->Write(reinterpret_cast<const uint8_t*>(command.data), command.length)) {
+            LogError("Error writing to port");
+            return false;
+        }
+
+        printf("Wrote: %.*s", (int)command.length, command.data);
+    }
 }
 
-bool SerialCommunicationManager::PurgeBuffer() const {
-    return PurgeComm(m_hSerial, PURGE_RXCLEAR | PURGE_TXCLEAR);
+bool SerialCommunicationManager::PurgeBuffer() {
+    return m_transport->Purge();
 }
 
 void SerialCommunicationManager::Disconnect() {
     printf("Attempting to disconnect serial\n");
     if (m_threadActive.exchange(false)) {
-        CancelIoEx(m_hSerial, nullptr);
+        m_transport->Interrupt();
         m_serialThread.join();
 
+        m_dispatchSignal.fetch_add(1, std::memory_order_release);
+        m_dispatchSignal.notify_one();
+        m_dispatchThread.join();
+
         printf("Serial joined\n");
     }
 
@@ -425,18 +339,25 @@ void SerialCommunicationManager::Disconnect() {
 
 bool SerialCommunicationManager::DisconnectFromDevice(bool writeDeactivate) {
     if (writeDeactivate) {
-        WriteCommand("BP+VS");
+        // The serial thread has stopped by now, so flush the command ourselves
+        WriteCommand("BP+VS", CommandPriority_t::Config);
+        WriteQueued();
     }
     else {
         LogMessage("Not deactivating Input API as dongle was forcibly disconnected");
     }
 
-    if (!CloseHandle(m_hSerial)) {
+    if (!m_transport->Close()) {
         LogError("Error disconnecting from device");
         return false;
     }
 
-    m_isConnected = false;
+    {
+        // Commands queued for this connection are meaningless to the next one
+        std::scoped_lock lock(m_writeMutex);
+        m_isConnected = false;
+        m_commandQueue.Clear();
+    }
 
     LogMessage("Successfully disconnected from device");
     return true;
@@ -448,12 +369,12 @@ bool SerialCommunicationManager::IsConnected() const {
 
 void SerialCommunicationManager::LogError(const char* message) const {
     // message with port name and last error
-    printf("%s (%s) - Error: %s\n", message, m_port.c_str(), GetLastErrorAsString().c_str());
+    printf("%s (%s) - Error: %s\n", message, m_port.c_str(), m_transport->LastError().c_str());
 }
 
 void SerialCommunicationManager::LogWarning(const char* message) const {
     // message with port name
-    printf("%s (%s) - Warning: %s", message, m_port.c_str(), GetLastErrorAsString().c_str());
+    printf("%s (%s) - Warning: %s", message, m_port.c_str(), m_transport->LastError().c_str());
 }
 
 void SerialCommunicationManager::LogMessage(const char* message) const {
@@ -461,292 +382,31 @@ void SerialCommunicationManager::LogMessage(const char* message) const {
     printf("%s (%s)\n", message, m_port.c_str());
 }
 
-bool SerialCommunicationManager::DecodePacket(const uint8_t* pData, const size_t length, ContactGlovePacket_t* outPacket) const {
-
-    bool decoded = false;
-
-    switch (pData[0]) {
-    case GLOVE_LEFT_PACKET_DATA:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::GloveLeftData;
-
-        // Extract data
-        outPacket->packet.gloveData.joystickX = ((uint16_t*)(pData))[1];
-        outPacket->packet.gloveData.joystickY = ((uint16_t*)(pData))[2];
-
-        uint8_t button_mask = ((uint8_t*)pData)[1];
-
-        // KNOWN VALUES:
-        // None             :: 0x3F   0011 1111
-        // System Up        :: 0x2F   0010 1111
-        // System Down      :: 0x37   0011 0111
-        // A (BTN_DOWN)     :: 0x3E   0011 1110
-        // B (BTN_UP)       :: 0x3D   0011 1101
-        // Joystick Click   :: 0x3B   0011 1011
-        // Magnetra unavail :: 0x1F   0001 1111
-
-        outPacket->packet.gloveData.hasMagnetra     =   (button_mask & CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT)   == CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT;
-        outPacket->packet.gloveData.systemUp        = !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP)          == CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP);
-        outPacket->packet.gloveData.systemDown      = !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN)        == CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN);
-        outPacket->packet.gloveData.buttonUp        = !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_UP)          == CONTACT_GLOVE_INPUT_MASK_BUTTON_UP);
-        outPacket->packet.gloveData.buttonDown      = !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN)        == CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN);
-        outPacket->packet.gloveData.joystickClick   = !((button_mask & CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK)     == CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK);
-
-        // printf("data[L]:: magnetra:%d, sysUp:%d, sysDn:%d, btnUp:%d, btnDn:%d, joyClk:%d (0x%04hX,0x%04hX)\n",
-        //     outPacket->packet.gloveData.hasMagnetra,
-        //     outPacket->packet.gloveData.systemUp,
-        //     outPacket->packet.gloveData.systemDown,
-        //     outPacket->packet.gloveData.buttonUp,
-        //     outPacket->packet.gloveData.buttonDown,
-        //     outPacket->packet.gloveData.joystickClick,
-        //     outPacket->packet.gloveData.joystickX,
-        //     outPacket->packet.gloveData.joystickY);
-
-        // Left glove data packet
-        // PrintBuffer("glove_data_left", pData, length);
-
-        decoded = true;
-    }
-
-    break;
-    case GLOVE_RIGHT_PACKET_DATA:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::GloveRightData;
-
-        // Extract data
-        outPacket->packet.gloveData.joystickX = ((uint16_t*)(pData))[1];
-        outPacket->packet.gloveData.joystickY = ((uint16_t*)(pData))[2];
-
-        uint8_t button_mask = ((uint8_t*)pData)[1];
-
-        // KNOWN VALUES:
-        // None             :: 0x3F   0011 1111
-        // System Up        :: 0x2F   0010 1111
-        // System Down      :: 0x37   0011 0111
-        // A (BTN_DOWN)     :: 0x3E   0011 1110
-        // B (BTN_UP)       :: 0x3D   0011 1101
-        // Joystick Click   :: 0x3B   0011 1011
-        // Magnetra unavail :: 0x1F   0001 1111
-
-        outPacket->packet.gloveData.hasMagnetra     =   (button_mask & CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT)   == CONTACT_GLOVE_INPUT_MASK_MAGNETRA_PRESENT;
-        outPacket->packet.gloveData.systemUp        = !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP)          == CONTACT_GLOVE_INPUT_MASK_SYSTEM_UP);
-        outPacket->packet.gloveData.systemDown      = !((button_mask & CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN)        == CONTACT_GLOVE_INPUT_MASK_SYSTEM_DOWN);
-        outPacket->packet.gloveData.buttonUp        = !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_UP)          == CONTACT_GLOVE_INPUT_MASK_BUTTON_UP);
-        outPacket->packet.gloveData.buttonDown      = !((button_mask & CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN)        == CONTACT_GLOVE_INPUT_MASK_BUTTON_DOWN);
-        outPacket->packet.gloveData.joystickClick   = !((button_mask & CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK)     == CONTACT_GLOVE_INPUT_MASK_JOYSTICK_CLICK);
-
-        // printf("data[R]:: magnetra:%d, sysUp:%d, sysDn:%d, btnUp:%d, btnDn:%d, joyClk:%d (0x%04hX,0x%04hX)\n",
-        //     outPacket->packet.gloveData.hasMagnetra,
-        //     outPacket->packet.gloveData.systemUp,
-        //     outPacket->packet.gloveData.systemDown,
-        //     outPacket->packet.gloveData.buttonUp,
-        //     outPacket->packet.gloveData.buttonDown,
-        //     outPacket->packet.gloveData.joystickClick,
-        //     outPacket->packet.gloveData.joystickX,
-        //     outPacket->packet.gloveData.joystickY);
-
-        // Right glove data packet
-        // PrintBuffer("glove_data_right", pData, length);
-
-        decoded = true;
-    }
-    break;
-    case DEVICES_VERSIONS:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::DevicesFirmware;
-
-        // data is 0x01 0x06 3 times
-
-        // This is version a.b
-        outPacket->packet.firmware.dongleMajor      = ((uint8_t*)pData)[1];
-        outPacket->packet.firmware.dongleMinor      = ((uint8_t*)pData)[2];
-        outPacket->packet.firmware.gloveLeftMajor   = ((uint8_t*)pData)[3];
-        outPacket->packet.firmware.gloveLeftMinor   = ((uint8_t*)pData)[4];
-        outPacket->packet.firmware.gloveRightMajor  = ((uint8_t*)pData)[5];
-        outPacket->packet.firmware.gloveRightMinor  = ((uint8_t*)pData)[6];
-
-        // PrintBuffer("firmware_version", pData, length);
-
-        decoded = true;
-    }
-    break;
-
-    case DEVICES_STATUS:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::DevicesStatus;
-
-        // uint8_t dongle4[8] = { 0x00, 0x1E, 0x50, 0x5F, 0x5A, 0x60, 0x01, 0xA2 };
-
-        outPacket->packet.status.gloveLeftBattery   = ((uint8_t*)pData)[1];
-        outPacket->packet.status.gloveRightBattery  = ((uint8_t*)pData)[3];
-
-        // printf("glove[L]:: %d%%  ; glove[R]:: %d%%\n", outPacket->packet.status.gloveLeftBattery, outPacket->packet.status.gloveRightBattery);
-
-        // PrintBuffer("device_status", pData, length);
-
-        decoded = true;
-    }
-    break;
-
-
-    case GLOVE_POWER_ON_PACKET:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::GlovePowerOn;
-
-        // PrintBuffer("glove_power_on", pData, length);
-
-        decoded = true;
-    }
-    break;
-
-
-    case GLOVE_LEFT_PACKET_FINGERS:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::GloveLeftFingers;
-        // Extract data
-        outPacket->packet.gloveFingers.fingerThumbTip   = ((uint16_t*)(pData + 1))[9];
-        outPacket->packet.gloveFingers.fingerThumbRoot  = ((uint16_t*)(pData + 1))[8];
-        outPacket->packet.gloveFingers.fingerIndexTip   = ((uint16_t*)(pData + 1))[7];
-        outPacket->packet.gloveFingers.fingerIndexRoot  = ((uint16_t*)(pData + 1))[6];
-        outPacket->packet.gloveFingers.fingerMiddleTip  = ((uint16_t*)(pData + 1))[5];
-        outPacket->packet.gloveFingers.fingerMiddleRoot = ((uint16_t*)(pData + 1))[4];
-        outPacket->packet.gloveFingers.fingerRingTip    = ((uint16_t*)(pData + 1))[3];
-        outPacket->packet.gloveFingers.fingerRingRoot   = ((uint16_t*)(pData + 1))[2];
-        outPacket->packet.gloveFingers.fingerPinkyTip   = ((uint16_t*)(pData + 1))[0];
-        outPacket->packet.gloveFingers.fingerPinkyRoot  = ((uint16_t*)(pData + 1))[1];
-
-        // printf(
-        //     "fingers[L]:: (%d, %d) (%d, %d) (%d, %d) (%d, %d) (%d, %d)\n",
-        //     outPacket->packet.gloveFingers.fingerThumbTip,
-        //     outPacket->packet.gloveFingers.fingerThumbRoot,
-        //     outPacket->packet.gloveFingers.fingerIndexTip,
-        //     outPacket->packet.gloveFingers.fingerIndexRoot,
-        //     outPacket->packet.gloveFingers.fingerMiddleTip,
-        //     outPacket->packet.gloveFingers.fingerMiddleRoot,
-        //     outPacket->packet.gloveFingers.fingerRingTip,
-        //     outPacket->packet.gloveFingers.fingerRingRoot,
-        //     outPacket->packet.gloveFingers.fingerPinkyTip,
-        //     outPacket->packet.gloveFingers.fingerPinkyRoot);
-
-        // PrintBuffer("glove_left_fingers", pData, length);
-
-        decoded = true;
-
-    }
-    break;
-    case GLOVE_LEFT_PACKET_IMU:
-    {
-        // @TODO: Imu data is not usable
-
-        // Assign type
-        outPacket->type = PacketType_t::GloveLeftImu;
-        // Extract data
-        outPacket->packet.gloveImu.imu1 = ((uint16_t*)(pData + 1))[0];
-        outPacket->packet.gloveImu.imu2 = ((uint16_t*)(pData + 1))[1];
-
-        outPacket->packet.gloveImu.imu3 = ((uint16_t*)(pData + 1))[2];
-        outPacket->packet.gloveImu.imu4 = ((uint16_t*)(pData + 1))[3];
-
-        outPacket->packet.gloveImu.imu5 = ((float*)(pData + 1))[4];
-        outPacket->packet.gloveImu.imu6 = ((float*)(pData + 1))[5];
+bool SerialCommunicationManager::DecodePacket(const std::span<const uint8_t> frame, ContactGlovePacket_t* outPacket) {
 
-        // printf(
-        //     "imu[L]:: %d, %d, %d, %d [%.6f, %.6f]\n",
-        //     outPacket->packet.gloveImu.imu1,
-        //     outPacket->packet.gloveImu.imu2,
-        //     outPacket->packet.gloveImu.imu3,
-        //     outPacket->packet.gloveImu.imu4,
-        //     outPacket->packet.gloveImu.imu5,
-        //     outPacket->packet.gloveImu.imu6);
-
-        // PrintBuffer("glove_left_imu", pData, length);
-        decoded = true;
-
-    }
-    break;
-
-    case GLOVE_RIGHT_PACKET_FINGERS:
-    {
-        // Assign type
-        outPacket->type = PacketType_t::GloveRightFingers;
-
-        // Extract data
-        outPacket->packet.gloveFingers.fingerThumbTip   = ((uint16_t*)(pData + 1))[9];
-        outPacket->packet.gloveFingers.fingerThumbRoot  = ((uint16_t*)(pData + 1))[8];
-        outPacket->packet.gloveFingers.fingerIndexTip   = ((uint16_t*)(pData + 1))[7];
-        outPacket->packet.gloveFingers.fingerIndexRoot  = ((uint16_t*)(pData + 1))[6];
-        outPacket->packet.gloveFingers.fingerMiddleTip  = ((uint16_t*)(pData + 1))[5];
-        outPacket->packet.gloveFingers.fingerMiddleRoot = ((uint16_t*)(pData + 1))[4];
-        outPacket->packet.gloveFingers.fingerRingTip    = ((uint16_t*)(pData + 1))[3];
-        outPacket->packet.gloveFingers.fingerRingRoot   = ((uint16_t*)(pData + 1))[2];
-        outPacket->packet.gloveFingers.fingerPinkyTip   = ((uint16_t*)(pData + 1))[0];
-        outPacket->packet.gloveFingers.fingerPinkyRoot  = ((uint16_t*)(pData + 1))[1];
-
-        // printf(
-        //     "fingers[R]:: (%d, %d) (%d, %d) (%d, %d) (%d, %d) (%d, %d)\n",
-        //     outPacket->packet.gloveFingers.fingerThumbTip,
-        //     outPacket->packet.gloveFingers.fingerThumbRoot,
-        //     outPacket->packet.gloveFingers.fingerIndexTip,
-        //     outPacket->packet.gloveFingers.fingerIndexRoot,
-        //     outPacket->packet.gloveFingers.fingerMiddleTip,
-        //     outPacket->packet.gloveFingers.fingerMiddleRoot,
-        //     outPacket->packet.gloveFingers.fingerRingTip,
-        //     outPacket->packet.gloveFingers.fingerRingRoot,
-        //     outPacket->packet.gloveFingers.fingerPinkyTip,
-        //     outPacket->packet.gloveFingers.fingerPinkyRoot);
-
-        // PrintBuffer("glove_right_fingers", pData, length);
-
-        decoded = true;
-
-    }
-    break;
-    case GLOVE_RIGHT_PACKET_IMU:
-    {
-        // @TODO: Imu data is not usable
-
-        // Assign type
-        outPacket->type = PacketType_t::GloveRightImu;
-        // Extract data
-        outPacket->packet.gloveImu.imu1 = ((uint16_t*)(pData + 1))[0];
-        outPacket->packet.gloveImu.imu2 = ((uint16_t*)(pData + 1))[1];
-
-        outPacket->packet.gloveImu.imu3 = ((uint16_t*)(pData + 1))[2];
-        outPacket->packet.gloveImu.imu4 = ((uint16_t*)(pData + 1))[3];
-
-        outPacket->packet.gloveImu.imu5 = ((float*)(pData + 1))[0];
-        outPacket->packet.gloveImu.imu6 = ((float*)(pData + 1))[1];
-
-        // printf(
-        //     "imu[R]:: %d, %d, %d, %d [%.6f, %.6f]\n",
-        //     outPacket->packet.gloveImu.imu1,
-        //     outPacket->packet.gloveImu.imu2,
-        //     outPacket->packet.gloveImu.imu3,
-        //     outPacket->packet.gloveImu.imu4,
-        //     outPacket->packet.gloveImu.imu5,
-        //     outPacket->packet.gloveImu.imu6);
-
-        // PrintBuffer("glove_right_imu", pData, length);
-        decoded = true;
-
-    }
+    switch (DecodePacketFrame(frame, outPacket)) {
+    case PacketDecodeResult_t::Decoded:
+        return true;
 
-    break;
+    case PacketDecodeResult_t::UnknownId:
+        if (frame.empty()) {
+            return false;
+        }
+        m_linkStatistics.RecordUnknownId();
+        if (!m_reportedUnknownIds.test(frame[0])) {
+            m_reportedUnknownIds.set(frame[0]);
+            // @FIXME: Use proper logging library
+            printf("[WARN] Got unknown packet with command code 0x%02hX!!\n", frame[0]);
+            PrintBuffer("unknown_packet", frame.data(), frame.size());
+        }
+        return false;
 
-    default:
-        // @FIXME: Use proper logging library
-        printf("[WARN] Got unknown packet with command code 0x%02hX!!\n", pData[0]);
-        PrintBuffer("unknown_packet", pData, length);
-        break;
+    case PacketDecodeResult_t::BadLength:
+        m_linkStatistics.RecordRejectedLength();
+        return false;
     }
 
-    return decoded;
+    return false;
 }
 
 /*
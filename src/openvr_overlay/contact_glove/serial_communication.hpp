@@ -1,51 +1,89 @@
 #pragma once
 
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-
 #include <functional>
 #include <memory>
 #include <atomic>
+#include <bitset>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <string_view>
 #include <thread>
 
 #include "crc.hpp"
+#include "capture_recorder.hpp"
 #include "contact_glove_structs.hpp"
+#include "command_queue.hpp"
+#include "link_statistics.hpp"
+#include "packet_framer.hpp"
+#include "serial_transport.hpp"
+#include "../spsc_queue.hpp"
+#include "../../timestamp.hpp"
+
+// Number of decoded packets which can wait to be dispatched to the callbacks. Must be a power of 2, and comfortably
+// larger than the number of frames a single read can produce, as the dispatch thread is woken once per read.
+constexpr size_t PACKET_QUEUE_SIZE = 1024;
+
+class SerialReactor;
 
+/// <summary>
+/// Connection to a single dongle. Either runs its own serial and dispatch threads (BeginListener), or is serviced by a
+/// SerialReactor together with other dongles.
+/// </summary>
 class SerialCommunicationManager {
+    friend class SerialReactor;
+
 public:
     SerialCommunicationManager()
-        : m_isConnected(false), m_hSerial(0), m_errors(0), m_writeMutex(), m_queuedWrite("") {};
+        : SerialCommunicationManager(CreateSerialTransport()) {};
+    explicit SerialCommunicationManager(std::unique_ptr<ISerialTransport> transport)
+        : m_isConnected(false), m_transport(std::move(transport)), m_errors(0), m_dispatchSignal(0), m_writeMutex(), m_commandQueue(), m_reactorWaitSet(nullptr), m_lastOverflows(0), m_readCalls(0), m_framesReceived(0), m_linkStatistics(), m_reportedUnknownIds(), m_recorder() {};
 
+    // Callbacks are invoked from a dispatch thread, so a slow callback never stalls reading from the dongle.
+    // Every callback receives the time at which the packet was received, see protocol::MonotonicTimestamp
     void BeginListener(
-        const std::function<void(const ContactGloveDevice_t, const GloveInputData_t&)> inputCallback,
-        const std::function<void(const ContactGloveDevice_t, const GlovePacketFingers_t&)> fingersCallback,
-        const std::function<void(const DevicesStatus_t&)> statusCallback,
-        const std::function<void(const DevicesFirmware_t&)> firmwareCallback);
+        const std::function<void(const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t)> inputCallback,
+        const std::function<void(const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t)> fingersCallback,
+        const std::function<void(const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t)> imuCallback,
+        const std::function<void(const DevicesStatus_t&, const uint64_t)> statusCallback,
+        const std::function<void(const DevicesFirmware_t&, const uint64_t)> firmwareCallback);
     bool IsConnected() const;
     void Disconnect();
-    void WriteCommand(const std::string& command);
+    // Queues a command for the serial thread to write to the dongle. More urgent commands are written first
+    void WriteCommand(const std::string_view command, const CommandPriority_t priority = CommandPriority_t::Config);
+    // Average number of frames extracted per successful read call
+    double GetFramesPerRead() const;
+    // Frames with a valid CRC which were dropped for having the wrong length for their packet type
+    inline uint64_t GetRejectedFrames() const { return m_linkStatistics.RejectedLengths(); }
+    // Link quality counters, safe to call from any thread
+    inline void GetLinkStatistics(LinkStatistics_t& outStatistics) const { m_linkStatistics.Snapshot(outStatistics); }
+    // Decoded packets waiting for the dispatch thread
+    inline size_t GetPacketQueueDepth() const { return m_packetQueue.Size(); }
+    // Decoded packets dropped because the dispatch thread fell behind
+    inline uint64_t GetDroppedPackets() const { return m_packetQueue.Dropped(); }
+    // Records every raw frame received from the dongle to a capture file, until StopCapture is called
+    inline bool StartCapture(const std::string& path) { return m_recorder.Start(path); }
+    inline void StopCapture() { m_recorder.Stop(); }
+    inline bool IsCapturing() const { return m_recorder.IsRecording(); }
 
 private:
     bool Connect();
-    bool SetCommunicationTimeout(
-        const uint32_t readIntervalTimeout,
-        const uint32_t readTotalTimeoutMultiplier,
-        const uint32_t readTotalTimeoutConstant,
-        const uint32_t writeTotalTimeoutMultiplier,
-        const uint32_t WriteTotalTimeoutConstant) const;
     void ListenerThread();
-    bool ReceiveNextPacket(std::string& buff);
-    bool PurgeBuffer() const;
+    void DispatchThread();
+    void DispatchPacket(const ContactGlovePacket_t& packet);
+    // Reads from the dongle and queues every packet received, blocking until data arrives if wait is set
+    bool ReceiveNextPacket(const bool wait, uint64_t& outFrames);
+    void HandleFrame(const std::span<const uint8_t> frame, const crc checksum, const uint64_t timestamp);
+    bool PurgeBuffer();
     void WaitAttemptConnection();
     bool DisconnectFromDevice(bool writeDeactivate = true);
     bool WriteQueued();
-    int GetComPort() const;
+    // Wakes whichever thread services this dongle
+    void Wake();
 
-    bool DecodePacket(const uint8_t* pData, const size_t length, ContactGlovePacket_t* outPacket) const;
+    bool DecodePacket(const std::span<const uint8_t> frame, ContactGlovePacket_t* outPacket);
 
     void LogMessage(const char* message) const;
     void LogError(const char* message) const;
@@ -53,23 +91,48 @@ private:
 
 private:
     std::atomic<bool> m_isConnected;
-    // Serial com handler
-    HANDLE m_hSerial;
+    // Platform specific serial port
+    std::unique_ptr<ISerialTransport> m_transport;
     // Error tracking
-    DWORD m_errors;
+    uint32_t m_errors;
 
     std::string m_port;
 
     std::atomic<bool> m_threadActive;
     std::thread m_serialThread;
+    std::thread m_dispatchThread;
+
+    // Decoded packets, pushed by the serial thread and drained by the dispatch thread
+    SpscQueue<ContactGlovePacket_t, PACKET_QUEUE_SIZE> m_packetQueue;
+    // Bumped by the serial thread whenever it queued packets (or on shutdown), to wake the dispatch thread
+    std::atomic<uint32_t> m_dispatchSignal;
 
+    // Guards m_commandQueue
     std::mutex m_writeMutex;
 
-    std::string m_queuedWrite;
+    CommandQueue m_commandQueue;
+
+    // Set when a SerialReactor services this dongle, which sleeps on this rather than on our transport
+    ISerialWaitSet* m_reactorWaitSet;
+
+    // Bulk reads land here, and get decoded into frames
+    PacketFramer m_framer;
+    uint32_t m_lastOverflows;
+
+    // Read statistics
+    std::atomic<uint64_t> m_readCalls;
+    std::atomic<uint64_t> m_framesReceived;
+    LinkStatistics m_linkStatistics;
+    // Unknown packet ids are only printed the first time they're seen, to not stall the serial thread on a noisy link
+    std::bitset<256> m_reportedUnknownIds;
+
+    // Optional capture of the raw link, written from a background thread
+    CaptureRecorder m_recorder;
 
     // Callbacks
-    std::function<void(const ContactGloveDevice_t handedness, const GlovePacketFingers_t&)> m_fingersCallback;
-    std::function<void(const ContactGloveDevice_t handedness, const GloveInputData_t&)> m_inputCallback;
-    std::function<void(const DevicesStatus_t&)> m_statusCallback;
-    std::function<void(const DevicesFirmware_t&)> m_firmwareCallback;
+    std::function<void(const ContactGloveDevice_t handedness, const GlovePacketFingers_t&, const uint64_t timestamp)> m_fingersCallback;
+    std::function<void(const ContactGloveDevice_t handedness, const GloveInputData_t&, const uint64_t timestamp)> m_inputCallback;
+    std::function<void(const ContactGloveDevice_t handedness, const GlovePacketImu_t&, const uint64_t timestamp)> m_imuCallback;
+    std::function<void(const DevicesStatus_t&, const uint64_t timestamp)> m_statusCallback;
+    std::function<void(const DevicesFirmware_t&, const uint64_t timestamp)> m_firmwareCallback;
 };
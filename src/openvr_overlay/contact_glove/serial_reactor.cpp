@@ -0,0 +1,263 @@
+#include "serial_reactor.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+// Fallback retry interval for disconnected dongles, in case a device arrival notification is missed
+static const uint32_t REACTOR_RETRY_TIME = 1000;
+
+SerialReactor::~SerialReactor() {
+    Disconnect();
+}
+
+size_t SerialReactor::AddDongle(std::unique_ptr<ISerialTransport> transport, const std::string& port) {
+    const size_t dongle = m_dongleCount.load(std::memory_order_relaxed);
+    if (dongle >= REACTOR_MAX_DONGLES) {
+        throw std::runtime_error("Too many dongles for one serial reactor");
+    }
+
+    ISerialTransport* pTransport = transport.get();
+
+    m_dongles[dongle] = std::make_unique<SerialCommunicationManager>(std::move(transport));
+    m_dongles[dongle]->m_reactorWaitSet = m_waitSet.get();
+    m_dongles[dongle]->m_port = port;
+    // Ahead of the device watcher, which always comes last
+    m_transports.insert(m_transports.begin() + dongle, pTransport);
+    m_events.insert(m_events.begin() + dongle, SerialEvent_t::None);
+
+    // The dongle is fully set up before the dispatch thread can see it
+    m_dongleCount.store(dongle + 1, std::memory_order_release);
+    return dongle;
+}
+
+size_t SerialReactor::AddConnectedDongles() {
+    if (m_deviceWatcher == nullptr) {
+        m_deviceWatcher = CreateSerialTransport();
+        m_transports.push_back(m_deviceWatcher.get());
+        m_events.push_back(SerialEvent_t::None);
+    }
+
+    const std::vector<std::string> ports = m_deviceWatcher->FindDevices();
+    for (const std::string& port : ports) {
+        if (GetDongleCount() >= REACTOR_MAX_DONGLES) {
+            printf("Found %zu dongles, only the first %zu can be serviced\n", ports.size(), REACTOR_MAX_DONGLES);
+            break;
+        }
+        AddDongle(CreateSerialTransport(port), port);
+    }
+
+    // Nothing plugged in yet, wait for whichever dongle shows up first
+    if (ports.empty()) {
+        AddDongle(CreateSerialTransport());
+    }
+
+    return GetDongleCount();
+}
+
+void SerialReactor::BeginListener(
+    const std::function<void(const size_t dongle, const ContactGloveDevice_t handedness, const GloveInputData_t&, const uint64_t timestamp)> inputCallback,
+    const std::function<void(const size_t dongle, const ContactGloveDevice_t handedness, const GlovePacketFingers_t&, const uint64_t timestamp)> fingersCallback,
+    const std::function<void(const size_t dongle, const ContactGloveDevice_t handedness, const GlovePacketImu_t&, const uint64_t timestamp)> imuCallback,
+    const std::function<void(const size_t dongle, const DevicesStatus_t&, const uint64_t timestamp)> statusCallback,
+    const std::function<void(const size_t dongle, const DevicesFirmware_t&, const uint64_t timestamp)> firmwareCallback) {
+
+    // Kept for dongles plugged in while listening
+    m_inputCallback     = inputCallback;
+    m_fingersCallback   = fingersCallback;
+    m_imuCallback       = imuCallback;
+    m_statusCallback    = statusCallback;
+    m_firmwareCallback  = firmwareCallback;
+
+    for (size_t i = 0; i < GetDongleCount(); i++) {
+        BindCallbacks(i);
+    }
+
+    m_threadActive = true;
+    m_dispatchThread = std::thread(&SerialReactor::DispatchThread, this);
+    m_reactorThread = std::thread(&SerialReactor::ReactorThread, this);
+}
+
+void SerialReactor::BindCallbacks(const size_t dongle) {
+    // Each dongle dispatches its own packets, tagged with its index
+    SerialCommunicationManager& manager = *m_dongles[dongle];
+
+    manager.m_inputCallback     = [this, dongle](const ContactGloveDevice_t handedness, const GloveInputData_t& data, const uint64_t timestamp) { m_inputCallback(dongle, handedness, data, timestamp); };
+    manager.m_fingersCallback   = [this, dongle](const ContactGloveDevice_t handedness, const GlovePacketFingers_t& data, const uint64_t timestamp) { m_fingersCallback(dongle, handedness, data, timestamp); };
+    manager.m_imuCallback       = [this, dongle](const ContactGloveDevice_t handedness, const GlovePacketImu_t& data, const uint64_t timestamp) { m_imuCallback(dongle, handedness, data, timestamp); };
+    manager.m_statusCallback    = [this, dongle](const DevicesStatus_t& status, const uint64_t timestamp) { m_statusCallback(dongle, status, timestamp); };
+    manager.m_firmwareCallback  = [this, dongle](const DevicesFirmware_t& firmware, const uint64_t timestamp) { m_firmwareCallback(dongle, firmware, timestamp); };
+}
+
+void SerialReactor::TryConnect(SerialCommunicationManager& manager) {
+    if (manager.Connect()) {
+        manager.PurgeBuffer();
+    }
+}
+
+void SerialReactor::HandleDeviceError(SerialCommunicationManager& manager) {
+    manager.LogMessage("Detected device error. Disconnecting device and attempting reconnection...");
+
+    // Reconnection happens once the dongle is plugged back in, without holding up the other dongles
+    manager.DisconnectFromDevice(false);
+    manager.m_framer.Reset();
+}
+
+void SerialReactor::AddArrivedDongles() {
+    const std::vector<std::string> ports = m_deviceWatcher->FindDevices();
+    for (const std::string& port : ports) {
+        const size_t dongleCount = GetDongleCount();
+
+        bool claimed = false;
+        SerialCommunicationManager* pWaiting = nullptr;
+        for (size_t i = 0; i < dongleCount && !claimed; i++) {
+            SerialCommunicationManager& manager = *m_dongles[i];
+            claimed = manager.m_port == port;
+            // Waiting for a port if it never had one, or if it was unplugged and its port has gone
+            const bool waiting = !manager.IsConnected() && (manager.m_port.empty() || std::find(ports.begin(), ports.end(), manager.m_port) == ports.end());
+            if (pWaiting == nullptr && waiting) {
+                pWaiting = &manager;
+            }
+        }
+        if (claimed) {
+            continue;
+        }
+
+        // A dongle waiting for a port takes it, rather than racing a new dongle for it
+        if (pWaiting != nullptr) {
+            pWaiting->m_port = port;
+            TryConnect(*pWaiting);
+            continue;
+        }
+
+        if (dongleCount >= REACTOR_MAX_DONGLES) {
+            printf("Dongle plugged in on %s, but %zu dongles are already being serviced\n", port.c_str(), dongleCount);
+            continue;
+        }
+
+        const size_t dongle = AddDongle(CreateSerialTransport(port), port);
+        BindCallbacks(dongle);
+        printf("Dongle plugged in on %s, servicing it as dongle %zu\n", port.c_str(), dongle);
+        TryConnect(*m_dongles[dongle]);
+    }
+}
+
+void SerialReactor::ReactorThread() {
+    for (size_t i = 0; i < GetDongleCount(); i++) {
+        TryConnect(*m_dongles[i]);
+    }
+    m_nextRetry = std::chrono::steady_clock::now() + std::chrono::milliseconds(REACTOR_RETRY_TIME);
+
+    while (m_threadActive) {
+        if (!m_waitSet->Wait(m_transports, m_events, REACTOR_RETRY_TIME)) {
+            printf("Failed to wait on dongles, stopping reactor\n");
+            return;
+        }
+
+        const bool retryDue = std::chrono::steady_clock::now() >= m_nextRetry;
+        if (retryDue) {
+            m_nextRetry = std::chrono::steady_clock::now() + std::chrono::milliseconds(REACTOR_RETRY_TIME);
+        }
+
+        const size_t dongleCount = GetDongleCount();
+        bool framesQueued = false;
+        bool deviceArrived = false;
+        for (size_t i = 0; i < dongleCount; i++) {
+            SerialCommunicationManager& manager = *m_dongles[i];
+
+            if (!manager.IsConnected()) {
+                if (m_events[i] != SerialEvent_t::None) {
+                    // A device arrived, consume the notification
+                    size_t unused = 0;
+                    m_transports[i]->ReadAvailable(nullptr, 0, unused);
+                    deviceArrived = true;
+                }
+                if (m_events[i] != SerialEvent_t::None || retryDue) {
+                    TryConnect(manager);
+                }
+                continue;
+            }
+
+            try {
+                if (m_events[i] == SerialEvent_t::Error) {
+                    HandleDeviceError(manager);
+                    continue;
+                }
+
+                if (m_events[i] == SerialEvent_t::Ready) {
+                    uint64_t frames = 0;
+                    if (!manager.ReceiveNextPacket(false, frames)) {
+                        HandleDeviceError(manager);
+                        continue;
+                    }
+                    framesQueued |= frames > 0;
+                }
+            }
+            catch (const std::invalid_argument& ia) {
+                manager.LogMessage((std::string("Received error from encoding: ") + ia.what()).c_str());
+            }
+            catch (...) {
+                manager.LogMessage("Received unknown error attempting to decode packet.");
+            }
+
+            // write anything we need to
+            manager.WriteQueued();
+        }
+
+        // Connected dongles never see a device arrive, the watcher (after the last dongle) does it for them
+        if (m_deviceWatcher != nullptr) {
+            if (m_events[dongleCount] != SerialEvent_t::None) {
+                size_t unused = 0;
+                m_deviceWatcher->ReadAvailable(nullptr, 0, unused);
+                deviceArrived = true;
+            }
+
+            // Without arrival notifications, enumerate on the retry interval instead
+            if (deviceArrived || (retryDue && m_deviceWatcher->BeginWait() == SERIAL_INVALID_WAIT_HANDLE)) {
+                AddArrivedDongles();
+            }
+        }
+
+        // Wake the dispatch thread once per wait rather than once per packet
+        if (framesQueued) {
+            m_dispatchSignal.fetch_add(1, std::memory_order_release);
+            m_dispatchSignal.notify_one();
+        }
+    }
+}
+
+void SerialReactor::DispatchThread() {
+    ContactGlovePacket_t packet = {};
+
+    while (m_threadActive) {
+        const uint32_t signal = m_dispatchSignal.load(std::memory_order_acquire);
+
+        const size_t dongleCount = GetDongleCount();
+        for (size_t i = 0; i < dongleCount; i++) {
+            SerialCommunicationManager& manager = *m_dongles[i];
+            while (manager.m_packetQueue.TryPop(packet)) {
+                manager.DispatchPacket(packet);
+            }
+        }
+
+        // Sleep until the serial thread queues more packets
+        m_dispatchSignal.wait(signal, std::memory_order_acquire);
+    }
+}
+
+void SerialReactor::Disconnect() {
+    if (m_threadActive.exchange(false)) {
+        m_waitSet->Interrupt();
+        m_reactorThread.join();
+
+        m_dispatchSignal.fetch_add(1, std::memory_order_release);
+        m_dispatchSignal.notify_one();
+        m_dispatchThread.join();
+    }
+
+    for (size_t i = 0; i < GetDongleCount(); i++) {
+        if (m_dongles[i]->IsConnected()) {
+            m_dongles[i]->DisconnectFromDevice(true);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "serial_communication.hpp"
+#include "serial_transport.hpp"
+
+// Most dongles a reactor services, including any plugged in while it is running
+constexpr size_t REACTOR_MAX_DONGLES = 16;
+
+/// <summary>
+/// Services any number of dongles from one serial thread and one dispatch thread, rather than two threads per dongle.
+/// The serial thread sleeps on every dongle at once through an ISerialWaitSet, and only reads the ones with data.
+/// </summary>
+class SerialReactor {
+public:
+    SerialReactor()
+        : SerialReactor(CreateSerialWaitSet()) {};
+    explicit SerialReactor(std::unique_ptr<ISerialWaitSet> waitSet)
+        : m_waitSet(std::move(waitSet)), m_dongleCount(0), m_threadActive(false), m_dispatchSignal(0) {};
+    ~SerialReactor();
+
+    // Adds a dongle read through the given transport, returning the index passed to the callbacks. Only valid before BeginListener.
+    // Without a port the dongle waits for the reactor to hand it one as dongles are plugged in
+    size_t AddDongle(std::unique_ptr<ISerialTransport> transport, const std::string& port = std::string());
+    /// <summary>
+    /// Adds every dongle currently plugged in, or a single dongle waiting to be plugged in if there are none. Once
+    /// listening, dongles plugged in later are added too, with the next free index.
+    /// </summary>
+    size_t AddConnectedDongles();
+
+    // Grows while listening if dongles are plugged in, see AddConnectedDongles. Safe to call from any thread
+    inline size_t GetDongleCount() const { return m_dongleCount.load(std::memory_order_acquire); }
+    // For writing commands and reading statistics of a single dongle
+    inline SerialCommunicationManager& GetDongle(const size_t dongle) { return *m_dongles[dongle]; }
+
+    // Callbacks are invoked from the dispatch thread, with the index of the dongle the packet came from
+    void BeginListener(
+        const std::function<void(const size_t, const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t)> inputCallback,
+        const std::function<void(const size_t, const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t)> fingersCallback,
+        const std::function<void(const size_t, const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t)> imuCallback,
+        const std::function<void(const size_t, const DevicesStatus_t&, const uint64_t)> statusCallback,
+        const std::function<void(const size_t, const DevicesFirmware_t&, const uint64_t)> firmwareCallback);
+    void Disconnect();
+
+private:
+    void ReactorThread();
+    void DispatchThread();
+    void TryConnect(SerialCommunicationManager& manager);
+    void HandleDeviceError(SerialCommunicationManager& manager);
+    // Points the dongle's callbacks at ours, tagged with its index
+    void BindCallbacks(const size_t dongle);
+    // Enumerates dongles again after a device arrival, and starts servicing any on a port no dongle has claimed
+    void AddArrivedDongles();
+
+private:
+    std::unique_ptr<ISerialWaitSet> m_waitSet;
+
+    // Fixed size, so the dispatch thread can walk the first m_dongleCount while the serial thread adds another
+    std::array<std::unique_ptr<SerialCommunicationManager>, REACTOR_MAX_DONGLES> m_dongles;
+    std::atomic<size_t> m_dongleCount;
+    // Parallel to m_dongles, in the shape ISerialWaitSet wants them. Followed by m_deviceWatcher if there is one
+    std::vector<ISerialTransport*> m_transports;
+    std::vector<SerialEvent_t> m_events;
+
+    // Never opened, so its wait handle is signalled whenever a device arrives. Only set by AddConnectedDongles
+    std::unique_ptr<ISerialTransport> m_deviceWatcher;
+
+    std::function<void(const size_t, const ContactGloveDevice_t, const GloveInputData_t&, const uint64_t)> m_inputCallback;
+    std::function<void(const size_t, const ContactGloveDevice_t, const GlovePacketFingers_t&, const uint64_t)> m_fingersCallback;
+    std::function<void(const size_t, const ContactGloveDevice_t, const GlovePacketImu_t&, const uint64_t)> m_imuCallback;
+    std::function<void(const size_t, const DevicesStatus_t&, const uint64_t)> m_statusCallback;
+    std::function<void(const size_t, const DevicesFirmware_t&, const uint64_t)> m_firmwareCallback;
+
+    std::atomic<bool> m_threadActive;
+    std::thread m_reactorThread;
+    std::thread m_dispatchThread;
+
+    // Bumped by the serial thread whenever any dongle queued packets (or on shutdown), to wake the dispatch thread
+    std::atomic<uint32_t> m_dispatchSignal;
+
+    // Disconnected dongles are retried on a device arrival, or once this passes
+    std::chrono::steady_clock::time_point m_nextRetry;
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+// Native handle a transport can be waited on through: an event on Win32, a file descriptor elsewhere
+#ifdef _WIN32
+using SerialWaitHandle_t = void*;
+constexpr SerialWaitHandle_t SERIAL_INVALID_WAIT_HANDLE = nullptr;
+#else
+using SerialWaitHandle_t = int;
+constexpr SerialWaitHandle_t SERIAL_INVALID_WAIT_HANDLE = -1;
+#endif
+
+/// <summary>
+/// Platform specific access to the dongle's serial port. The serial manager only talks to the dongle through this,
+/// so the ingest pipeline (framing, COBS, CRC, decoding) is the same on every platform.
+/// </summary>
+class ISerialTransport {
+public:
+    virtual ~ISerialTransport() = default;
+
+    /// <summary>
+    /// Locates the dongle, returning the path of its port, or an empty string if no dongle is present.
+    /// </summary>
+    virtual std::string FindDevice() const = 0;
+    // Locates every connected dongle, returning the paths of their ports
+    virtual std::vector<std::string> FindDevices() const = 0;
+
+    /// <summary>
+    /// Sleeps until a serial device may have been plugged in, Interrupt is called, or timeoutMs elapses. Returns true if a
+    /// device arrived, meaning FindDevice is worth calling again.
+    /// </summary>
+    virtual bool WaitForDevice(const uint32_t timeoutMs) = 0;
+
+    // Opens the port and configures it for the dongle (115200 8N1)
+    virtual bool Open(const std::string& port) = 0;
+    virtual bool Close() = 0;
+    virtual bool IsOpen() const = 0;
+
+    /// <summary>
+    /// Reads everything currently available, up to size bytes. Sleeps until any data is available, or until Interrupt is
+    /// called in which case outRead is set to 0. Returns false if the device errored, in which case it should be reopened.
+    /// </summary>
+    virtual bool Read(uint8_t* buffer, const size_t size, size_t& outRead) = 0;
+
+    /// <summary>
+    /// Non-blocking counterpart to Read, for waiting on many transports from one thread. Returns a handle which becomes
+    /// signalled (or readable) once there is data to read if the port is open, or once a device may have arrived if it is
+    /// closed. Returns SERIAL_INVALID_WAIT_HANDLE if there is nothing to wait on.
+    /// </summary>
+    virtual SerialWaitHandle_t BeginWait() = 0;
+    // Reads whatever has arrived without blocking, completing a wait started by BeginWait
+    virtual bool ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) = 0;
+    virtual bool Write(const uint8_t* buffer, const size_t size) = 0;
+
+    // Discards anything waiting in the input and output queues
+    virtual bool Purge() = 0;
+
+    // Makes a Read or WaitForDevice blocked on another thread return early, e.g. so that queued commands are written
+    virtual void Interrupt() = 0;
+
+    // Description of the last OS error, for logging
+    virtual std::string LastError() const = 0;
+};
+
+enum class SerialEvent_t : uint8_t {
+    None,
+    // The transport's wait handle was signalled, see ISerialTransport::BeginWait
+    Ready,
+    // The device hung up, reading from it will fail
+    Error,
+};
+
+/// <summary>
+/// Waits on many transports at once, so a single thread can service every dongle plugged into the machine.
+/// </summary>
+class ISerialWaitSet {
+public:
+    virtual ~ISerialWaitSet() = default;
+
+    /// <summary>
+    /// Starts a wait on every transport and sleeps until at least one of them is signalled, Interrupt is called, or
+    /// timeoutMs elapses. outEvents receives what happened to each transport. Returns false if waiting failed.
+    /// </summary>
+    virtual bool Wait(std::span<ISerialTransport* const> transports, std::span<SerialEvent_t> outEvents, const uint32_t timeoutMs) = 0;
+
+    // Makes a Wait blocked on another thread return early
+    virtual void Interrupt() = 0;
+};
+
+// Creates the transport for the platform we're running on
+std::unique_ptr<ISerialTransport> CreateSerialTransport();
+// Creates a transport bound to the given port, for when several dongles are connected
+std::unique_ptr<ISerialTransport> CreateSerialTransport(const std::string& port);
+// Creates the wait set for the platform we're running on
+std::unique_ptr<ISerialWaitSet> CreateSerialWaitSet();
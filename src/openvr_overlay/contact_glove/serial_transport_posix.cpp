@@ -0,0 +1,377 @@
+#ifdef __linux__
+
+#include "serial_transport_posix.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// CP210x USB to UART bridge used by the dongle
+static const std::string c_serialVendorId   = "10c4";
+static const std::string c_serialProductId  = "7b27";
+
+// Read sleeps until the port is readable or Interrupt is called, there is no need to poll
+static const int READ_TIMEOUT_MS            = -1;
+// The port is non-blocking, so a full output buffer is waited on for up to this long before the write fails. Commands
+// are a few bytes, which a dongle that is still attached drains in well under this
+static const int WRITE_TIMEOUT_MS           = 100;
+
+std::unique_ptr<ISerialTransport> CreateSerialTransport() {
+    return std::make_unique<PosixSerialTransport>();
+}
+
+std::unique_ptr<ISerialTransport> CreateSerialTransport(const std::string& port) {
+    return std::make_unique<PosixSerialTransport>(port);
+}
+
+std::unique_ptr<ISerialWaitSet> CreateSerialWaitSet() {
+    return std::make_unique<PosixSerialWaitSet>();
+}
+
+PosixSerialTransport::PosixSerialTransport()
+    : PosixSerialTransport(std::string()) {}
+
+PosixSerialTransport::PosixSerialTransport(const std::string& devicePath)
+    : m_devicePath(devicePath), m_fd(-1), m_epollFd(-1), m_wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      m_inotifyFd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+    // udev creates the tty node once the dongle has enumerated, and fixes up its permissions right after
+    if (m_inotifyFd >= 0 && inotify_add_watch(m_inotifyFd, "/dev", IN_CREATE | IN_ATTRIB) < 0) {
+        // WaitForDevice falls back to its timeout
+        printf("Failed to watch /dev for devices, falling back to polling\n");
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+}
+
+PosixSerialTransport::~PosixSerialTransport() {
+    if (IsOpen()) {
+        Close();
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+    }
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+    }
+}
+
+static std::string ReadSysfsAttribute(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    std::string value;
+    std::getline(file, value);
+    return value;
+}
+
+std::string PosixSerialTransport::FindDevice() const {
+    if (!m_devicePath.empty()) {
+        return m_devicePath;
+    }
+
+    const std::vector<std::string> devices = FindDevices();
+    return devices.empty() ? std::string() : devices.front();
+}
+
+std::vector<std::string> PosixSerialTransport::FindDevices() const {
+    std::vector<std::string> devices;
+
+    std::error_code error;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("/sys/class/tty", error)) {
+        // Walk up from the tty to the USB device it belongs to, which is the one exposing idVendor and idProduct
+        std::filesystem::path device = std::filesystem::canonical(entry.path() / "device", error);
+        if (error) {
+            error.clear();
+            continue;
+        }
+
+        for (; device.has_relative_path(); device = device.parent_path()) {
+            if (std::filesystem::exists(device / "idVendor", error)) {
+                if (ReadSysfsAttribute(device / "idVendor") == c_serialVendorId &&
+                    ReadSysfsAttribute(device / "idProduct") == c_serialProductId) {
+                    devices.push_back("/dev/" + entry.path().filename().string());
+                }
+                break;
+            }
+        }
+    }
+
+    // Directory order is arbitrary, keep dongle indices stable between runs
+    std::sort(devices.begin(), devices.end());
+    return devices;
+}
+
+bool PosixSerialTransport::WaitForDevice(const uint32_t timeoutMs) {
+    pollfd fds[2] = {};
+    fds[0].fd       = m_wakeFd;
+    fds[0].events   = POLLIN;
+    fds[1].fd       = m_inotifyFd;
+    fds[1].events   = POLLIN;
+
+    // poll ignores negative fds, so without inotify this is a plain interruptible sleep
+    if (poll(fds, 2, static_cast<int>(timeoutMs)) <= 0) {
+        return false;
+    }
+
+    if (fds[0].revents & POLLIN) {
+        uint64_t wakeCount = 0;
+        (void)read(m_wakeFd, &wakeCount, sizeof(wakeCount));
+    }
+
+    bool arrived = false;
+    if (fds[1].revents & POLLIN) {
+        // Drain every pending event, we only care that something changed
+        alignas(inotify_event) char events[4096];
+        while (read(m_inotifyFd, events, sizeof(events)) > 0) {
+            arrived = true;
+        }
+    }
+
+    return arrived;
+}
+
+bool PosixSerialTransport::Open(const std::string& port) {
+    m_fd = open(port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) {
+        printf("Received error connecting to port (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        return false;
+    }
+
+    // Like a Win32 COM port, only one handle may have the dongle open, so two managers can never share one
+    if (ioctl(m_fd, TIOCEXCL) != 0) {
+        printf("Failed to take exclusive access to port (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    termios tty = {};
+    if (tcgetattr(m_fd, &tty) != 0) {
+        printf("Failed to get current port parameters (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    // 115200 8N1, raw bytes with no line discipline or flow control
+    cfmakeraw(&tty);
+    cfsetispeed(&tty, B115200);
+    cfsetospeed(&tty, B115200);
+    tty.c_cflag     |= CLOCAL | CREAD;
+    tty.c_cflag     &= ~(CSTOPB | CRTSCTS);
+    tty.c_cc[VMIN]  = 0;
+    tty.c_cc[VTIME] = 0;
+
+    if (tcsetattr(m_fd, TCSANOW, &tty) != 0) {
+        printf("Failed to set serial parameters (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    m_epollFd   = epoll_create1(EPOLL_CLOEXEC);
+    if (m_wakeFd < 0 || m_epollFd < 0) {
+        printf("Failed to create poll handles (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    epoll_event serialEvent = {};
+    serialEvent.events      = EPOLLIN;
+    serialEvent.data.fd     = m_fd;
+
+    epoll_event wakeEvent   = {};
+    wakeEvent.events        = EPOLLIN;
+    wakeEvent.data.fd       = m_wakeFd;
+
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_fd, &serialEvent) != 0 ||
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wakeEvent) != 0) {
+        printf("Failed to register poll handles (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool PosixSerialTransport::Close() {
+    bool closed = true;
+
+    if (m_epollFd >= 0) {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+    if (m_fd >= 0) {
+        closed = close(m_fd) == 0;
+        m_fd = -1;
+    }
+
+    return closed;
+}
+
+bool PosixSerialTransport::IsOpen() const {
+    return m_fd >= 0;
+}
+
+bool PosixSerialTransport::Read(uint8_t* buffer, const size_t size, size_t& outRead) {
+    outRead = 0;
+
+    epoll_event events[2] = {};
+    const int eventCount = epoll_wait(m_epollFd, events, 2, READ_TIMEOUT_MS);
+    if (eventCount < 0) {
+        return errno == EINTR;
+    }
+
+    bool readable = false;
+    for (int i = 0; i < eventCount; i++) {
+        if (events[i].data.fd == m_wakeFd) {
+            uint64_t wakeCount = 0;
+            (void)read(m_wakeFd, &wakeCount, sizeof(wakeCount));
+        } else if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            // The device went away
+            return false;
+        } else {
+            readable = true;
+        }
+    }
+
+    if (!readable) {
+        return true;
+    }
+
+    return ReadAvailable(buffer, size, outRead);
+}
+
+SerialWaitHandle_t PosixSerialTransport::BeginWait() {
+    // epoll and poll are level triggered, so there is nothing to start
+    return IsOpen() ? m_fd : m_inotifyFd;
+}
+
+bool PosixSerialTransport::ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) {
+    outRead = 0;
+
+    if (!IsOpen()) {
+        // Woken by a device arrival, drain the events so the next wait sleeps again
+        WaitForDevice(0);
+        return true;
+    }
+
+    const ssize_t bytesRead = read(m_fd, buffer, size);
+    if (bytesRead < 0) {
+        return errno == EAGAIN || errno == EINTR;
+    }
+
+    outRead = static_cast<size_t>(bytesRead);
+    return true;
+}
+
+bool PosixSerialTransport::Write(const uint8_t* buffer, const size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        const ssize_t result = write(m_fd, buffer + written, size - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                return false;
+            }
+
+            // Sleep until the output buffer has room, rather than spinning on the write
+            pollfd writable = {};
+            writable.fd     = m_fd;
+            writable.events = POLLOUT;
+            const int ready = poll(&writable, 1, WRITE_TIMEOUT_MS);
+            if (ready == 0) {
+                errno = ETIMEDOUT;
+                return false;
+            }
+            if (ready < 0 && errno != EINTR) {
+                return false;
+            }
+            continue;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    return true;
+}
+
+bool PosixSerialTransport::Purge() {
+    return tcflush(m_fd, TCIOFLUSH) == 0;
+}
+
+void PosixSerialTransport::Interrupt() {
+    if (m_wakeFd >= 0) {
+        const uint64_t wake = 1;
+        (void)write(m_wakeFd, &wake, sizeof(wake));
+    }
+}
+
+std::string PosixSerialTransport::LastError() const {
+    if (errno == 0) {
+        return std::string();
+    }
+    return strerror(errno);
+}
+
+PosixSerialWaitSet::PosixSerialWaitSet()
+    : m_wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+
+PosixSerialWaitSet::~PosixSerialWaitSet() {
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+    }
+}
+
+bool PosixSerialWaitSet::Wait(std::span<ISerialTransport* const> transports, std::span<SerialEvent_t> outEvents, const uint32_t timeoutMs) {
+    // The last entry is our own wake fd. poll ignores negative fds, so transports with nothing to wait on are skipped
+    m_pollFds.resize(transports.size() + 1);
+    for (size_t i = 0; i < transports.size(); i++) {
+        m_pollFds[i].fd         = transports[i]->BeginWait();
+        m_pollFds[i].events     = POLLIN;
+        m_pollFds[i].revents    = 0;
+        outEvents[i]            = SerialEvent_t::None;
+    }
+    m_pollFds.back().fd         = m_wakeFd;
+    m_pollFds.back().events     = POLLIN;
+    m_pollFds.back().revents    = 0;
+
+    const int eventCount = poll(m_pollFds.data(), m_pollFds.size(), static_cast<int>(timeoutMs));
+    if (eventCount < 0) {
+        return errno == EINTR;
+    }
+
+    for (size_t i = 0; i < transports.size(); i++) {
+        const short revents = m_pollFds[i].revents;
+        if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            // The device went away
+            outEvents[i] = SerialEvent_t::Error;
+        } else if (revents & POLLIN) {
+            outEvents[i] = SerialEvent_t::Ready;
+        }
+    }
+
+    if (m_pollFds.back().revents & POLLIN) {
+        uint64_t wakeCount = 0;
+        (void)read(m_wakeFd, &wakeCount, sizeof(wakeCount));
+    }
+
+    return true;
+}
+
+void PosixSerialWaitSet::Interrupt() {
+    if (m_wakeFd >= 0) {
+        const uint64_t wake = 1;
+        (void)write(m_wakeFd, &wake, sizeof(wake));
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,67 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <poll.h>
+
+#include "serial_transport.hpp"
+
+/// <summary>
+/// Serial transport using termios. Reads sleep on epoll together with an eventfd, so Interrupt can wake the reader.
+/// The dongle is located through sysfs, unless a device path is given (e.g. the slave side of a pseudo-terminal), and
+/// device arrivals are noticed through inotify on /dev.
+/// </summary>
+class PosixSerialTransport : public ISerialTransport {
+public:
+    PosixSerialTransport();
+    explicit PosixSerialTransport(const std::string& devicePath);
+    ~PosixSerialTransport() override;
+
+    std::string FindDevice() const override;
+    std::vector<std::string> FindDevices() const override;
+    bool WaitForDevice(const uint32_t timeoutMs) override;
+
+    bool Open(const std::string& port) override;
+    bool Close() override;
+    bool IsOpen() const override;
+
+    bool Read(uint8_t* buffer, const size_t size, size_t& outRead) override;
+    bool Write(const uint8_t* buffer, const size_t size) override;
+
+    SerialWaitHandle_t BeginWait() override;
+    bool ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) override;
+
+    bool Purge() override;
+    void Interrupt() override;
+
+    std::string LastError() const override;
+
+private:
+    std::string m_devicePath;
+
+    int m_fd;
+    int m_epollFd;
+    // Lives as long as the transport, so Interrupt is never lost while the port is being (re)opened
+    int m_wakeFd;
+    // Watches /dev for new device nodes
+    int m_inotifyFd;
+};
+
+/// <summary>
+/// Waits on many transports through a single poll call, together with an eventfd so Interrupt can wake the waiter.
+/// </summary>
+class PosixSerialWaitSet : public ISerialWaitSet {
+public:
+    PosixSerialWaitSet();
+    ~PosixSerialWaitSet() override;
+
+    bool Wait(std::span<ISerialTransport* const> transports, std::span<SerialEvent_t> outEvents, const uint32_t timeoutMs) override;
+    void Interrupt() override;
+
+private:
+    int m_wakeFd;
+    // Reused between waits, so waiting never allocates once the set of transports is stable
+    std::vector<pollfd> m_pollFds;
+};
+
+#endif // __linux__
@@ -0,0 +1,221 @@
+#include "serial_transport_replay.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+ReplaySerialTransport::ReplaySerialTransport(const std::string& capturePath, const double speed)
+    : m_capturePath(capturePath), m_speed(speed), m_interrupted(false), m_isOpen(false), m_nextFrame(0), m_wireDue(0), m_wireRead(0) {}
+
+std::string ReplaySerialTransport::FindDevice() const {
+    std::error_code error;
+    return std::filesystem::exists(m_capturePath, error) ? m_capturePath : std::string();
+}
+
+std::vector<std::string> ReplaySerialTransport::FindDevices() const {
+    const std::string device = FindDevice();
+    return device.empty() ? std::vector<std::string>() : std::vector<std::string>{ device };
+}
+
+bool ReplaySerialTransport::WaitForDevice(const uint32_t timeoutMs) {
+    // A capture never arrives, there is nothing to do but wait for the timeout
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return m_interrupted; });
+    m_interrupted = false;
+    return false;
+}
+
+bool ReplaySerialTransport::LoadCapture(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        m_lastError = "Failed to open capture";
+        return false;
+    }
+    const std::vector<uint8_t> capture((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    CaptureFileHeader_t header = {};
+    if (capture.size() < sizeof(header)) {
+        m_lastError = "Capture is truncated";
+        return false;
+    }
+    memcpy(&header, capture.data(), sizeof(header));
+    if (memcmp(header.magic, CAPTURE_MAGIC, sizeof(header.magic)) != 0 || header.version != CAPTURE_VERSION || header.headerSize < sizeof(header)) {
+        m_lastError = "Not a capture, or an unsupported version";
+        return false;
+    }
+
+    m_wire.clear();
+    m_frames.clear();
+
+    // Mirror the dongle, which delimits the first frame on both sides
+    m_wire.push_back(0x00);
+
+    uint64_t firstTimestamp = 0;
+    size_t position = header.headerSize;
+    while (capture.size() - position >= CAPTURE_RECORD_HEADER_SIZE) {
+        uint64_t timestamp = 0;
+        uint16_t length = 0;
+        memcpy(&timestamp, &capture[position], sizeof(timestamp));
+        memcpy(&length, &capture[position + 8], sizeof(length));
+        position += CAPTURE_RECORD_HEADER_SIZE;
+
+        if (capture.size() - position < length) {
+            // The recorder was cut off mid record, replay everything before it
+            printf("Capture %s ends in a partial record, ignoring it\n", path.c_str());
+            break;
+        }
+
+        if (m_frames.empty()) {
+            firstTimestamp = timestamp;
+        }
+
+        // Frames which overflowed while recording have no bytes, replaying the delimiter keeps the surrounding timing
+        m_wire.insert(m_wire.end(), capture.begin() + position, capture.begin() + position + length);
+        m_wire.push_back(0x00);
+        position += length;
+
+        ReplayFrame_t frame = {};
+        frame.offset    = std::chrono::nanoseconds(timestamp >= firstTimestamp ? timestamp - firstTimestamp : 0);
+        frame.wireEnd   = m_wire.size();
+        m_frames.push_back(frame);
+    }
+
+    return true;
+}
+
+bool ReplaySerialTransport::Open(const std::string& port) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!LoadCapture(port)) {
+        printf("Failed to load capture (%s) - Error: %s\n", port.c_str(), m_lastError.c_str());
+        return false;
+    }
+
+    printf("Replaying %zu frames from %s\n", m_frames.size(), port.c_str());
+    m_isOpen    = true;
+    m_startTime = std::chrono::steady_clock::now();
+    m_nextFrame = 0;
+    m_wireDue   = 0;
+    m_wireRead  = 0;
+    return true;
+}
+
+bool ReplaySerialTransport::Close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isOpen = false;
+    m_wire.clear();
+    m_frames.clear();
+    return true;
+}
+
+bool ReplaySerialTransport::IsOpen() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isOpen;
+}
+
+void ReplaySerialTransport::SetDrainCheck(std::function<bool()> isDrained) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isDrained = std::move(isDrained);
+}
+
+bool ReplaySerialTransport::IsFinished() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isOpen && m_wireRead == m_wire.size();
+}
+
+std::chrono::steady_clock::time_point ReplaySerialTransport::DueTime(const ReplayFrame_t& frame) const {
+    if (m_speed <= REPLAY_SPEED_UNTHROTTLED) {
+        return m_startTime;
+    }
+    return m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame.offset / m_speed);
+}
+
+bool ReplaySerialTransport::AwaitingDrain() const {
+    // Unthrottled, the whole capture is due at once, so every read waits rather than only those releasing new frames
+    return m_speed <= REPLAY_SPEED_UNTHROTTLED && m_isDrained && !m_isDrained();
+}
+
+size_t ReplaySerialTransport::ReadDue(uint8_t* buffer, const size_t size) {
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    // Release the leading delimiter along with the first frame, and every frame which is due after it
+    while (m_nextFrame < m_frames.size() && DueTime(m_frames[m_nextFrame]) <= now) {
+        m_wireDue = m_frames[m_nextFrame].wireEnd;
+        m_nextFrame++;
+    }
+
+    // The reader may take less than was due, the rest is picked up by the next read
+    const size_t count = std::min(m_wireDue - m_wireRead, size);
+    if (count > 0) {
+        memcpy(buffer, &m_wire[m_wireRead], count);
+        m_wireRead += count;
+    }
+    return count;
+}
+
+bool ReplaySerialTransport::Read(uint8_t* buffer, const size_t size, size_t& outRead) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    outRead = 0;
+
+    if (!m_isOpen) {
+        m_lastError = "Capture isn't open";
+        return false;
+    }
+
+    while (true) {
+        outRead = AwaitingDrain() ? 0 : ReadDue(buffer, size);
+        if (outRead > 0 || m_interrupted) {
+            m_interrupted = false;
+            return true;
+        }
+
+        // The reader doesn't signal when it has drained, so poll until it has
+        if (AwaitingDrain()) {
+            m_wake.wait_for(lock, REPLAY_DRAIN_POLL_INTERVAL, [this]() { return m_interrupted; });
+            continue;
+        }
+
+        // Sleep until the next frame is due, or forever like an idle dongle once the capture is over
+        if (m_nextFrame < m_frames.size()) {
+            m_wake.wait_until(lock, DueTime(m_frames[m_nextFrame]), [this]() { return m_interrupted; });
+        } else {
+            m_wake.wait(lock, [this]() { return m_interrupted; });
+        }
+    }
+}
+
+bool ReplaySerialTransport::ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    outRead = m_isOpen && !AwaitingDrain() ? ReadDue(buffer, size) : 0;
+    return m_isOpen;
+}
+
+SerialWaitHandle_t ReplaySerialTransport::BeginWait() {
+    return SERIAL_INVALID_WAIT_HANDLE;
+}
+
+bool ReplaySerialTransport::Write(const uint8_t* /*buffer*/, const size_t /*size*/) {
+    return IsOpen();
+}
+
+bool ReplaySerialTransport::Purge() {
+    // The capture already starts where the dongle's input queue was purged
+    return IsOpen();
+}
+
+void ReplaySerialTransport::Interrupt() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+    }
+    m_wake.notify_all();
+}
+
+std::string ReplaySerialTransport::LastError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
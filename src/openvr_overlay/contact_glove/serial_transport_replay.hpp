@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+#include "capture_recorder.hpp"
+#include "serial_transport.hpp"
+
+// Replay speed which sends every frame as soon as the reader asks for more
+constexpr double REPLAY_SPEED_UNTHROTTLED = 0.0;
+// How often an unthrottled replay checks whether the reader has drained what it was sent
+constexpr std::chrono::microseconds REPLAY_DRAIN_POLL_INTERVAL = std::chrono::microseconds(20);
+
+/// <summary>
+/// Serial transport which plays back a capture written by CaptureRecorder instead of talking to a dongle, so the whole
+/// ingest pipeline (framing, COBS, CRC, decoding and callbacks) can run without a glove. Frames are released at their
+/// recorded timing scaled by the given speed, or all at once if unthrottled. Once the capture ends the transport
+/// behaves like an idle dongle. Commands written to it are discarded.
+/// Replay is read through SerialCommunicationManager's own serial thread, it has nothing for a SerialReactor to wait on.
+/// </summary>
+class ReplaySerialTransport : public ISerialTransport {
+public:
+    explicit ReplaySerialTransport(const std::string& capturePath, const double speed = 1.0);
+    ~ReplaySerialTransport() override = default;
+
+    std::string FindDevice() const override;
+    std::vector<std::string> FindDevices() const override;
+    bool WaitForDevice(const uint32_t timeoutMs) override;
+
+    // Loads the capture and starts playing it back from the beginning
+    bool Open(const std::string& port) override;
+    bool Close() override;
+    bool IsOpen() const override;
+
+    bool Read(uint8_t* buffer, const size_t size, size_t& outRead) override;
+    bool Write(const uint8_t* buffer, const size_t size) override;
+
+    SerialWaitHandle_t BeginWait() override;
+    bool ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) override;
+
+    bool Purge() override;
+    void Interrupt() override;
+
+    std::string LastError() const override;
+
+    /// <summary>
+    /// Makes an unthrottled replay wait until isDrained returns true before releasing more bytes, e.g. until the
+    /// manager's packet queue is empty. Otherwise the whole capture arrives faster than it can be dispatched, and how
+    /// many packets are dropped depends on scheduling. Throttled replay keeps its recorded timing regardless.
+    /// </summary>
+    void SetDrainCheck(std::function<bool()> isDrained);
+
+    // Whether every frame in the capture has been read
+    bool IsFinished() const;
+    inline size_t GetFrameCount() const { return m_frames.size(); }
+
+private:
+    struct ReplayFrame_t {
+        // Offset from the first frame in the capture
+        std::chrono::nanoseconds offset;
+        // End of the frame in m_wire, including its delimiter
+        size_t wireEnd;
+    };
+
+    bool LoadCapture(const std::string& path);
+    // Copies every frame which is due into buffer. Caller holds m_mutex
+    size_t ReadDue(uint8_t* buffer, const size_t size);
+    // Whether an unthrottled replay is still waiting for the reader to drain what it was sent. Caller holds m_mutex
+    bool AwaitingDrain() const;
+    std::chrono::steady_clock::time_point DueTime(const ReplayFrame_t& frame) const;
+
+private:
+    std::string m_capturePath;
+    double m_speed;
+    std::function<bool()> m_isDrained;
+
+    // The capture as it arrived over the wire, each frame terminated by a delimiter
+    std::vector<uint8_t> m_wire;
+    std::vector<ReplayFrame_t> m_frames;
+
+    // Guards everything below, Interrupt is called from other threads
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_interrupted;
+
+    bool m_isOpen;
+    std::chrono::steady_clock::time_point m_startTime;
+    size_t m_nextFrame;
+    // Bytes of m_wire released so far, and how many of them have been read
+    size_t m_wireDue;
+    size_t m_wireRead;
+
+    std::string m_lastError;
+};
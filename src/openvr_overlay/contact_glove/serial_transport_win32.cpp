@@ -0,0 +1,451 @@
+#ifdef _WIN32
+
+#include "serial_transport_win32.hpp"
+#include <SetupAPI.h>
+#include <initguid.h>
+#include <ntddser.h>
+
+#include <algorithm>
+#include <cstdio>
+
+static const std::string c_serialDeviceId = "VID_10C4&PID_7B27";
+
+std::unique_ptr<ISerialTransport> CreateSerialTransport() {
+    return std::make_unique<Win32SerialTransport>();
+}
+
+std::unique_ptr<ISerialTransport> CreateSerialTransport(const std::string& port) {
+    return std::make_unique<Win32SerialTransport>(port);
+}
+
+std::unique_ptr<ISerialWaitSet> CreateSerialWaitSet() {
+    return std::make_unique<Win32SerialWaitSet>();
+}
+
+Win32SerialTransport::Win32SerialTransport()
+    : Win32SerialTransport(std::string()) {}
+
+Win32SerialTransport::Win32SerialTransport(const std::string& port)
+    : m_port(port), m_hSerial(INVALID_HANDLE_VALUE), m_readOverlapped{}, m_writeOverlapped{}, m_commEvent(0), m_waitPending(false), m_waitFailed(false), m_waitError(0), m_hDeviceNotification(NULL) {
+    // Manual reset, as required by overlapped I/O
+    m_readOverlapped.hEvent     = CreateEventA(NULL, TRUE, FALSE, NULL);
+    m_writeOverlapped.hEvent    = CreateEventA(NULL, TRUE, FALSE, NULL);
+    // Auto reset, so each Interrupt wakes a single Read
+    m_hWakeEvent                = CreateEventA(NULL, FALSE, FALSE, NULL);
+    m_hArrivalEvent             = CreateEventA(NULL, FALSE, FALSE, NULL);
+
+    // Get told whenever a COM port appears, rather than enumerating every USB device on a timer
+    CM_NOTIFY_FILTER filter = {};
+    filter.cbSize                                   = sizeof(filter);
+    filter.FilterType                               = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+    filter.u.DeviceInterface.ClassGuid              = GUID_DEVINTERFACE_COMPORT;
+
+    if (CM_Register_Notification(&filter, this, &Win32SerialTransport::OnDeviceNotification, &m_hDeviceNotification) != CR_SUCCESS) {
+        // WaitForDevice falls back to its timeout
+        printf("Failed to register for device notifications, falling back to polling\n");
+        m_hDeviceNotification = NULL;
+    }
+}
+
+Win32SerialTransport::~Win32SerialTransport() {
+    if (IsOpen()) {
+        Close();
+    }
+    CloseHandle(m_readOverlapped.hEvent);
+    CloseHandle(m_writeOverlapped.hEvent);
+    CloseHandle(m_hWakeEvent);
+
+    if (m_hDeviceNotification != NULL) {
+        // Waits for any callback in flight, so the arrival event can be closed after
+        CM_Unregister_Notification(m_hDeviceNotification);
+    }
+    CloseHandle(m_hArrivalEvent);
+}
+
+DWORD CALLBACK Win32SerialTransport::OnDeviceNotification(HCMNOTIFICATION /*notification*/, PVOID context, CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA /*eventData*/, DWORD /*eventDataSize*/) {
+    if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL) {
+        SetEvent(static_cast<Win32SerialTransport*>(context)->m_hArrivalEvent);
+    }
+
+    return ERROR_SUCCESS;
+}
+
+std::vector<int> Win32SerialTransport::GetComPorts() const {
+
+    HDEVINFO DeviceInfoSet;
+    SP_DEVINFO_DATA DeviceInfoData;
+    DEVPROPTYPE ulPropertyType;
+    DWORD DeviceIndex       = 0;
+    std::string DevEnum     = "USB";
+    char szBuffer[1024]     = { 0 };
+    DWORD dwSize            = 0;
+    DWORD Error             = 0;
+    std::vector<int> comPorts;
+
+    DeviceInfoSet = SetupDiGetClassDevsA(NULL, DevEnum.c_str(), NULL, DIGCF_ALLCLASSES | DIGCF_PRESENT);
+
+    if (DeviceInfoSet == INVALID_HANDLE_VALUE) {
+        return comPorts;
+    }
+
+    ZeroMemory(&DeviceInfoData, sizeof(SP_DEVINFO_DATA));
+    DeviceInfoData.cbSize = sizeof(SP_DEVINFO_DATA);
+    // Receive information about an enumerated device
+
+    while ( SetupDiEnumDeviceInfo(DeviceInfoSet, DeviceIndex, &DeviceInfoData) ) {
+        DeviceIndex++;
+
+        // Retrieves a specified Plug and Play device property
+        if (SetupDiGetDeviceRegistryPropertyA(
+            DeviceInfoSet,
+            &DeviceInfoData,
+            SPDRP_HARDWAREID,
+            &ulPropertyType,
+            (BYTE*)szBuffer,
+            sizeof(szBuffer),  // The size, in bytes
+            &dwSize)) {
+
+            if ( std::string(szBuffer).find(c_serialDeviceId) == std::string::npos ) {
+                continue;
+            }
+
+            HKEY hDeviceRegistryKey = { 0 };
+            hDeviceRegistryKey      = SetupDiOpenDevRegKey(DeviceInfoSet, &DeviceInfoData, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+
+            if ( hDeviceRegistryKey == INVALID_HANDLE_VALUE ) {
+                // Keep looking, another dongle may still be usable
+                Error = GetLastError();
+                continue;
+            } else {
+                char pszPortName[20]    = { 0 };
+                DWORD dwSize            = sizeof(pszPortName);
+                DWORD dwType            = 0;
+
+                if (
+                    ( RegQueryValueExA(hDeviceRegistryKey, "PortName", NULL, &dwType, (LPBYTE)pszPortName, &dwSize) == ERROR_SUCCESS ) &&
+                    ( dwType == REG_SZ ) )
+                {
+                    // @FIXME: Avoid allocating memory by using a std::string
+                    //         Should we consider implementing a substr function which takes in a char* ?
+                    std::string sPortName = pszPortName;
+                    try {
+                        if ( sPortName.substr( 0, 3 ) == "COM" ) {
+                            int nPortNr = std::stoi( pszPortName + 3 );
+                            if ( nPortNr != 0 ) {
+                                comPorts.push_back(nPortNr);
+                            }
+                        }
+                    } catch ( ... ) {
+                        printf("Parsing failed for a port\n");
+                    }
+                }
+                RegCloseKey(hDeviceRegistryKey);
+            }
+        }
+    } // while ( SetupDiEnumDeviceInfo(DeviceInfoSet, DeviceIndex, &DeviceInfoData) )
+
+    // Free the device list on every path, including when the dongle was found
+    SetupDiDestroyDeviceInfoList(DeviceInfoSet);
+
+    return comPorts;
+}
+
+std::string Win32SerialTransport::FindDevice() const {
+    if (!m_port.empty()) {
+        return m_port;
+    }
+
+    const std::vector<std::string> devices = FindDevices();
+    return devices.empty() ? std::string() : devices.front();
+}
+
+std::vector<std::string> Win32SerialTransport::FindDevices() const {
+    std::vector<int> ports = GetComPorts();
+    // Enumeration order is arbitrary, keep dongle indices stable between runs
+    std::sort(ports.begin(), ports.end());
+
+    std::vector<std::string> devices;
+    for (const int port : ports) {
+        devices.push_back("\\\\.\\COM" + std::to_string(port));
+    }
+    return devices;
+}
+
+bool Win32SerialTransport::WaitForDevice(const uint32_t timeoutMs) {
+    const HANDLE waitHandles[2] = { m_hArrivalEvent, m_hWakeEvent };
+    return WaitForMultipleObjects(2, waitHandles, FALSE, timeoutMs) == WAIT_OBJECT_0;
+}
+
+bool Win32SerialTransport::Open(const std::string& port) {
+    // Try to connect to the given port throuh CreateFile
+    m_hSerial = CreateFileA(port.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
+
+    if (m_hSerial == INVALID_HANDLE_VALUE) {
+        printf("Received error connecting to port (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        return false;
+    }
+
+    // If connected we try to set the comm parameters
+    DCB dcbSerialParams = { 0 };
+
+    if (!GetCommState(m_hSerial, &dcbSerialParams)) {
+        printf("Failed to get current port parameters (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    // Define serial connection parameters for the arduino board
+    dcbSerialParams.BaudRate        = CBR_115200;
+    dcbSerialParams.ByteSize        = 8;
+    dcbSerialParams.StopBits        = ONESTOPBIT;
+    dcbSerialParams.Parity          = NOPARITY;
+
+    // reset upon establishing a connection
+    dcbSerialParams.fDtrControl     = DTR_CONTROL_ENABLE;
+    dcbSerialParams.XonChar         = 0x11;
+    dcbSerialParams.XoffLim         = 0x4000;
+    dcbSerialParams.XoffChar        = 0x13;
+    dcbSerialParams.EofChar         = 0x1A;
+    dcbSerialParams.EvtChar         = 0;
+
+    // set the parameters and check for their proper application
+    if (!SetCommState(m_hSerial, &dcbSerialParams)) {
+        printf("Failed to set serial parameters (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    // ReadFile returns immediately with whatever is in the input queue. Waiting for data is done through WaitCommEvent
+    COMMTIMEOUTS timeout = {
+        .ReadIntervalTimeout            = MAXDWORD,
+        .ReadTotalTimeoutMultiplier     = 0,
+        .ReadTotalTimeoutConstant       = 0,
+        .WriteTotalTimeoutMultiplier    = 5,
+        .WriteTotalTimeoutConstant      = 0,
+    };
+
+    if (!SetCommTimeouts(m_hSerial, &timeout)) {
+        printf("Failed to set comm timeouts (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    // Wake WaitCommEvent whenever a byte is received
+    if (!SetCommMask(m_hSerial, EV_RXCHAR)) {
+        printf("Failed to set comm event mask (%s) - Error: %s\n", port.c_str(), LastError().c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool Win32SerialTransport::Close() {
+    // Closing the handle aborts a pending wait
+    const BOOL closed = CloseHandle(m_hSerial);
+    m_hSerial = INVALID_HANDLE_VALUE;
+    m_waitPending = false;
+    m_waitFailed = false;
+    return closed;
+}
+
+bool Win32SerialTransport::IsOpen() const {
+    return m_hSerial != INVALID_HANDLE_VALUE;
+}
+
+bool Win32SerialTransport::CompleteOverlapped(OVERLAPPED& overlapped, DWORD& outTransferred) {
+    return GetOverlappedResult(m_hSerial, &overlapped, &outTransferred, TRUE);
+}
+
+SerialWaitHandle_t Win32SerialTransport::BeginWait() {
+    if (!IsOpen()) {
+        return m_hDeviceNotification != NULL ? m_hArrivalEvent : SERIAL_INVALID_WAIT_HANDLE;
+    }
+
+    if (!m_waitPending) {
+        if (WaitCommEvent(m_hSerial, &m_commEvent, &m_readOverlapped)) {
+            // Completed straight away, make sure whoever waits on the event sees it
+            SetEvent(m_readOverlapped.hEvent);
+        }
+        else if (GetLastError() != ERROR_IO_PENDING) {
+            // Wake whoever waits on the event straight away, so ReadAvailable fails and the device error is handled
+            m_waitFailed = true;
+            m_waitError = GetLastError();
+            SetEvent(m_readOverlapped.hEvent);
+            return m_readOverlapped.hEvent;
+        }
+        m_waitPending = true;
+
+        // Bytes which arrived before WaitCommEvent was issued don't raise EV_RXCHAR, so check the input queue first
+        COMSTAT status  = {};
+        DWORD errors    = 0;
+        if (ClearCommError(m_hSerial, &errors, &status) && status.cbInQue > 0) {
+            // Resetting the mask completes the pending wait
+            SetCommMask(m_hSerial, EV_RXCHAR);
+        }
+    }
+
+    return m_readOverlapped.hEvent;
+}
+
+bool Win32SerialTransport::ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) {
+    outRead = 0;
+
+    if (!IsOpen()) {
+        // Woken by a device arrival, consume it so the next wait sleeps again
+        WaitForSingleObject(m_hArrivalEvent, 0);
+        return true;
+    }
+
+    if (m_waitFailed) {
+        m_waitFailed = false;
+        SetLastError(m_waitError);
+        return false;
+    }
+
+    // The read reuses the wait's OVERLAPPED, so the wait has to be over first
+    if (m_waitPending) {
+        m_waitPending = false;
+
+        if (!HasOverlappedIoCompleted(&m_readOverlapped)) {
+            SetCommMask(m_hSerial, EV_RXCHAR);
+        }
+
+        DWORD transferred = 0;
+        if (!CompleteOverlapped(m_readOverlapped, transferred)) {
+            return false;
+        }
+    }
+
+    // With our timeouts this completes immediately with everything in the input queue
+    DWORD dwRead = 0;
+    if (!ReadFile(m_hSerial, buffer, (DWORD)size, &dwRead, &m_readOverlapped)) {
+        if (GetLastError() != ERROR_IO_PENDING || !CompleteOverlapped(m_readOverlapped, dwRead)) {
+            return false;
+        }
+    }
+
+    outRead = dwRead;
+    return true;
+}
+
+bool Win32SerialTransport::Read(uint8_t* buffer, const size_t size, size_t& outRead) {
+    outRead = 0;
+
+    // Sleep until the dongle sends something, or we're interrupted
+    const HANDLE waitHandles[2] = { BeginWait(), m_hWakeEvent };
+    const DWORD signalled = WaitForMultipleObjects(2, waitHandles, FALSE, INFINITE);
+
+    if (signalled == WAIT_OBJECT_0 + 1) {
+        // Leave the wait pending, the next Read picks it back up
+        return true;
+    }
+    if (signalled != WAIT_OBJECT_0) {
+        return false;
+    }
+
+    return ReadAvailable(buffer, size, outRead);
+}
+
+bool Win32SerialTransport::Write(const uint8_t* buffer, const size_t size) {
+    DWORD bytesSend = 0;
+    if (!WriteFile(m_hSerial, (const void*)buffer, (DWORD)size, &bytesSend, &m_writeOverlapped)) {
+        if (GetLastError() != ERROR_IO_PENDING || !CompleteOverlapped(m_writeOverlapped, bytesSend)) {
+            return false;
+        }
+    }
+
+    return bytesSend == size;
+}
+
+bool Win32SerialTransport::Purge() {
+    return PurgeComm(m_hSerial, PURGE_RXCLEAR | PURGE_TXCLEAR);
+}
+
+void Win32SerialTransport::Interrupt() {
+    SetEvent(m_hWakeEvent);
+}
+
+std::string Win32SerialTransport::LastError() const {
+    DWORD errorMessageID = ::GetLastError();
+    if (errorMessageID == 0) {
+        return std::string();
+    }
+
+    LPSTR messageBuffer = nullptr;
+
+    size_t size = FormatMessageA(
+        FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
+        NULL,
+        errorMessageID,
+        MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
+        (LPSTR)&messageBuffer,
+        0,
+        NULL);
+
+    std::string message(messageBuffer, size);
+
+    LocalFree(messageBuffer);
+
+    return message;
+}
+
+Win32SerialWaitSet::Win32SerialWaitSet()
+    : m_hWakeEvent(CreateEventA(NULL, FALSE, FALSE, NULL)) {}
+
+Win32SerialWaitSet::~Win32SerialWaitSet() {
+    CloseHandle(m_hWakeEvent);
+}
+
+bool Win32SerialWaitSet::Wait(std::span<ISerialTransport* const> transports, std::span<SerialEvent_t> outEvents, const uint32_t timeoutMs) {
+    // The first handle is our own wake event, transports with nothing to wait on are skipped
+    m_waitHandles.clear();
+    m_waitIndices.clear();
+    m_waitHandles.push_back(m_hWakeEvent);
+
+    for (size_t i = 0; i < transports.size(); i++) {
+        outEvents[i] = SerialEvent_t::None;
+
+        const SerialWaitHandle_t handle = transports[i]->BeginWait();
+        if (handle != SERIAL_INVALID_WAIT_HANDLE) {
+            m_waitHandles.push_back(handle);
+            m_waitIndices.push_back(i);
+        }
+    }
+
+    if (m_waitHandles.size() > MAXIMUM_WAIT_OBJECTS) {
+        printf("Too many dongles to wait on (%zu), at most %d are supported\n", m_waitIndices.size(), MAXIMUM_WAIT_OBJECTS - 1);
+        return false;
+    }
+
+    const DWORD signalled = WaitForMultipleObjects((DWORD)m_waitHandles.size(), m_waitHandles.data(), FALSE, timeoutMs);
+    if (signalled == WAIT_TIMEOUT) {
+        return true;
+    }
+    if (signalled >= WAIT_OBJECT_0 + m_waitHandles.size()) {
+        return false;
+    }
+
+    // The handle which ended the wait may be auto reset (a closed port's arrival event), in which case the wait already
+    // consumed it, so it is marked from its index rather than checked again
+    const size_t signalledIndex = signalled - WAIT_OBJECT_0;
+    if (signalledIndex > 0) {
+        outEvents[m_waitIndices[signalledIndex - 1]] = SerialEvent_t::Ready;
+    }
+
+    // WaitForMultipleObjects only reports the first signalled handle, check the ones after it without blocking. This
+    // consumes auto reset events, which is fine as their transports are marked ready here
+    for (size_t i = signalledIndex + 1; i < m_waitHandles.size(); i++) {
+        if (WaitForSingleObject(m_waitHandles[i], 0) == WAIT_OBJECT_0) {
+            outEvents[m_waitIndices[i - 1]] = SerialEvent_t::Ready;
+        }
+    }
+
+    return true;
+}
+
+void Win32SerialWaitSet::Interrupt() {
+    SetEvent(m_hWakeEvent);
+}
+
+#endif // _WIN32
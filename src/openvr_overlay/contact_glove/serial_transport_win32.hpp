@@ -0,0 +1,92 @@
+#pragma once
+
+#ifdef _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <cfgmgr32.h>
+
+#include <vector>
+
+#include "serial_transport.hpp"
+
+/// <summary>
+/// Serial transport using the Win32 comm API, with overlapped I/O. Reads sleep on WaitCommEvent together with a wake
+/// event, so Interrupt can wake the reader. The dongle is located through SetupAPI, and COM port arrivals are
+/// reported through a Configuration Manager notification.
+/// </summary>
+class Win32SerialTransport : public ISerialTransport {
+public:
+    Win32SerialTransport();
+    // Binds the transport to the given port rather than locating the dongle, for when several dongles are connected
+    explicit Win32SerialTransport(const std::string& port);
+    ~Win32SerialTransport() override;
+
+    std::string FindDevice() const override;
+    std::vector<std::string> FindDevices() const override;
+    bool WaitForDevice(const uint32_t timeoutMs) override;
+
+    bool Open(const std::string& port) override;
+    bool Close() override;
+    bool IsOpen() const override;
+
+    bool Read(uint8_t* buffer, const size_t size, size_t& outRead) override;
+    bool Write(const uint8_t* buffer, const size_t size) override;
+
+    SerialWaitHandle_t BeginWait() override;
+    bool ReadAvailable(uint8_t* buffer, const size_t size, size_t& outRead) override;
+
+    bool Purge() override;
+    void Interrupt() override;
+
+    std::string LastError() const override;
+
+private:
+    std::vector<int> GetComPorts() const;
+    bool CompleteOverlapped(OVERLAPPED& overlapped, DWORD& outTransferred);
+    static DWORD CALLBACK OnDeviceNotification(HCMNOTIFICATION notification, PVOID context, CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA eventData, DWORD eventDataSize);
+
+private:
+    std::string m_port;
+
+    // Serial com handler, opened for overlapped I/O
+    HANDLE m_hSerial;
+
+    // Overlapped state for reads (WaitCommEvent and ReadFile) and writes, which may happen on different threads
+    OVERLAPPED m_readOverlapped;
+    OVERLAPPED m_writeOverlapped;
+    DWORD m_commEvent;
+    // Whether a WaitCommEvent is in flight on m_readOverlapped
+    bool m_waitPending;
+    // Set when WaitCommEvent failed outright, with the error it failed with, for ReadAvailable to report
+    bool m_waitFailed;
+    DWORD m_waitError;
+
+    // Signalled by Interrupt. Lives as long as the transport, so Interrupt is never lost while the port is being (re)opened
+    HANDLE m_hWakeEvent;
+
+    // Signalled whenever a COM port interface arrives
+    HANDLE m_hArrivalEvent;
+    HCMNOTIFICATION m_hDeviceNotification;
+};
+
+/// <summary>
+/// Waits on many transports through a single WaitForMultipleObjects call, together with an event so Interrupt can wake
+/// the waiter. Limited to MAXIMUM_WAIT_OBJECTS - 1 transports.
+/// </summary>
+class Win32SerialWaitSet : public ISerialWaitSet {
+public:
+    Win32SerialWaitSet();
+    ~Win32SerialWaitSet() override;
+
+    bool Wait(std::span<ISerialTransport* const> transports, std::span<SerialEvent_t> outEvents, const uint32_t timeoutMs) override;
+    void Interrupt() override;
+
+private:
+    HANDLE m_hWakeEvent;
+    // Reused between waits, so waiting never allocates once the set of transports is stable
+    std::vector<HANDLE> m_waitHandles;
+    std::vector<size_t> m_waitIndices;
+};
+
+#endif // _WIN32
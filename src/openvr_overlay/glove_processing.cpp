@@ -0,0 +1,140 @@
+#include "glove_processing.hpp"
+#include "contact_glove/contact_glove_structs.hpp"
+#include "maths.hpp"
+
+#include <cmath>
+
+// 2 second timeout for the gloves
+constexpr auto GLOVE_TIMEOUT = std::chrono::steady_clock::time_point::duration(std::chrono::milliseconds(2000));
+
+#define MIN(a,b) (((a)<(b))?(a):(b))
+#define MAX(a,b) (((a)>(b))?(a):(b))
+#define CLAMP(t,a,b) (MAX(MIN(t, b), a))
+
+void ProcessGlove(GloveState_t& glove, MostCommonElementRingBuffer& batteryRingBuffer, std::chrono::steady_clock::time_point gloveConnected) {
+
+    // Compute whether we should consider the glove as connected or not
+    auto delta = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - gloveConnected);
+    glove.isConnected = delta < GLOVE_TIMEOUT && gloveConnected != std::chrono::steady_clock::time_point::min();
+
+    // Only process the rest of the data IF and only IF the glove is connected
+    if (glove.isConnected) {
+        // Only process magnetra stuff if magnetra is connected
+        if (glove.hasMagnetra) {
+            float joystickX = 2.0f * (glove.joystickXRaw - glove.calibration.joystick.XMin) / (float)MAX(glove.calibration.joystick.XMax - glove.calibration.joystick.XMin, 0.0f) - 1.0f;
+            float joystickY = 2.0f * (glove.joystickYRaw - glove.calibration.joystick.YMin) / (float)MAX(glove.calibration.joystick.YMax - glove.calibration.joystick.YMin, 0.0f) - 1.0f;
+
+            // Normalize the axis if out of range
+            if (joystickX * joystickX + joystickY * joystickY > 1.0f) {
+                double length = sqrt(joystickX * joystickX + joystickY * joystickY);
+                joystickX = (float) (joystickX / length);
+                joystickY = (float) (joystickY / length);
+            }
+
+            // Re-orient the up forward vector based on user calibration
+            // Use a negated 2D rotation matrix
+            float orientedJoystickX = joystickX * cos(glove.calibration.joystick.forwardAngle) + joystickY * -sin(glove.calibration.joystick.forwardAngle);
+            float orientedJoystickY = joystickX * sin(glove.calibration.joystick.forwardAngle) + joystickY * cos(glove.calibration.joystick.forwardAngle);
+
+            glove.joystickX = orientedJoystickX;
+            glove.joystickY = orientedJoystickY;
+            glove.joystickXUnfiltered = orientedJoystickX;
+            glove.joystickYUnfiltered = orientedJoystickY;
+
+            // Apply deadzone
+            // Compare vector magnitudes, if smaller than threshold 0 out
+            if (glove.joystickX * glove.joystickX + glove.joystickY * glove.joystickY < glove.calibration.joystick.threshold) {
+                glove.joystickX = 0.0f;
+                glove.joystickY = 0.0f;
+            }
+        }
+        else {
+            // Default values, i.e. no joystick / buttons
+            glove.joystickX     = 0.0f;
+            glove.joystickY     = 0.0f;
+            glove.buttonDown    = false;
+            glove.buttonUp      = false;
+            glove.systemDown    = false;
+            glove.systemUp      = false;
+            glove.joystickClick = false;
+        }
+
+        // Battery should only update if it's not invalid (sometimes the battery status is invalid)
+        if (glove.gloveBatteryRaw != CONTACT_GLOVE_INVALID_BATTERY) {
+            uint8_t gloveBatteryClamped = 0;
+            uint8_t gloveBatteryFiltered = CONTACT_GLOVE_INVALID_BATTERY;
+
+            // Only continue if the battery ring buffer is valid
+            if (batteryRingBuffer.IsValid()) {
+                batteryRingBuffer.Push(glove.gloveBatteryRaw);
+                gloveBatteryFiltered = batteryRingBuffer.MostCommonElement();
+                gloveBatteryClamped = CLAMP(gloveBatteryFiltered, 0, 100);
+            } else {
+                CLAMP(glove.gloveBatteryRaw, 0, 100);
+            }
+
+            // Only update the battery level if we have less than 100%
+            if (gloveBatteryFiltered != CONTACT_GLOVE_INVALID_BATTERY && gloveBatteryFiltered <= 100) {
+                glove.gloveBattery = gloveBatteryClamped;
+            }
+        }
+
+        // Apply finger calibration to raw finger data
+
+        // Helper macro because 80% of the code is copy paste par joint names
+        // Remaps such that rest is 0.0, and close is +1.0, and prevents values > 1.0 being output
+#define APPLY_FINGER_CALIBRATION(joint, structNesting) \
+        glove.joint = Clamp((glove.joint##Raw - glove.calibration.fingers.structNesting.rest) / (float) (glove.calibration.fingers.structNesting.close - glove.calibration.fingers.structNesting.rest), -1.0f, 1.0f)
+
+        APPLY_FINGER_CALIBRATION(thumbRoot,     thumb.proximal);
+        APPLY_FINGER_CALIBRATION(thumbTip,      thumb.distal);
+        APPLY_FINGER_CALIBRATION(indexRoot,     index.proximal);
+        APPLY_FINGER_CALIBRATION(indexTip,      index.distal);
+        APPLY_FINGER_CALIBRATION(middleRoot,    middle.proximal);
+        APPLY_FINGER_CALIBRATION(middleTip,     middle.distal);
+        APPLY_FINGER_CALIBRATION(ringRoot,      ring.proximal);
+        APPLY_FINGER_CALIBRATION(ringTip,       ring.distal);
+        APPLY_FINGER_CALIBRATION(pinkyRoot,     pinky.proximal);
+        APPLY_FINGER_CALIBRATION(pinkyTip,      pinky.distal);
+
+#undef APPLY_FINGER_CALIBRATION
+
+    } else {
+        glove.gloveBattery = CONTACT_GLOVE_INVALID_BATTERY;
+        glove.joystickX = 0.0f;
+        glove.joystickY = 0.0f;
+    }
+}
+
+void PackGloveState(const GloveState_t& glove, protocol::ContactGloveState_t& outState) {
+    outState.isConnected    = glove.isConnected;
+    outState.ignorePose     = glove.ignorePose;
+    outState.useCurl        = glove.useCurl;
+    outState.trackerIndex   = glove.trackerIndex;
+    outState.imuTimestamp   = glove.imuTimestamp;
+    outState.imuRotation    = glove.imuRotation;
+
+    const float joints[protocol::GloveJoint_Count] = {
+        glove.thumbRoot,    glove.thumbTip,
+        glove.indexRoot,    glove.indexTip,
+        glove.middleRoot,   glove.middleTip,
+        glove.ringRoot,     glove.ringTip,
+        glove.pinkyRoot,    glove.pinkyTip,
+    };
+    protocol::PackGloveJoints(joints, outState.sample.joints);
+
+    outState.sample.joystick[0] = protocol::QuantiseGloveAxis(glove.joystickX);
+    outState.sample.joystick[1] = protocol::QuantiseGloveAxis(glove.joystickY);
+
+    outState.sample.buttons =
+        (glove.hasMagnetra      ? protocol::GloveButtonMagnetra         : 0) |
+        (glove.systemUp         ? protocol::GloveButtonSystemUp         : 0) |
+        (glove.systemDown       ? protocol::GloveButtonSystemDown       : 0) |
+        (glove.buttonUp         ? protocol::GloveButtonUp               : 0) |
+        (glove.buttonDown       ? protocol::GloveButtonDown             : 0) |
+        (glove.joystickClick    ? protocol::GloveButtonJoystickClick    : 0);
+
+    outState.sample.battery     = glove.gloveBattery;
+    outState.sample.reserved    = 0;
+    outState.sample.timestamp   = protocol::GloveSampleTimestamp(MAX(glove.inputTimestamp, glove.fingersTimestamp));
+}
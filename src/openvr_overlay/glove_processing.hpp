@@ -0,0 +1,13 @@
+#pragma once
+
+#include <chrono>
+
+#include "glove_state.hpp"
+#include "ring_buffer.hpp"
+
+// Applies calibration, deadzones and battery filtering to a glove's raw input. gloveConnected is when the glove was
+// last heard from, or time_point::min() if it never was
+void ProcessGlove(GloveState_t& glove, MostCommonElementRingBuffer& batteryRingBuffer, std::chrono::steady_clock::time_point gloveConnected);
+
+// Quantises the glove's processed state into what the driver is sent every frame
+void PackGloveState(const GloveState_t& glove, protocol::ContactGloveState_t& outState);
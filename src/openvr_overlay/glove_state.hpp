@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../ipc_protocol.hpp"
+
+// The overlay's state for a glove, with the raw and unquantised values the UI shows. The driver is sent the compact
+// protocol::ContactGloveState_t every frame (see PackGloveState), and the calibration (as a protocol::GloveCalibration_t)
+// only when it changes
+struct GloveState_t {
+    using CalibrationData_t = protocol::ContactGloveState_t::CalibrationData_t;
+
+    bool isConnected = false;
+    bool ignorePose = false;
+    bool useCurl = false;
+    uint32_t trackerIndex = CONTACT_GLOVE_INVALID_DEVICE_ID;
+
+    // When the latest input (buttons, joystick), fingers and IMU packets were received from the dongle, see MonotonicTimestamp
+    uint64_t inputTimestamp = 0;
+    uint64_t fingersTimestamp = 0;
+    uint64_t imuTimestamp = 0;
+
+    uint16_t thumbRootRaw;
+    uint16_t thumbTipRaw;
+    uint16_t indexRootRaw;
+    uint16_t indexTipRaw;
+    uint16_t middleRootRaw;
+    uint16_t middleTipRaw;
+    uint16_t ringRootRaw;
+    uint16_t ringTipRaw;
+    uint16_t pinkyRootRaw;
+    uint16_t pinkyTipRaw;
+
+    float thumbRoot;
+    float thumbTip;
+    float indexRoot;
+    float indexTip;
+    float middleRoot;
+    float middleTip;
+    float ringRoot;
+    float ringTip;
+    float pinkyRoot;
+    float pinkyTip;
+
+    // Orientation reported by the glove's IMU, in the IMU's own frame. Only meaningful once imuTimestamp is set
+    vr::HmdQuaternion_t imuRotation;
+
+    bool hasMagnetra;
+    bool systemUp;
+    bool systemDown;
+    bool buttonUp;
+    bool buttonDown;
+    bool joystickClick;
+    uint16_t joystickXRaw;
+    uint16_t joystickYRaw;
+    float joystickX;
+    float joystickY;
+    // No deadzone
+    float joystickXUnfiltered;
+    float joystickYUnfiltered;
+
+    uint8_t gloveBatteryRaw;
+    uint8_t gloveBattery;
+
+    uint8_t firmwareMajor;
+    uint8_t firmwareMinor;
+
+    CalibrationData_t calibration;
+};
@@ -1,72 +1,24 @@
 #include "ipc_client.hpp"
+#include <cstdio>
 #include <stdexcept>
 #include <string>
 
-const std::string WStringToString( const std::wstring& wstr )
-{
-	const int size_needed = WideCharToMultiByte( CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL );
-	std::string str_to( size_needed, 0 );
-	WideCharToMultiByte( CP_UTF8, 0, &wstr[0], (int)wstr.size(), &str_to[0], size_needed, NULL, NULL );
-	return str_to;
-}
-
-static const std::string LastErrorString( const DWORD lastError )
-{
-	LPWSTR buffer = nullptr;
-	const size_t size = FormatMessageW(
-		FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
-		NULL, lastError, MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT), (LPWSTR)&buffer, 0, NULL
-	);
-	std::wstring message( buffer, size );
-	LocalFree( buffer );
-	return WStringToString( message );
-}
+// How long to wait for the driver to accept us if it is busy with other clients
+static const uint32_t CONNECT_TIMEOUT_MS = 20000;
 
 IPCClient::~IPCClient()
 {
-	if ( pipe && pipe != INVALID_HANDLE_VALUE ) {
-		CloseHandle( pipe );
+	if ( m_transport ) {
+		m_transport->Close();
 	}
 }
 
 // @TODO: Make exceptionless
-void IPCClient::Connect()
+void IPCClient::Connect( const std::string& name )
 {
-	// Connect to pipe job
-	while ( true ) {
-
-		LPTSTR pipeName = ( LPTSTR ) TEXT ( FREESCUBA_PIPE_NAME );
-		pipe = CreateFile (
-			pipeName,   // pipe name 
-			GENERIC_READ |  // read and write access 
-			GENERIC_WRITE,
-			0,              // no sharing 
-			NULL,           // default security attributes
-			OPEN_EXISTING,  // opens existing pipe 
-			0,              // default attributes 
-			NULL );         // no template file 
-
-		// Break if the pipe handle is valid. 
-		if ( pipe != INVALID_HANDLE_VALUE ) {
-			break;
-		}
-
-		// Exit if an error other than ERROR_PIPE_BUSY occurs. 
-		if ( GetLastError() != ERROR_PIPE_BUSY ) {
-			throw std::runtime_error(std::string("Could not open pipe. Got error ") + std::to_string(GetLastError()));
-		}
-
-		// All pipe instances are busy, so wait for 20 seconds. 
-		if ( !WaitNamedPipe( pipeName, 20000 ) ) {
-			throw std::runtime_error("Could not open pipe: 20 second wait timed out.");
-		}
-	}
-
-
-	DWORD mode = PIPE_READMODE_MESSAGE;
-	if ( !SetNamedPipeHandleState( pipe, &mode, 0, 0 ) ) {
-		const DWORD lastError = GetLastError();
-		throw std::runtime_error("Couldn't set pipe mode. Error " + std::to_string( lastError ) + ": " + LastErrorString( lastError ));
+	m_transport = CreateIPCClientTransport();
+	if ( !m_transport->Connect( name, CONNECT_TIMEOUT_MS ) ) {
+		throw std::runtime_error( "Could not connect to the driver. Error " + m_transport->LastError() );
 	}
 
 	const protocol::Response_t response = SendBlocking( protocol::Request_t( protocol::RequestHandshake ) );
@@ -82,34 +34,88 @@ void IPCClient::Connect()
 	}
 }
 
-protocol::Response_t IPCClient::SendBlocking( const protocol::Request_t& request ) const
+protocol::Response_t IPCClient::SendBlocking( const protocol::Request_t& request )
 {
 	Send( request );
+
+	// Responses come back in order, so any acks still in flight are ahead of this one
+	while ( m_pendingAcks > 0 ) {
+		HandleAck( Receive() );
+	}
+
 	return Receive();
 }
 
+void IPCClient::SendGloveUpdate( const protocol::ContactGloveState_t& glove, const uint8_t glovePair, const bool isLeft )
+{
+	PollAcks();
+
+	// A glove's first update is a keyframe, as nothing has been sent to diff against
+	const int index = isLeft ? protocol::LeftGlove : protocol::RightGlove;
+	uint32_t& updatesSinceKeyframe = m_updatesSinceKeyframe[glovePair][index];
+	const bool keyframe = updatesSinceKeyframe == 0 || updatesSinceKeyframe >= GLOVE_STATE_KEYFRAME_INTERVAL;
+	updatesSinceKeyframe = keyframe ? 1 : updatesSinceKeyframe + 1;
+
+	protocol::Request_t request( isLeft ? protocol::RequestUpdateGloveLeftState : protocol::RequestUpdateGloveRightState );
+	request.glovePair = glovePair;
+	EncodeGloveStateDelta( m_sentGloveState[glovePair][index], glove, keyframe, request.gloveDelta );
+	m_sentGloveState[glovePair][index] = glove;
+
+	request.sequence = ++m_updateSequence;
+	request.ackRequested = ( m_updateSequence % GLOVE_UPDATE_ACK_INTERVAL ) == 0;
+
+	Send( request );
+	if ( request.ackRequested ) {
+		m_pendingAcks++;
+	}
+}
+
+void IPCClient::SendGloveCalibration( const protocol::GloveCalibration_t& calibration, const uint8_t glovePair, const bool isLeft )
+{
+	PollAcks();
+	Send( protocol::Request_t( calibration, glovePair, isLeft ) );
+}
+
+void IPCClient::PollAcks()
+{
+	while ( m_pendingAcks > 0 ) {
+		if ( !m_transport->Available() ) {
+			return;
+		}
+		HandleAck( Receive() );
+	}
+}
+
+void IPCClient::HandleAck( const protocol::Response_t& response )
+{
+	m_pendingAcks--;
+
+	if ( response.type != protocol::ResponseGloveUpdateAck ) {
+		printf( "Expected a glove update ack from the driver, got response %d\n", response.type );
+		return;
+	}
+
+	if ( response.gloveUpdateAck.lost > m_lostUpdates ) {
+		printf( "The driver missed %u glove updates (%u received)\n", response.gloveUpdateAck.lost - m_lostUpdates, response.gloveUpdateAck.received );
+		m_lostUpdates = response.gloveUpdateAck.lost;
+	}
+}
+
 void IPCClient::Send( const protocol::Request_t& request ) const
 {
-	DWORD bytesWritten;
-	const BOOL success = WriteFile( pipe, &request, sizeof request, &bytesWritten, 0 );
-	if ( !success )
+	if ( !m_transport->Write( &request, request.WireSize() ) )
 	{
-		const DWORD lastError = GetLastError();
-		throw std::runtime_error( "Error writing IPC request. Error " + std::to_string( lastError ) + ": " + LastErrorString( lastError ) );
+		throw std::runtime_error( "Error writing IPC request. Error " + m_transport->LastError() );
 	}
 }
 
 protocol::Response_t IPCClient::Receive() const
 {
 	protocol::Response_t response(protocol::ResponseInvalid);
-	DWORD bytesRead;
+	size_t bytesRead = 0;
 
-	const BOOL success = ReadFile( pipe, &response, sizeof response, &bytesRead, 0 );
-	if ( !success ) {
-		const DWORD lastError = GetLastError();
-		if (lastError != ERROR_MORE_DATA) {
-			throw std::runtime_error( "Error reading IPC response. Error " + std::to_string( lastError ) + ": " + LastErrorString( lastError ) );
-		}
+	if ( !m_transport->Read( &response, sizeof response, bytesRead ) ) {
+		throw std::runtime_error( "Error reading IPC response. Error " + m_transport->LastError() );
 	}
 
 	if ( bytesRead != sizeof response ) {
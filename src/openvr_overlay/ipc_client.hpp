@@ -2,20 +2,46 @@
 
 #include <openvr.h>
 #include "../ipc_protocol.hpp"
+#include "../ipc_transport.hpp"
+#include "../glove_state_delta.hpp"
 
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
+#include <memory>
+#include <string>
+
+// Every this many glove updates the driver is asked for an ack, so lost updates are noticed without waiting on every one
+constexpr uint32_t GLOVE_UPDATE_ACK_INTERVAL = 90;
 
 class IPCClient {
 public:
 	~IPCClient();
 
-	void Connect();
-	protocol::Response_t SendBlocking(const protocol::Request_t& request) const;
+	// Connects to the driver, or to another server speaking the protocol on the named endpoint
+	void Connect(const std::string& name = FREESCUBA_IPC_NAME);
+	// Waits for the response to the request. Acks still in flight arrive first, and are handled on the way
+	protocol::Response_t SendBlocking(const protocol::Request_t& request);
+	// Glove updates are one way, so this never waits on the driver. Only the fields which changed since the glove's last
+	// update are sent, with a keyframe every GLOVE_STATE_KEYFRAME_INTERVAL updates
+	void SendGloveUpdate(const protocol::ContactGloveState_t& glove, const uint8_t glovePair, const bool isLeft);
+	// Also one way
+	void SendGloveCalibration(const protocol::GloveCalibration_t& calibration, const uint8_t glovePair, const bool isLeft);
 
 	void Send(const protocol::Request_t& request) const;
 	protocol::Response_t Receive() const;
 
 private:
-	HANDLE pipe = INVALID_HANDLE_VALUE;
+	// Handles the acks which have already arrived, without waiting for the rest
+	void PollAcks();
+	void HandleAck(const protocol::Response_t& response);
+
+private:
+	std::unique_ptr<IIPCClientTransport> m_transport;
+
+	uint32_t m_updateSequence = 0;
+	uint32_t m_pendingAcks = 0;
+	uint32_t m_lostUpdates = 0;
+
+	// What the driver has been sent for each glove, indexed by glove pair then protocol::GloveDevice_t. The first update
+	// of each glove is a keyframe
+	protocol::ContactGloveState_t m_sentGloveState[protocol::MAX_GLOVE_PAIRS][2] = {};
+	uint32_t m_updatesSinceKeyframe[protocol::MAX_GLOVE_PAIRS][2] = {};
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cinttypes>
+
+#include "contact_glove/link_statistics.hpp"
+#include "../seqlock.hpp"
+
+// Name of the shared memory block the overlay publishes link statistics to, see SharedMemoryRegion
+#define FREESCUBA_LINK_STATS_NAME "FreeScubaLinkStatistics"
+
+constexpr uint32_t LINK_STATS_BLOCK_VERSION = 1;
+// Most dongles whose statistics are published
+constexpr uint32_t LINK_STATS_MAX_DONGLES = 4;
+
+/// <summary>
+/// Layout of the link statistics shared memory block. The overlay's UI thread is the only writer, and external tools read
+/// each dongle's statistics without locking through its SeqLock.
+/// </summary>
+struct LinkStatsBlock_t {
+	// Checked by readers before anything else, a mismatch means the overlay is a different build
+	uint32_t version;
+	uint32_t dongleCount;
+
+	SeqLock<LinkStatistics_t> dongles[LINK_STATS_MAX_DONGLES];
+};
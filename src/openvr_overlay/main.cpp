@@ -1,20 +1,92 @@
 #include "overlay_app.hpp"
-#include "contact_glove/serial_communication.hpp"
+#include "contact_glove/serial_reactor.hpp"
+#include "link_stats_block.hpp"
+#include "../glove_state_block.hpp"
+#include "../pose_stream_block.hpp"
+#include "../shared_memory.hpp"
 #include "ipc_client.hpp"
 #include "app_state.hpp"
 #include "configuration.hpp"
+#include "glove_processing.hpp"
 #include "maths.hpp"
 
-void ForwardDataToDriver(AppState& state, IPCClient& ipcClient);
-void ProcessGlove(protocol::ContactGloveState_t& glove, MostCommonElementRingBuffer& batteryRingBuffer, std::chrono::steady_clock::time_point gloveConnected);
+void ForwardDataToDriver(AppState& state, IPCClient& ipcClient, GloveStateBlock_t* gloveStateBlock);
 void UpdateGloveInputState(AppState& state);
 
 // Tell the GPU drivers to give the overlay priority over other apps, it's a driver after all
 extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = 0x00000001;
 extern "C" __declspec(dllexport) DWORD AmdPowerXpressRequestHighPerformance = 0x00000001;
 
-// 2 second timeout for the gloves
-constexpr auto GLOVE_TIMEOUT = std::chrono::steady_clock::time_point::duration(std::chrono::milliseconds(2000));
+// Packet timestamps are steady_clock nanoseconds, see protocol::MonotonicTimestamp
+static std::chrono::steady_clock::time_point TimestampToTimePoint(const uint64_t timestamp) {
+    return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(timestamp)));
+}
+
+static std::chrono::steady_clock::time_point LastSeenTimePoint(const GloveInputSnapshot_t& input) {
+    if (input.lastSeenTimestamp == 0) {
+        return std::chrono::steady_clock::time_point::min();
+    }
+    return TimestampToTimePoint(input.lastSeenTimestamp);
+}
+
+// Copies the raw input received from the dongle into the glove state
+static void ApplyGloveInput(GloveState_t& glove, const GloveInputSnapshot_t& input) {
+    glove.inputTimestamp    = input.inputTimestamp;
+    glove.fingersTimestamp  = input.fingersTimestamp;
+    glove.imuTimestamp      = input.imuTimestamp;
+
+    glove.hasMagnetra       = input.input.hasMagnetra;
+    glove.systemUp          = input.input.systemUp;
+    glove.systemDown        = input.input.systemDown;
+    glove.buttonUp          = input.input.buttonUp;
+    glove.buttonDown        = input.input.buttonDown;
+    glove.joystickClick     = input.input.joystickClick;
+    glove.joystickXRaw      = input.input.joystickX;
+    glove.joystickYRaw      = input.input.joystickY;
+
+    glove.thumbRootRaw      = input.fingers.fingerThumbRoot;
+    glove.thumbTipRaw       = input.fingers.fingerThumbTip;
+    glove.indexRootRaw      = input.fingers.fingerIndexRoot;
+    glove.indexTipRaw       = input.fingers.fingerIndexTip;
+    glove.middleRootRaw     = input.fingers.fingerMiddleRoot;
+    glove.middleTipRaw      = input.fingers.fingerMiddleTip;
+    glove.ringRootRaw       = input.fingers.fingerRingRoot;
+    glove.ringTipRaw        = input.fingers.fingerRingTip;
+    glove.pinkyRootRaw      = input.fingers.fingerPinkyRoot;
+    glove.pinkyTipRaw       = input.fingers.fingerPinkyTip;
+
+    glove.imuRotation       = { input.imu.rotationW, input.imu.rotationX, input.imu.rotationY, input.imu.rotationZ };
+
+    glove.gloveBatteryRaw   = input.batteryRaw;
+    glove.firmwareMajor     = input.firmwareMajor;
+    glove.firmwareMinor     = input.firmwareMinor;
+}
+
+// How often the link statistics shown in the UI are refreshed, so rates are averaged over a useful window
+constexpr uint64_t LINK_STATISTICS_INTERVAL_NS = 1000000000;
+
+// Reads every dongle's link statistics, shows the selected dongle's in the UI, and publishes all of them for external tools
+static void UpdateLinkStatistics(AppState& state, SerialReactor& reactor, LinkStatsBlock_t* sharedBlock) {
+    LinkStatistics_t statistics = {};
+
+    const size_t publishedCount = std::min<size_t>(reactor.GetDongleCount(), LINK_STATS_MAX_DONGLES);
+    for (size_t i = 0; i < reactor.GetDongleCount(); i++) {
+        reactor.GetDongle(i).GetLinkStatistics(statistics);
+
+        if (i == state.selectedDongle && statistics.timestamp - state.dongleLinkStatistics.timestamp >= LINK_STATISTICS_INTERVAL_NS) {
+            state.dongleFramesPerSecond = LinkFramesPerSecond(state.dongleLinkStatistics, statistics);
+            state.dongleLinkStatistics  = statistics;
+        }
+
+        if (sharedBlock != nullptr && i < publishedCount) {
+            sharedBlock->dongles[i].Store(statistics);
+        }
+    }
+
+    if (sharedBlock != nullptr) {
+        sharedBlock->dongleCount = static_cast<uint32_t>(publishedCount);
+    }
+}
 
 // Props for the overlay
 #define OPENVR_APPLICATION_KEY "hyblocker.DriverFreeScuba"
@@ -45,6 +117,26 @@ static std::string GetExecutableDirectory() {
     return s_cwd;
 }
 
+// Starts or stops capturing every dongle's raw link to match the UI. Captures are written next to the executable
+static void UpdateCapture(AppState& state, SerialReactor& reactor) {
+    for (size_t i = 0; i < reactor.GetDongleCount(); i++) {
+        SerialCommunicationManager& dongle = reactor.GetDongle(i);
+        if (state.dongleCaptureEnabled == dongle.IsCapturing()) {
+            continue;
+        }
+
+        if (state.dongleCaptureEnabled) {
+            const std::string path = GetExecutableDirectory() + "\\capture_dongle" + std::to_string(i) + "_" + std::to_string(std::time(nullptr)) + ".fscap";
+            if (!dongle.StartCapture(path)) {
+                // Don't retry every frame
+                state.dongleCaptureEnabled = false;
+            }
+        } else {
+            dongle.StopCapture();
+        }
+    }
+}
+
 void ActivateMultipleDrivers()
 {
     vr::EVRSettingsError vrSettingsError;
@@ -142,18 +234,12 @@ int main() {
 
     try {
 
-        F_CRC_InitialiseTable();
-
-        // Global serial manager
-        static SerialCommunicationManager man = {};
+        // Global serial reactor, one per process however many dongles are plugged in
+        static SerialReactor reactor = {};
         static AppState state = {};
 
         LoadConfiguration(state);
 
-        // Glove timing
-        static std::chrono::steady_clock::time_point gloveLeftConnected  = std::chrono::steady_clock::time_point::min();
-        static std::chrono::steady_clock::time_point gloveRightConnected = std::chrono::steady_clock::time_point::min();
-
         // Init SteamVR
         InitVR();
 
@@ -162,85 +248,127 @@ int main() {
         ipcClient.Connect();
         state.ipcClient = &ipcClient;
 
-        // Serial data listener
-        man.BeginListener(
-            [&](const ContactGloveDevice_t handedness, const GloveInputData_t& inputData) {
-
-                switch (handedness) {
-                    case ContactGloveDevice_t::LeftGlove:
-                        state.gloveLeft.hasMagnetra         = inputData.hasMagnetra;
-                        state.gloveLeft.systemUp            = inputData.systemUp;
-                        state.gloveLeft.systemDown          = inputData.systemDown;
-                        state.gloveLeft.buttonUp            = inputData.buttonUp;
-                        state.gloveLeft.buttonDown          = inputData.buttonDown;
-                        state.gloveLeft.joystickClick       = inputData.joystickClick;
-                        state.gloveLeft.joystickXRaw        = inputData.joystickX;
-                        state.gloveLeft.joystickYRaw        = inputData.joystickY;
-                        break;
-                    case ContactGloveDevice_t::RightGlove:
-                        state.gloveRight.hasMagnetra        = inputData.hasMagnetra;
-                        state.gloveRight.systemUp           = inputData.systemUp;
-                        state.gloveRight.systemDown         = inputData.systemDown;
-                        state.gloveRight.buttonUp           = inputData.buttonUp;
-                        state.gloveRight.buttonDown         = inputData.buttonDown;
-                        state.gloveRight.joystickClick      = inputData.joystickClick;
-                        state.gloveRight.joystickXRaw       = inputData.joystickX;
-                        state.gloveRight.joystickYRaw       = inputData.joystickY;
-                        break;
+        // Glove state is published to the driver through shared memory, the pipe is only used for it if that fails
+        static SharedMemoryRegion gloveStateRegion;
+        GloveStateBlock_t* gloveStateBlock = nullptr;
+        if (gloveStateRegion.Open(FREESCUBA_GLOVE_STATE_NAME, sizeof(GloveStateBlock_t))) {
+            gloveStateBlock = static_cast<GloveStateBlock_t*>(gloveStateRegion.Data());
+            if (gloveStateBlock->version != protocol::Version) {
+                printf("Glove state block version mismatch (overlay: %u, driver: %u), sending glove state through the pipe\n", protocol::Version, gloveStateBlock->version);
+                gloveStateBlock = nullptr;
+                gloveStateRegion.Close();
+            }
+        }
+
+        // Tracker poses for calibration are pushed by the driver, the pipe is only used to request them if this fails
+        static SharedMemoryRegion poseStreamRegion;
+        if (poseStreamRegion.Open(FREESCUBA_POSE_STREAM_NAME, sizeof(PoseStreamBlock_t))) {
+            const PoseStreamBlock_t* poseStream = static_cast<const PoseStreamBlock_t*>(poseStreamRegion.Data());
+            if (poseStream->version == protocol::Version) {
+                state.poseStream = poseStream;
+            } else {
+                printf("Pose stream block version mismatch (overlay: %u, driver: %u), requesting poses through the pipe\n", protocol::Version, poseStream->version);
+                poseStreamRegion.Close();
+            }
+        }
+
+        // Serial data listener, servicing every dongle plugged in from one thread. The callbacks run on the serial
+        // dispatch thread, which owns these working copies and publishes them whole, so the UI thread never reads a
+        // half updated glove
+        reactor.AddConnectedDongles();
+        state.dongleCount = std::min(reactor.GetDongleCount(), MAX_DONGLES);
+        if (reactor.GetDongleCount() > MAX_DONGLES) {
+            printf("Found %zu dongles, only the first %zu will be used\n", reactor.GetDongleCount(), MAX_DONGLES);
+        }
+
+        static GloveInputSnapshot_t gloveInputs[MAX_DONGLES][2] = {};
+        for (size_t i = 0; i < MAX_DONGLES; i++) {
+            gloveInputs[i][0] = state.dongleInputs[i].gloveLeft.Load();
+            gloveInputs[i][1] = state.dongleInputs[i].gloveRight.Load();
+        }
+
+        // Link statistics for external tools. Not fatal if it can't be created, the UI still shows them
+        static SharedMemoryRegion linkStatsRegion;
+        LinkStatsBlock_t* linkStatsBlock = nullptr;
+        if (linkStatsRegion.Create(FREESCUBA_LINK_STATS_NAME, sizeof(LinkStatsBlock_t))) {
+            linkStatsBlock = new (linkStatsRegion.Data()) LinkStatsBlock_t();
+            linkStatsBlock->version = LINK_STATS_BLOCK_VERSION;
+        }
+
+        reactor.BeginListener(
+            [&](const size_t dongle, const ContactGloveDevice_t handedness, const GloveInputData_t& inputData, const uint64_t timestamp) {
+                if (dongle >= MAX_DONGLES) {
+                    return;
+                }
+                const bool isLeft           = handedness == ContactGloveDevice_t::LeftGlove;
+                GloveInputSnapshot_t& glove = gloveInputs[dongle][isLeft ? 0 : 1];
+                glove.input                 = inputData;
+                glove.inputTimestamp        = timestamp;
+
+                (isLeft ? state.dongleInputs[dongle].gloveLeft : state.dongleInputs[dongle].gloveRight).Store(glove);
+            },
+
+            [&](const size_t dongle, const ContactGloveDevice_t handedness, const GlovePacketFingers_t& fingerData, const uint64_t timestamp) {
+                if (dongle >= MAX_DONGLES) {
+                    return;
                 }
+                const bool isLeft           = handedness == ContactGloveDevice_t::LeftGlove;
+                GloveInputSnapshot_t& glove = gloveInputs[dongle][isLeft ? 0 : 1];
+                glove.fingers               = fingerData;
+                glove.fingersTimestamp      = timestamp;
+                glove.lastSeenTimestamp     = timestamp;
+
+                (isLeft ? state.dongleInputs[dongle].gloveLeft : state.dongleInputs[dongle].gloveRight).Store(glove);
             },
 
-            [&](const ContactGloveDevice_t handedness, const GlovePacketFingers_t& fingerData) {
-                switch (handedness) {
-                    case ContactGloveDevice_t::LeftGlove:
-                        gloveLeftConnected = std::chrono::high_resolution_clock::now();
-                        state.gloveLeft.isConnected         = true;
-                        state.gloveLeft.thumbRootRaw        = fingerData.fingerThumbRoot;
-                        state.gloveLeft.thumbTipRaw         = fingerData.fingerThumbTip;
-                        state.gloveLeft.indexRootRaw        = fingerData.fingerIndexRoot;
-                        state.gloveLeft.indexTipRaw         = fingerData.fingerIndexTip;
-                        state.gloveLeft.middleRootRaw       = fingerData.fingerMiddleRoot;
-                        state.gloveLeft.middleTipRaw        = fingerData.fingerMiddleTip;
-                        state.gloveLeft.ringRootRaw         = fingerData.fingerRingRoot;
-                        state.gloveLeft.ringTipRaw          = fingerData.fingerRingTip;
-                        state.gloveLeft.pinkyRootRaw        = fingerData.fingerPinkyRoot;
-                        state.gloveLeft.pinkyTipRaw         = fingerData.fingerPinkyTip;
-                        break;
-                    case ContactGloveDevice_t::RightGlove:
-                        gloveRightConnected = std::chrono::high_resolution_clock::now();
-                        state.gloveRight.isConnected        = true;
-                        state.gloveRight.thumbRootRaw       = fingerData.fingerThumbRoot;
-                        state.gloveRight.thumbTipRaw        = fingerData.fingerThumbTip;
-                        state.gloveRight.indexRootRaw       = fingerData.fingerIndexRoot;
-                        state.gloveRight.indexTipRaw        = fingerData.fingerIndexTip;
-                        state.gloveRight.middleRootRaw      = fingerData.fingerMiddleRoot;
-                        state.gloveRight.middleTipRaw       = fingerData.fingerMiddleTip;
-                        state.gloveRight.ringRootRaw        = fingerData.fingerRingRoot;
-                        state.gloveRight.ringTipRaw         = fingerData.fingerRingTip;
-                        state.gloveRight.pinkyRootRaw       = fingerData.fingerPinkyRoot;
-                        state.gloveRight.pinkyTipRaw        = fingerData.fingerPinkyTip;
-                        break;
+            [&](const size_t dongle, const ContactGloveDevice_t handedness, const GlovePacketImu_t& imuData, const uint64_t timestamp) {
+                if (dongle >= MAX_DONGLES) {
+                    return;
                 }
+                const bool isLeft           = handedness == ContactGloveDevice_t::LeftGlove;
+                GloveInputSnapshot_t& glove = gloveInputs[dongle][isLeft ? 0 : 1];
+                glove.imu                   = imuData;
+                glove.imuTimestamp          = timestamp;
+
+                (isLeft ? state.dongleInputs[dongle].gloveLeft : state.dongleInputs[dongle].gloveRight).Store(glove);
             },
 
-            [&](const DevicesStatus_t& status) {
+            [&](const size_t dongle, const DevicesStatus_t& status, const uint64_t timestamp) {
+                if (dongle >= MAX_DONGLES) {
+                    return;
+                }
+                GloveInputSnapshot_t& gloveLeftInput    = gloveInputs[dongle][0];
+                GloveInputSnapshot_t& gloveRightInput   = gloveInputs[dongle][1];
+
                 // Only update the timeout if the battery is valid
                 if (status.gloveLeftBattery != CONTACT_GLOVE_INVALID_BATTERY) {
-                    gloveLeftConnected = std::chrono::high_resolution_clock::now();
+                    gloveLeftInput.lastSeenTimestamp = timestamp;
                 }
                 if (status.gloveRightBattery != CONTACT_GLOVE_INVALID_BATTERY) {
-                    gloveRightConnected = std::chrono::high_resolution_clock::now();
+                    gloveRightInput.lastSeenTimestamp = timestamp;
                 }
 
-                state.gloveLeft.gloveBatteryRaw             = status.gloveLeftBattery;
-                state.gloveRight.gloveBatteryRaw            = status.gloveRightBattery;
+                gloveLeftInput.batteryRaw           = status.gloveLeftBattery;
+                gloveRightInput.batteryRaw          = status.gloveRightBattery;
+
+                state.dongleInputs[dongle].gloveLeft.Store(gloveLeftInput);
+                state.dongleInputs[dongle].gloveRight.Store(gloveRightInput);
             },
 
-            [&](const DevicesFirmware_t& firmware) {
-                state.gloveLeft.firmwareMajor               = firmware.gloveLeftMajor;
-                state.gloveLeft.firmwareMinor               = firmware.gloveLeftMinor;
-                state.gloveRight.firmwareMajor              = firmware.gloveRightMajor;
-                state.gloveRight.firmwareMinor              = firmware.gloveRightMinor;
+            [&](const size_t dongle, const DevicesFirmware_t& firmware, const uint64_t timestamp) {
+                if (dongle >= MAX_DONGLES) {
+                    return;
+                }
+                GloveInputSnapshot_t& gloveLeftInput    = gloveInputs[dongle][0];
+                GloveInputSnapshot_t& gloveRightInput   = gloveInputs[dongle][1];
+
+                gloveLeftInput.firmwareMajor        = firmware.gloveLeftMajor;
+                gloveLeftInput.firmwareMinor        = firmware.gloveLeftMinor;
+                gloveRightInput.firmwareMajor       = firmware.gloveRightMajor;
+                gloveRightInput.firmwareMinor       = firmware.gloveRightMinor;
+
+                state.dongleInputs[dongle].gloveLeft.Store(gloveLeftInput);
+                state.dongleInputs[dongle].gloveRight.Store(gloveRightInput);
             }
         );
 
@@ -249,15 +377,39 @@ int main() {
             while (doExecute) {
                 TryCreateVrOverlay(state);
 
-                state.dongleAvailable = man.IsConnected();
-                ProcessGlove(state.gloveLeft, state.uiState.leftGloveBatteryBuffer, gloveLeftConnected);
-                ProcessGlove(state.gloveRight, state.uiState.rightGloveBatteryBuffer, gloveRightConnected);
+                // Dongles plugged in after startup are added by the reactor
+                state.dongleCount = std::min(reactor.GetDongleCount(), MAX_DONGLES);
+                state.donglesConnected = 0;
+                for (size_t i = 0; i < state.dongleCount; i++) {
+                    state.donglesConnected += reactor.GetDongle(i).IsConnected() ? 1 : 0;
+                }
+
+                SerialCommunicationManager& selectedDongle = reactor.GetDongle(state.selectedDongle);
+                state.dongleAvailable = selectedDongle.IsConnected();
+                state.dongleFramesPerRead = selectedDongle.GetFramesPerRead();
+                state.donglePacketQueueDepth = selectedDongle.GetPacketQueueDepth();
+                state.dongleDroppedPackets = selectedDongle.GetDroppedPackets();
+                UpdateLinkStatistics(state, reactor, linkStatsBlock);
+                UpdateCapture(state, reactor);
+
+                // Take a consistent copy of each glove's latest input for this frame. Every dongle's gloves are
+                // processed, the UI only shows the selected dongle's
+                for (size_t i = 0; i < state.dongleCount; i++) {
+                    GlovePair_t& glovePair = state.glovePairs[i];
+                    const GloveInputSnapshot_t gloveLeftSnapshot    = state.dongleInputs[i].gloveLeft.Load();
+                    const GloveInputSnapshot_t gloveRightSnapshot   = state.dongleInputs[i].gloveRight.Load();
+                    ApplyGloveInput(glovePair.left, gloveLeftSnapshot);
+                    ApplyGloveInput(glovePair.right, gloveRightSnapshot);
+
+                    ProcessGlove(glovePair.left, glovePair.leftBatteryBuffer, LastSeenTimePoint(gloveLeftSnapshot));
+                    ProcessGlove(glovePair.right, glovePair.rightBatteryBuffer, LastSeenTimePoint(gloveRightSnapshot));
+                }
                 UpdateGloveInputState(state);
 
                 doExecute = FreeScuba::Overlay::UpdateNativeWindow(state, s_overlayMainHandle);
                 
                 if (doExecute) {
-                    ForwardDataToDriver(state, ipcClient);
+                    ForwardDataToDriver(state, ipcClient, gloveStateBlock);
                 }
             }
 
@@ -266,7 +418,8 @@ int main() {
         }
 
         state.ipcClient = nullptr;
-        man.Disconnect();
+        state.poseStream = nullptr;
+        reactor.Disconnect();
     }
     catch (std::runtime_error& e)
     {
@@ -277,105 +430,6 @@ int main() {
     }
 }
 
-#define MIN(a,b) (((a)<(b))?(a):(b))
-#define MAX(a,b) (((a)>(b))?(a):(b))
-#define CLAMP(t,a,b) (MAX(MIN(t, b), a))
-
-void ProcessGlove(protocol::ContactGloveState_t& glove, MostCommonElementRingBuffer& batteryRingBuffer, std::chrono::steady_clock::time_point gloveConnected) {
-
-    // Compute whether we should consider the glove as connected or not
-    auto delta = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - gloveConnected);
-    glove.isConnected = delta < GLOVE_TIMEOUT && gloveConnected != std::chrono::steady_clock::time_point::min();
-
-    // Only process the rest of the data IF and only IF the glove is connected
-    if (glove.isConnected) {
-        // Only process magnetra stuff if magnetra is connected
-        if (glove.hasMagnetra) {
-            float joystickX = 2.0f * (glove.joystickXRaw - glove.calibration.joystick.XMin) / (float)MAX(glove.calibration.joystick.XMax - glove.calibration.joystick.XMin, 0.0f) - 1.0f;
-            float joystickY = 2.0f * (glove.joystickYRaw - glove.calibration.joystick.YMin) / (float)MAX(glove.calibration.joystick.YMax - glove.calibration.joystick.YMin, 0.0f) - 1.0f;
-
-            // Normalize the axis if out of range
-            if (joystickX * joystickX + joystickY * joystickY > 1.0f) {
-                double length = sqrt(joystickX * joystickX + joystickY * joystickY);
-                joystickX = (float) (joystickX / length);
-                joystickY = (float) (joystickY / length);
-            }
-
-            // Re-orient the up forward vector based on user calibration
-            // Use a negated 2D rotation matrix
-            float orientedJoystickX = joystickX * cos(glove.calibration.joystick.forwardAngle) + joystickY * -sin(glove.calibration.joystick.forwardAngle);
-            float orientedJoystickY = joystickX * sin(glove.calibration.joystick.forwardAngle) + joystickY * cos(glove.calibration.joystick.forwardAngle);
-
-            glove.joystickX = orientedJoystickX;
-            glove.joystickY = orientedJoystickY;
-            glove.joystickXUnfiltered = orientedJoystickX;
-            glove.joystickYUnfiltered = orientedJoystickY;
-
-            // Apply deadzone
-            // Compare vector magnitudes, if smaller than threshold 0 out
-            if (glove.joystickX * glove.joystickX + glove.joystickY * glove.joystickY < glove.calibration.joystick.threshold) {
-                glove.joystickX = 0.0f;
-                glove.joystickY = 0.0f;
-            }
-        }
-        else {
-            // Default values, i.e. no joystick / buttons
-            glove.joystickX     = 0.0f;
-            glove.joystickY     = 0.0f;
-            glove.buttonDown    = false;
-            glove.buttonUp      = false;
-            glove.systemDown    = false;
-            glove.systemUp      = false;
-            glove.joystickClick = false;
-        }
-
-        // Battery should only update if it's not invalid (sometimes the battery status is invalid)
-        if (glove.gloveBatteryRaw != CONTACT_GLOVE_INVALID_BATTERY) {
-            uint8_t gloveBatteryClamped = 0;
-            uint8_t gloveBatteryFiltered = CONTACT_GLOVE_INVALID_BATTERY;
-
-            // Only continue if the battery ring buffer is valid
-            if (batteryRingBuffer.IsValid()) {
-                batteryRingBuffer.Push(glove.gloveBatteryRaw);
-                gloveBatteryFiltered = batteryRingBuffer.MostCommonElement();
-                gloveBatteryClamped = CLAMP(gloveBatteryFiltered, 0, 100);
-            } else {
-                CLAMP(glove.gloveBatteryRaw, 0, 100);
-            }
-
-            // Only update the battery level if we have less than 100%
-            if (gloveBatteryFiltered != CONTACT_GLOVE_INVALID_BATTERY && gloveBatteryFiltered <= 100) {
-                glove.gloveBattery = gloveBatteryClamped;
-            }
-        }
-
-        // Apply finger calibration to raw finger data
-
-        // Helper macro because 80% of the code is copy paste par joint names
-        // Remaps such that rest is 0.0, and close is +1.0, and prevents values > 1.0 being output
-#define APPLY_FINGER_CALIBRATION(joint, structNesting) \
-        glove.joint = Clamp((glove.joint##Raw - glove.calibration.fingers.structNesting.rest) / (float) (glove.calibration.fingers.structNesting.close - glove.calibration.fingers.structNesting.rest), -1.0f, 1.0f)
-
-        APPLY_FINGER_CALIBRATION(thumbRoot,     thumb.proximal);
-        APPLY_FINGER_CALIBRATION(thumbTip,      thumb.distal);
-        APPLY_FINGER_CALIBRATION(indexRoot,     index.proximal);
-        APPLY_FINGER_CALIBRATION(indexTip,      index.distal);
-        APPLY_FINGER_CALIBRATION(middleRoot,    middle.proximal);
-        APPLY_FINGER_CALIBRATION(middleTip,     middle.distal);
-        APPLY_FINGER_CALIBRATION(ringRoot,      ring.proximal);
-        APPLY_FINGER_CALIBRATION(ringTip,       ring.distal);
-        APPLY_FINGER_CALIBRATION(pinkyRoot,     pinky.proximal);
-        APPLY_FINGER_CALIBRATION(pinkyTip,      pinky.distal);
-
-#undef APPLY_FINGER_CALIBRATION
-
-    } else {
-        glove.gloveBattery = CONTACT_GLOVE_INVALID_BATTERY;
-        glove.joystickX = 0.0f;
-        glove.joystickY = 0.0f;
-    }
-}
-
 // Process input for the UI to be able to handle inputs properly
 void UpdateGloveInputState(AppState& state) {
     // Left previous frame
@@ -393,18 +447,18 @@ void UpdateGloveInputState(AppState& state) {
     state.uiState.gloveButtons.prevRight.joystickClick      = state.uiState.gloveButtons.right.joystickClick;
 
     // Left current frame
-    state.uiState.gloveButtons.left.buttonDown              = state.gloveLeft.buttonDown;
-    state.uiState.gloveButtons.left.buttonUp                = state.gloveLeft.buttonUp;
-    state.uiState.gloveButtons.left.systemDown              = state.gloveLeft.systemDown;
-    state.uiState.gloveButtons.left.systemUp                = state.gloveLeft.systemUp;
-    state.uiState.gloveButtons.left.joystickClick           = state.gloveLeft.joystickClick;
+    state.uiState.gloveButtons.left.buttonDown              = state.GloveLeft().buttonDown;
+    state.uiState.gloveButtons.left.buttonUp                = state.GloveLeft().buttonUp;
+    state.uiState.gloveButtons.left.systemDown              = state.GloveLeft().systemDown;
+    state.uiState.gloveButtons.left.systemUp                = state.GloveLeft().systemUp;
+    state.uiState.gloveButtons.left.joystickClick           = state.GloveLeft().joystickClick;
 
     // Right current frame
-    state.uiState.gloveButtons.right.buttonDown             = state.gloveRight.buttonDown;
-    state.uiState.gloveButtons.right.buttonUp               = state.gloveRight.buttonUp;
-    state.uiState.gloveButtons.right.systemDown             = state.gloveRight.systemDown;
-    state.uiState.gloveButtons.right.systemUp               = state.gloveRight.systemUp;
-    state.uiState.gloveButtons.right.joystickClick          = state.gloveRight.joystickClick;
+    state.uiState.gloveButtons.right.buttonDown             = state.GloveRight().buttonDown;
+    state.uiState.gloveButtons.right.buttonUp               = state.GloveRight().buttonUp;
+    state.uiState.gloveButtons.right.systemDown             = state.GloveRight().systemDown;
+    state.uiState.gloveButtons.right.systemUp               = state.GloveRight().systemUp;
+    state.uiState.gloveButtons.right.joystickClick          = state.GloveRight().joystickClick;
 
     // Left released
     state.uiState.gloveButtons.releasedLeft.buttonDown      = state.uiState.gloveButtons.prevLeft.buttonDown      == true && state.uiState.gloveButtons.prevLeft.buttonDown      != state.uiState.gloveButtons.left.buttonDown;
@@ -423,15 +477,48 @@ void UpdateGloveInputState(AppState& state) {
 
 static char deviceRole[vr::k_unMaxPropertyStringSize];
 
-void ForwardDataToDriver(AppState& state, IPCClient& ipcClient) {
+// Hands a glove's state to the driver, through the glove state block if there is one
+static void SendGloveState(const protocol::ContactGloveState_t& glove, const uint8_t glovePair, const bool isLeft, IPCClient& ipcClient, GloveStateBlock_t* gloveStateBlock) {
+    if (gloveStateBlock != nullptr) {
+        gloveStateBlock->gloves[glovePair][isLeft ? protocol::LeftGlove : protocol::RightGlove].Store(glove);
+    } else {
+        ipcClient.SendGloveUpdate(glove, glovePair, isLeft);
+    }
+}
 
-    protocol::Request_t req = {};
+// Calibration is edited from the UI at any time but rarely changes, so it's only sent when it's different to what the
+// driver was last sent
+static void SendGloveCalibration(const GloveState_t& glove, protocol::GloveCalibration_t& sent, const uint8_t glovePair, const bool isLeft, IPCClient& ipcClient, GloveStateBlock_t* gloveStateBlock) {
+    if (sent.generation != 0 && memcmp(&sent.calibration, &glove.calibration, sizeof(glove.calibration)) == 0) {
+        return;
+    }
+
+    // The first generation is taken from the clock, so a restarted overlay never repeats one the driver has cached
+    sent.generation = sent.generation != 0 ? sent.generation + 1 : static_cast<uint32_t>(protocol::MonotonicTimestamp() / 1000000);
+    memcpy(&sent.calibration, &glove.calibration, sizeof(glove.calibration));
 
-    uint32_t trackerIdLeft  = CONTACT_GLOVE_INVALID_DEVICE_ID;
-    uint32_t trackerIdRight = CONTACT_GLOVE_INVALID_DEVICE_ID;
+    if (gloveStateBlock != nullptr) {
+        gloveStateBlock->calibrations[glovePair][isLeft ? protocol::LeftGlove : protocol::RightGlove].Store(sent);
+    } else {
+        ipcClient.SendGloveCalibration(sent, glovePair, isLeft);
+    }
+}
+
+void ForwardDataToDriver(AppState& state, IPCClient& ipcClient, GloveStateBlock_t* gloveStateBlock) {
+
+    // Handed trackers in device order, the nth left and right trackers are given to the nth pair of gloves
+    uint32_t trackerIdsLeft[MAX_DONGLES];
+    uint32_t trackerIdsRight[MAX_DONGLES];
+    size_t trackersLeft     = 0;
+    size_t trackersRight    = 0;
+
+    bool anyGloveConnected  = false;
+    for (size_t pair = 0; pair < state.dongleCount; pair++) {
+        anyGloveConnected |= state.glovePairs[pair].left.isConnected || state.glovePairs[pair].right.isConnected;
+    }
 
-    // Search for the handed tracker, only if either of the gloves are connected
-    if (state.gloveLeft.isConnected == true || state.gloveRight.isConnected == true) {
+    // Search for the handed trackers, only if any of the gloves are connected
+    if (anyGloveConnected) {
         // Skip 0 as it's reserved for the HMD
         for (int i = 1; i < vr::k_unMaxTrackedDeviceCount; i++) {
             // Only look at connected devices
@@ -454,48 +541,51 @@ void ForwardDataToDriver(AppState& state, IPCClient& ipcClient) {
 
                         if (controllerHand == vr::TrackedControllerRole_RightHand) {
                             // Found right tracker
-                            if (trackerIdRight == CONTACT_GLOVE_INVALID_DEVICE_ID) {
-                                trackerIdRight = i;
-                            }
-                            if (trackerIdLeft != CONTACT_GLOVE_INVALID_DEVICE_ID) {
-                                break;
+                            if (trackersRight < state.dongleCount) {
+                                trackerIdsRight[trackersRight++] = i;
                             }
                         } else if (controllerHand == vr::TrackedControllerRole_LeftHand) {
                             // Found left tracker
-                            if (trackerIdLeft == CONTACT_GLOVE_INVALID_DEVICE_ID) {
-                                trackerIdLeft = i;
-                            }
-                            if (trackerIdRight != CONTACT_GLOVE_INVALID_DEVICE_ID) {
-                                break;
+                            if (trackersLeft < state.dongleCount) {
+                                trackerIdsLeft[trackersLeft++] = i;
                             }
                         }
+
+                        if (trackersLeft == state.dongleCount && trackersRight == state.dongleCount) {
+                            break;
+                        }
                     }
                 }
             }
         }
     }
 
-    if (state.gloveLeft.isConnected == true) {
-        state.gloveLeft.trackerIndex = trackerIdLeft;
-        req.type = protocol::RequestType_t::RequestUpdateGloveLeftState;
-        memcpy(&req.gloveData, &state.gloveLeft, sizeof(protocol::ContactGloveState_t));
-        // Adjust angle
-        ipcClient.SendBlocking(req);
-    } else {
-        req.type = protocol::RequestType_t::RequestUpdateGloveLeftState;
-        req.gloveData.isConnected = false;
-        ipcClient.SendBlocking(req);
-    }
+    // The driver only looks at isConnected for a disconnected glove
+    const protocol::ContactGloveState_t disconnected = {};
 
-    if (state.gloveRight.isConnected == true) {
-        state.gloveRight.trackerIndex = trackerIdRight;
-        req.type = protocol::RequestType_t::RequestUpdateGloveRightState;
-        memcpy(&req.gloveData, &state.gloveRight, sizeof(protocol::ContactGloveState_t));
-        // Adjust angle
-        ipcClient.SendBlocking(req);
-    } else {
-        req.type = protocol::RequestType_t::RequestUpdateGloveRightState;
-        req.gloveData.isConnected = false;
-        ipcClient.SendBlocking(req);
+    protocol::ContactGloveState_t packed = {};
+
+    for (size_t i = 0; i < state.dongleCount; i++) {
+        GlovePair_t& glovePair  = state.glovePairs[i];
+        const uint8_t pair      = static_cast<uint8_t>(i);
+
+        SendGloveCalibration(glovePair.left, glovePair.driverCalibration[protocol::LeftGlove], pair, true, ipcClient, gloveStateBlock);
+        SendGloveCalibration(glovePair.right, glovePair.driverCalibration[protocol::RightGlove], pair, false, ipcClient, gloveStateBlock);
+
+        if (glovePair.left.isConnected == true) {
+            glovePair.left.trackerIndex = i < trackersLeft ? trackerIdsLeft[i] : CONTACT_GLOVE_INVALID_DEVICE_ID;
+            PackGloveState(glovePair.left, packed);
+            SendGloveState(packed, pair, true, ipcClient, gloveStateBlock);
+        } else {
+            SendGloveState(disconnected, pair, true, ipcClient, gloveStateBlock);
+        }
+
+        if (glovePair.right.isConnected == true) {
+            glovePair.right.trackerIndex = i < trackersRight ? trackerIdsRight[i] : CONTACT_GLOVE_INVALID_DEVICE_ID;
+            PackGloveState(glovePair.right, packed);
+            SendGloveState(packed, pair, false, ipcClient, gloveStateBlock);
+        } else {
+            SendGloveState(disconnected, pair, false, ipcClient, gloveStateBlock);
+        }
     }
 }
\ No newline at end of file
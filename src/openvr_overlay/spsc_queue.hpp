@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+
+/// <summary>
+/// A bounded, lock-free single producer single consumer queue holding up to N elements. Pushing never blocks: if the
+/// queue is full the element is dropped and counted instead.
+/// TryPush must only be called from the producer thread, and TryPop from the consumer thread.
+/// </summary>
+template <typename T, size_t N>
+class SpscQueue {
+	static_assert((N & (N - 1)) == 0, "SpscQueue size must be a power of 2!");
+
+public:
+	SpscQueue() : m_elements{}, m_head(0), m_cachedTail(0), m_tail(0), m_cachedHead(0), m_dropped(0) {}
+
+	bool TryPush(const T& value) {
+		const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+		// Only re-read the consumer's index once the queue looks full
+		if (tail - m_cachedHead == N) {
+			m_cachedHead = m_head.load(std::memory_order_acquire);
+			if (tail - m_cachedHead == N) {
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
+
+		m_elements[tail & (N - 1)] = value;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool TryPop(T& outValue) {
+		const size_t head = m_head.load(std::memory_order_relaxed);
+
+		// Only re-read the producer's index once the queue looks empty
+		if (head == m_cachedTail) {
+			m_cachedTail = m_tail.load(std::memory_order_acquire);
+			if (head == m_cachedTail) {
+				return false;
+			}
+		}
+
+		outValue = m_elements[head & (N - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Approximate number of queued elements. Safe to call from any thread
+	inline size_t Size() const {
+		// Read the head first, the tail can only move further ahead of it
+		const size_t head = m_head.load(std::memory_order_acquire);
+		return m_tail.load(std::memory_order_acquire) - head;
+	}
+	inline constexpr size_t Capacity() const { return N; }
+	// Number of elements dropped because the queue was full. Safe to call from any thread
+	inline uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	T m_elements[N];
+
+	// Consumer side. Each side keeps its own copy of the other side's index, so they only share a cache line when
+	// the queue is empty or full.
+	alignas(64) std::atomic<size_t> m_head;
+	size_t m_cachedTail;
+
+	// Producer side
+	alignas(64) std::atomic<size_t> m_tail;
+	size_t m_cachedHead;
+	std::atomic<uint64_t> m_dropped;
+};
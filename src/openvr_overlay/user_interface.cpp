@@ -1,9 +1,11 @@
 #define _USE_MATH_DEFINES
 #include <openvr.h>
+#include <cstdio>
 
 #include "user_interface.hpp"
 
 #include "maths.hpp"
+#include "../timestamp.hpp"
 
 // DrawJoystickInput :: Imgui commands to draw a nice joystick control to show what the current joystick value is
 // DrawGlove :: Displays a single Glove's state. Contains the buttons for trigger state change.
@@ -88,7 +90,7 @@ void DrawJoystickInput(const float valueX, const float valueY, const float deadz
     ImGui::Dummy(ImVec2(BOX_SIZE, BOX_SIZE));
 }
 
-void DrawGlove(const std::string name, const std::string id, protocol::ContactGloveState_t& glove, AppState& state) {
+void DrawGlove(const std::string name, const std::string id, GloveState_t& glove, AppState& state) {
 
     std::string panelTitle = name;
     if (glove.isConnected) {
@@ -382,14 +384,14 @@ void DrawCalibrateJoystick(AppState& state) {
         // @TODO: Style the UI to look pretty
 
         // Isolate the glove we wish to work on
-        protocol::ContactGloveState_t* desiredGlove = nullptr;
+        GloveState_t* desiredGlove = nullptr;
         if (state.uiState.processingHandedness == Handedness_t::Left) {
             ImGui::Text("Calibrating Left Joystick...");
-            desiredGlove = &state.gloveLeft;
+            desiredGlove = &state.GloveLeft();
         }
         else {
             ImGui::Text("Calibrating Right Joystick...");
-            desiredGlove = &state.gloveRight;
+            desiredGlove = &state.GloveRight();
         }
 
         // Handled here so that we don't get a blank frame
@@ -525,14 +527,14 @@ void DrawCalibrateFingers(AppState& state) {
 
     ImGui::BeginGroupPanel("Finger Calibration");
     {
-        protocol::ContactGloveState_t* desiredGlove = nullptr;
+        GloveState_t* desiredGlove = nullptr;
         if (state.uiState.processingHandedness == Handedness_t::Left) {
             ImGui::Text("Calibrating Left Glove Fingers...");
-            desiredGlove = &state.gloveLeft;
+            desiredGlove = &state.GloveLeft();
         }
         else {
             ImGui::Text("Calibrating Right Glove Fingers...");
-            desiredGlove = &state.gloveRight;
+            desiredGlove = &state.GloveRight();
         }
 
         // Handled here so that we don't get a blank frame
@@ -676,14 +678,14 @@ void DrawCalibrateFingersSingle(AppState& state) {
 
     ImGui::BeginGroupPanel("Single Finger Calibration");
     {
-        protocol::ContactGloveState_t* desiredGlove = nullptr;
+        GloveState_t* desiredGlove = nullptr;
         if (state.uiState.processingHandedness == Handedness_t::Left) {
             ImGui::Text("Calibrating Left Glove Finger...");
-            desiredGlove = &state.gloveLeft;
+            desiredGlove = &state.GloveLeft();
         }
         else {
             ImGui::Text("Calibrating Right Glove Finger...");
-            desiredGlove = &state.gloveRight;
+            desiredGlove = &state.GloveRight();
         }
 
         // Handled here so that we don't get a blank frame
@@ -865,17 +867,72 @@ void DrawCalibrateFingersSingle(AppState& state) {
 }
 
 
+// Most poses per second the driver pushes while calibrating, about a headset's refresh rate
+constexpr uint32_t CALIBRATION_POSE_RATE_HZ = 90;
+
+// Latest pose of a tracked device. Subscribes to the device's pose stream the first time it is asked for, after which
+// reading it never waits on the driver. Returns false if the driver hasn't pushed a pose yet
+static bool GetDriverPose(AppState& state, const uint32_t deviceIndex, vr::DriverPose_t& outPose) {
+    if (deviceIndex >= vr::k_unMaxTrackedDeviceCount) {
+        return false;
+    }
+
+    if (state.poseStream != nullptr && state.uiState.subscribedPoseDevice != deviceIndex) {
+        protocol::PoseSubscription_t subscription = {};
+        subscription.deviceIndices[0] = deviceIndex;
+        subscription.deviceCount = 1;
+        subscription.rateHz = CALIBRATION_POSE_RATE_HZ;
+
+        const uint64_t subscriptionTime = protocol::MonotonicTimestamp();
+        if (state.ipcClient->SendBlocking(protocol::Request_t(subscription)).type == protocol::ResponseSuccess) {
+            state.uiState.subscribedPoseDevice = deviceIndex;
+            state.uiState.poseSubscriptionTime = subscriptionTime;
+        } else {
+            // The driver can't stream poses, so ask for them instead
+            state.poseStream = nullptr;
+        }
+    }
+
+    if (state.poseStream != nullptr) {
+        // Poses from before we subscribed may be from an earlier calibration, long since stale
+        StreamedPose_t streamed;
+        if (!state.poseStream->poses[deviceIndex].TryLoad(streamed) || streamed.deviceIndex != deviceIndex || streamed.timestamp < state.uiState.poseSubscriptionTime) {
+            return false;
+        }
+        outPose = streamed.pose;
+        return true;
+    }
+
+    const protocol::Response_t response = state.ipcClient->SendBlocking(protocol::Request_t(deviceIndex));
+    if (response.type != protocol::ResponseDevicePose) {
+        return false;
+    }
+    outPose = response.driverPose;
+    return true;
+}
+
+// Stops the driver pushing poses once calibration no longer needs them
+static void UnsubscribePoses(AppState& state) {
+    if (state.poseStream == nullptr || state.uiState.subscribedPoseDevice == CONTACT_GLOVE_INVALID_DEVICE_ID) {
+        return;
+    }
+
+    protocol::PoseSubscription_t subscription = {};
+    state.ipcClient->SendBlocking(protocol::Request_t(subscription));
+    state.uiState.subscribedPoseDevice = CONTACT_GLOVE_INVALID_DEVICE_ID;
+}
+
 void DrawCalibrateOffsets(AppState& state) {
 
     ImGui::BeginGroupPanel("Pose Offset Calibration");
     {
-        protocol::ContactGloveState_t* desiredGlove = nullptr;
+        GloveState_t* desiredGlove = nullptr;
         if (state.uiState.processingHandedness == Handedness_t::Left) {
             ImGui::Text("Calibrating Left Glove Pose Offset...");
-            desiredGlove = &state.gloveLeft;
+            desiredGlove = &state.GloveLeft();
         } else {
             ImGui::Text("Calibrating Right Glove Pose Offset...");
-            desiredGlove = &state.gloveRight;
+            desiredGlove = &state.GloveRight();
         }
 
         // Handled here so that we don't get a blank frame
@@ -902,13 +959,9 @@ void DrawCalibrateOffsets(AppState& state) {
             {
                 ImGui::Text("Waiting for a valid pose. Please make sure your tracker is on, and tracking.");
                 
-                // Request a driver pose from the server
-                protocol::Request_t req = protocol::Request_t(desiredGlove->trackerIndex);
-                protocol::Response_t response = state.ipcClient->SendBlocking(req);
-
-                if (response.type == protocol::ResponseDevicePose) {
-
-                    vr::DriverPose_t driverPose = response.driverPose;
+                // Get the tracker's latest pose from the driver
+                vr::DriverPose_t driverPose;
+                if (GetDriverPose(state, desiredGlove->trackerIndex, driverPose)) {
 
                     const vr::HmdVector3d_t driverPosition = { driverPose.vecPosition[0], driverPose.vecPosition[1], driverPose.vecPosition[2] };
                     state.uiState.initialTrackerPos = driverPosition + (desiredGlove->calibration.poseOffset.pos * driverPose.qRotation);
@@ -935,13 +988,9 @@ void DrawCalibrateOffsets(AppState& state) {
 
             if (ImGui::Button("Continue") || anyButtonPressedJoystick) {
 
-                // Request a driver pose from the server
-                protocol::Request_t req = protocol::Request_t(desiredGlove->trackerIndex);
-                protocol::Response_t response = state.ipcClient->SendBlocking(req);
-
-                if (response.type == protocol::ResponseDevicePose) {
-
-                    vr::DriverPose_t driverPose = response.driverPose;
+                // Get the tracker's latest pose from the driver
+                vr::DriverPose_t driverPose;
+                if (GetDriverPose(state, desiredGlove->trackerIndex, driverPose)) {
 
                     const vr::HmdVector3d_t driverPosition = { driverPose.vecPosition[0], driverPose.vecPosition[1], driverPose.vecPosition[2] };
                     const vr::HmdVector3d_t newPos = driverPosition + (desiredGlove->calibration.poseOffset.pos * driverPose.qRotation);
@@ -963,6 +1012,8 @@ void DrawCalibrateOffsets(AppState& state) {
                     // Copy the new calibration back
                     memcpy(&desiredGlove->calibration, &state.uiState.currentCalibration, sizeof(protocol::ContactGloveState_t::CalibrationData_t));
 
+                    UnsubscribePoses(state);
+
                     // Move to the next state
                     state.uiState.calibrationState = CalibrationState_t::State_Entering;
                     state.uiState.page = ScreenState_t::ScreenStateViewData;
@@ -983,6 +1034,8 @@ void DrawCalibrateOffsets(AppState& state) {
             // Tell the driver to stop ignoring pose updates, we have decided to stop calibrating the offset
             desiredGlove->ignorePose = false;
 
+            UnsubscribePoses(state);
+
             // Move to the data page
             state.uiState.calibrationState = CalibrationState_t::State_Entering;
             state.uiState.page = ScreenState_t::ScreenStateViewData;
@@ -1015,11 +1068,48 @@ void DrawUi(const bool isOverlay, AppState& state) {
             if (state.uiState.page == ScreenState_t::ScreenStateViewData) {
                 state.uiState.processingHandedness = Handedness_t::Left;
             }
-            DrawGlove("Left Glove", "glove_left", state.gloveLeft, state);
+            DrawGlove("Left Glove", "glove_left", state.GloveLeft(), state);
             if (state.uiState.page == ScreenState_t::ScreenStateViewData) {
                 state.uiState.processingHandedness = Handedness_t::Right;
             }
-            DrawGlove("Right Glove", "glove_right", state.gloveRight, state);
+            DrawGlove("Right Glove", "glove_right", state.GloveRight(), state);
+
+            if (state.dongleCount > 1) {
+                ImGui::TextDisabled("Dongles connected: ");
+                ImGui::SameLine();
+                ImGui::Text("%zu / %zu", state.donglesConnected, state.dongleCount);
+
+                // Every dongle's gloves are forwarded to the driver, this only picks whose are shown and calibrated
+                char dongleName[32];
+                snprintf(dongleName, sizeof dongleName, "Dongle %zu", state.selectedDongle + 1);
+                if (ImGui::BeginCombo("Selected dongle", dongleName)) {
+                    for (size_t i = 0; i < state.dongleCount; i++) {
+                        snprintf(dongleName, sizeof dongleName, "Dongle %zu", i + 1);
+                        if (ImGui::Selectable(dongleName, i == state.selectedDongle)) {
+                            state.selectedDongle = i;
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+            }
+
+            if (state.dongleAvailable) {
+                ImGui::TextDisabled("Dongle frames per read: ");
+                ImGui::SameLine();
+                ImGui::Text("%.2f", state.dongleFramesPerRead);
+                ImGui::TextDisabled("Dongle packet queue: ");
+                ImGui::SameLine();
+                ImGui::Text("%zu queued, %llu dropped", state.donglePacketQueueDepth, (unsigned long long)state.dongleDroppedPackets);
+                ImGui::TextDisabled("Dongle link: ");
+                ImGui::SameLine();
+                ImGui::Text("%.0f frames/s, %llu CRC failures, %llu COBS errors, %llu overflows, %llu unknown",
+                    state.dongleFramesPerSecond,
+                    (unsigned long long)state.dongleLinkStatistics.crcFailures,
+                    (unsigned long long)state.dongleLinkStatistics.cobsErrors,
+                    (unsigned long long)state.dongleLinkStatistics.overflows,
+                    (unsigned long long)state.dongleLinkStatistics.unknownIds);
+                ImGui::Checkbox("Capture raw dongle link to file", &state.dongleCaptureEnabled);
+            }
 
             // @TODO: Break settings into function / tab
             ImGui::Spacing();
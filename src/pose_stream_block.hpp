@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "ipc_protocol.hpp"
+#include "seqlock.hpp"
+
+// Name of the shared memory block the driver pushes subscribed poses to, see protocol::PoseSubscription_t
+#define FREESCUBA_POSE_STREAM_NAME "FreeScubaPoseStream"
+
+// A tracked device's pose as the driver received it, and when (see protocol::MonotonicTimestamp)
+struct StreamedPose_t {
+	uint32_t deviceIndex;
+	uint64_t timestamp;
+	vr::DriverPose_t pose;
+};
+
+/// <summary>
+/// Layout of the pose stream shared memory block. The overlay subscribes to up to POSE_SUBSCRIPTION_MAX_DEVICES devices
+/// with a RequestSubscribePoses, and the driver pushes their poses here as they are updated, no faster than the
+/// subscription's rate. Slots are indexed by tracked device index rather than by subscription, so a slot is only ever
+/// written by the thread updating that device's pose, and the overlay reads the latest pose without asking the driver
+/// for it.
+/// </summary>
+struct PoseStreamBlock_t {
+	// Checked by the overlay before reading, a mismatch means the driver is a different build
+	uint32_t version;
+
+	SeqLock<StreamedPose_t> poses[vr::k_unMaxTrackedDeviceCount];
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cinttypes>
+#include <cstring>
+#include <type_traits>
+
+/// <summary>
+/// Publishes a value from a single writer thread to any number of reader threads without locks. The writer never waits,
+/// and readers retry until they copied a value which wasn't being written to at the same time, so they never see a
+/// torn value.
+/// </summary>
+template <typename T>
+class SeqLock {
+	static_assert(std::is_trivially_copyable_v<T>, "SeqLock values must be trivially copyable!");
+	// Values may live in memory shared between processes, which only works with lock free atomics
+	static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free, "SeqLock needs lock free atomics!");
+
+	static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+public:
+	SeqLock() : m_sequence(0), m_words{} {}
+
+	// Must only be called from the writer thread
+	void Store(const T& value) {
+		uint64_t words[WORD_COUNT] = {};
+		memcpy(words, &value, sizeof(T));
+
+		// An odd sequence marks a write in progress. A writer in another process may have died mid write, in which case
+		// the sequence is rounded down so it is even again once this write completes
+		const uint32_t sequence = m_sequence.load(std::memory_order_relaxed) & ~1u;
+		m_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		for (size_t i = 0; i < WORD_COUNT; i++) {
+			m_words[i].store(words[i], std::memory_order_relaxed);
+		}
+
+		m_sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	T Load() const {
+		T value;
+		while (!TryLoad(value)) {}
+		return value;
+	}
+
+	// A single attempt at Load, for readers which must never spin on the writer. Returns false, leaving outValue
+	// untouched, if the value was being written to
+	bool TryLoad(T& outValue) const {
+		uint64_t words[WORD_COUNT] = {};
+
+		const uint32_t before = m_sequence.load(std::memory_order_acquire);
+		if ((before & 1) != 0) {
+			return false;
+		}
+
+		for (size_t i = 0; i < WORD_COUNT; i++) {
+			words[i] = m_words[i].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (m_sequence.load(std::memory_order_relaxed) != before) {
+			return false;
+		}
+
+		memcpy(&outValue, words, sizeof(T));
+		return true;
+	}
+
+	// Increases by 2 with every Store, so readers can tell whether anything was published since they last looked
+	inline uint32_t Sequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+private:
+	std::atomic<uint32_t> m_sequence;
+	// Stored as atomics so that reading while the writer is storing is well defined
+	std::atomic<uint64_t> m_words[WORD_COUNT];
+};
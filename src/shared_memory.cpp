@@ -0,0 +1,130 @@
+#include "shared_memory.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemoryRegion::SharedMemoryRegion()
+	: m_hMapping(nullptr), m_fd(-1), m_name(), m_owner(false), m_data(nullptr), m_size(0) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+	Close();
+}
+
+bool SharedMemoryRegion::Create(const std::string& name, const size_t size) {
+	return Map(name, size, true);
+}
+
+bool SharedMemoryRegion::Open(const std::string& name, const size_t size) {
+	return Map(name, size, false);
+}
+
+#ifdef _WIN32
+
+bool SharedMemoryRegion::Map(const std::string& name, const size_t size, const bool create) {
+	Close();
+
+	const std::string mappingName = "Local\\" + name;
+	HANDLE hMapping = create
+		? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32), (DWORD)(size & 0xFFFFFFFF), mappingName.c_str())
+		: OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mappingName.c_str());
+
+	if (hMapping == NULL) {
+		printf("Failed to map shared memory %s - Error: %lu\n", name.c_str(), GetLastError());
+		return false;
+	}
+
+	void* data = MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (data == nullptr) {
+		printf("Failed to map view of shared memory %s - Error: %lu\n", name.c_str(), GetLastError());
+		CloseHandle(hMapping);
+		return false;
+	}
+
+	m_hMapping	= hMapping;
+	m_name		= name;
+	m_owner		= create;
+	m_data		= data;
+	m_size		= size;
+	return true;
+}
+
+void SharedMemoryRegion::Close() {
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+		m_data = nullptr;
+	}
+	if (m_hMapping != nullptr) {
+		// The mapping is destroyed once every process closed it
+		CloseHandle(m_hMapping);
+		m_hMapping = nullptr;
+	}
+	m_size = 0;
+}
+
+#else
+
+bool SharedMemoryRegion::Map(const std::string& name, const size_t size, const bool create) {
+	Close();
+
+	const std::string shmName = "/" + name;
+	const int fd = create
+		? shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600)
+		: shm_open(shmName.c_str(), O_RDWR | O_CLOEXEC, 0);
+
+	if (fd < 0) {
+		printf("Failed to open shared memory %s\n", name.c_str());
+		return false;
+	}
+
+	struct stat status = {};
+	if (fstat(fd, &status) != 0 ||
+		(create && static_cast<size_t>(status.st_size) < size && ftruncate(fd, static_cast<off_t>(size)) != 0) ||
+		(!create && static_cast<size_t>(status.st_size) < size)) {
+		printf("Shared memory %s has the wrong size\n", name.c_str());
+		close(fd);
+		return false;
+	}
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (data == MAP_FAILED) {
+		printf("Failed to map shared memory %s\n", name.c_str());
+		close(fd);
+		return false;
+	}
+
+	m_fd	= fd;
+	m_name	= shmName;
+	m_owner	= create;
+	m_data	= data;
+	m_size	= size;
+	return true;
+}
+
+void SharedMemoryRegion::Close() {
+	if (m_data != nullptr) {
+		munmap(m_data, m_size);
+		m_data = nullptr;
+	}
+	if (m_fd >= 0) {
+		close(m_fd);
+		m_fd = -1;
+	}
+	// Unlike Win32, the name outlives every process unless its creator removes it
+	if (m_owner) {
+		shm_unlink(m_name.c_str());
+		m_owner = false;
+	}
+	m_size = 0;
+}
+
+#endif
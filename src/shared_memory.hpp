@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// <summary>
+/// A named block of memory shared between processes, e.g. so external tools can read state published by the overlay.
+/// The creator sizes the block, and other processes open it by name.
+/// </summary>
+class SharedMemoryRegion {
+public:
+	SharedMemoryRegion();
+	~SharedMemoryRegion();
+
+	SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+	SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+	// Creates the named region, zero filled, or opens it if it already exists. Returns false on failure
+	bool Create(const std::string& name, const size_t size);
+	// Opens a region created by another process. Returns false if it doesn't exist or is smaller than size
+	bool Open(const std::string& name, const size_t size);
+	void Close();
+
+	inline void* Data() const { return m_data; }
+	inline size_t Size() const { return m_size; }
+	inline bool IsOpen() const { return m_data != nullptr; }
+
+private:
+	bool Map(const std::string& name, const size_t size, const bool create);
+
+private:
+	// File mapping HANDLE on Win32, file descriptor elsewhere
+	void* m_hMapping;
+	int m_fd;
+	std::string m_name;
+	bool m_owner;
+
+	void* m_data;
+	size_t m_size;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+namespace protocol {
+	// Monotonic time in nanoseconds, used to timestamp glove samples. steady_clock is backed by QueryPerformanceCounter
+	// on Windows, so timestamps taken in the overlay can be compared against the driver's clock.
+	inline uint64_t MonotonicTimestamp() {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+}